@@ -83,6 +83,14 @@ using firebase::firestore::util::ThrowInvalidArgument;
   return self;
 }
 
+- (instancetype)initWithSizeBytes:(NSNumber *)size
+       fieldNameDictionaryEnabled:(BOOL)fieldNameDictionaryEnabled {
+  self = [self initWithSizeBytes:size];
+  self.internalSettings =
+      self.internalSettings.WithFieldNameDictionaryEnabled(fieldNameDictionaryEnabled);
+  return self;
+}
+
 @end
 
 @implementation FIRMemoryEagerGCSettings {
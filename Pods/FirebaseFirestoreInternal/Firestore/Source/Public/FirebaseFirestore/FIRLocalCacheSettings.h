@@ -55,6 +55,17 @@ NS_SWIFT_NAME(PersistentCacheSettings)
  */
 - (instancetype)initWithSizeBytes:(NSNumber *)size;
 
+/**
+ * Creates `PersistentCacheSettings` with a custom cache size in bytes that, if
+ * `fieldNameDictionaryEnabled` is set, stores documents with their field names replaced by small
+ * per-collection-group IDs, which shrinks documents that repeat long field names.
+ *
+ * Caches written with the dictionary enabled can't be read by SDK versions that predate it. Opening
+ * the cache with the dictionary disabled rewrites the documents stored that way.
+ */
+- (instancetype)initWithSizeBytes:(NSNumber *)size
+       fieldNameDictionaryEnabled:(BOOL)fieldNameDictionaryEnabled;
+
 @end
 
 /**
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "Firestore/core/src/api/query_core.h"
+#include "Firestore/core/src/api/source.h"
 
 using firebase::firestore::model::AggregateField;
 
@@ -53,6 +54,13 @@ class AggregateQuery {
   // when the tests and mocking are removed.
   virtual void GetAggregate(AggregateQueryCallback&& callback);
 
+  /**
+   * Computes the aggregations from the given source. `Source::Cache` evaluates
+   * them over the local cache, including pending writes, without contacting
+   * the backend; any other source runs them on the server.
+   */
+  void GetAggregate(Source source, AggregateQueryCallback&& callback);
+
   // TODO(b/280805906) Remove this count specific API after the c++ SDK migrates
   // to the new Aggregate API Backward-compatible getter for count result
   void Get(CountQueryCallback&& callback);
@@ -184,7 +184,7 @@ size_t MemoryCacheSettings::Hash() const {
 }
 
 size_t PersistentCacheSettings::Hash() const {
-  return util::Hash(kind_, size_bytes_);
+  return util::Hash(kind_, size_bytes_, field_name_dictionary_enabled_);
 }
 
 size_t MemoryEagerGcSettings::Hash() const {
@@ -207,7 +207,9 @@ bool operator!=(const MemoryCacheSettings& lhs,
 
 bool operator==(const PersistentCacheSettings& lhs,
                 const PersistentCacheSettings& rhs) {
-  return lhs.kind() == rhs.kind() && lhs.size_bytes() == rhs.size_bytes();
+  return lhs.kind() == rhs.kind() && lhs.size_bytes() == rhs.size_bytes() &&
+         lhs.field_name_dictionary_enabled() ==
+             rhs.field_name_dictionary_enabled();
 }
 
 bool operator!=(const PersistentCacheSettings& lhs,
@@ -299,6 +301,13 @@ bool Settings::gc_enabled() const {
   return cache_size_bytes_ != CacheSizeUnlimited;
 }
 
+bool Settings::field_name_dictionary_enabled() const {
+  return cache_settings_ &&
+         cache_settings_->kind_ == LocalCacheSettings::Kind::kPersistent &&
+         static_cast<PersistentCacheSettings*>(cache_settings_.get())
+             ->field_name_dictionary_enabled_;
+}
+
 const LocalCacheSettings* Settings::local_cache_settings() const {
   return cache_settings_.get();
 }
@@ -322,6 +331,13 @@ PersistentCacheSettings PersistentCacheSettings::WithSizeBytes(
   return new_settings;
 }
 
+PersistentCacheSettings
+PersistentCacheSettings::WithFieldNameDictionaryEnabled(bool enabled) const {
+  PersistentCacheSettings new_settings{*this};
+  new_settings.field_name_dictionary_enabled_ = enabled;
+  return new_settings;
+}
+
 }  // namespace api
 }  // namespace firestore
 }  // namespace firebase
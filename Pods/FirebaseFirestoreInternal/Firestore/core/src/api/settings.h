@@ -75,6 +75,12 @@ class Settings {
   int64_t cache_size_bytes() const;
   bool gc_enabled() const;
 
+  /**
+   * Whether remote documents are stored with dictionary-encoded field names.
+   * Only persistent caches support the encoding.
+   */
+  bool field_name_dictionary_enabled() const;
+
   const LocalCacheSettings* local_cache_settings() const;
   void set_local_cache_settings(const LocalCacheSettings& settings);
 
@@ -123,14 +129,26 @@ class PersistentCacheSettings : public LocalCacheSettings {
   }
   PersistentCacheSettings WithSizeBytes(int64_t size) const;
 
+  /**
+   * Returns settings that store remote documents with their field names
+   * replaced by small per-collection-group IDs. Disabling the encoding again
+   * rewrites the documents stored that way when the cache is opened.
+   */
+  PersistentCacheSettings WithFieldNameDictionaryEnabled(bool enabled) const;
+
   int64_t size_bytes() const {
     return size_bytes_;
   }
 
+  bool field_name_dictionary_enabled() const {
+    return field_name_dictionary_enabled_;
+  }
+
   size_t Hash() const override;
 
  private:
   int64_t size_bytes_;
+  bool field_name_dictionary_enabled_ = false;
 };
 
 class MemoryGarbageCollectorSettings {
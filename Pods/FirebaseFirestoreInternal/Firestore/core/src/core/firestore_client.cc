@@ -16,6 +16,7 @@
 
 #include "Firestore/core/src/core/firestore_client.h"
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
@@ -81,6 +82,7 @@ using credentials::User;
 using firestore::Error;
 using local::LevelDbOpener;
 using local::LocalStore;
+using local::LruGarbageCollector;
 using local::LruParams;
 using local::MemoryPersistence;
 using local::QueryEngine;
@@ -115,6 +117,13 @@ static const size_t kMaxConcurrentLimboResolutions = 100;
 static const auto kInitialGCDelay = std::chrono::minutes(1);
 static const auto kRegularGCDelay = std::chrono::minutes(5);
 
+/**
+ * How long a single slice of garbage collection may block the worker queue.
+ * Slices are re-enqueued until the collection completes, so operations queued
+ * in the meantime run in between.
+ */
+static const auto kGCSliceBudget = std::chrono::milliseconds(4);
+
 /** How long we wait to try running index backfill after SDK initialization. */
 static const auto kInitialBackfillDelay = std::chrono::seconds(15);
 /** Minimum amount of time between backfill checks, after the first one. */
@@ -217,6 +226,8 @@ void FirestoreClient::Initialize(const User& user, const Settings& settings) {
                 created.status().ToString());
 
     auto ldb = std::move(created).ValueOrDie();
+    ldb->SetFieldNameDictionaryEnabled(
+        settings.field_name_dictionary_enabled());
     lru_delegate_ = ldb->reference_delegate();
 
     persistence_ = std::move(ldb);
@@ -349,11 +360,23 @@ void FirestoreClient::ScheduleLruGarbageCollection() {
       gc_has_run_ ? kRegularGCDelay : kInitialGCDelay;
 
   lru_callback_ = worker_queue_->EnqueueAfterDelay(
-      delay, TimerId::GarbageCollectionDelay, [this] {
-        local_store_->CollectGarbage(lru_delegate_->garbage_collector());
-        gc_has_run_ = true;
-        ScheduleLruGarbageCollection();
-      });
+      delay, TimerId::GarbageCollectionDelay,
+      [this] { RunLruGarbageCollectionSlice(); });
+}
+
+void FirestoreClient::RunLruGarbageCollectionSlice() {
+  LruGarbageCollector* garbage_collector = lru_delegate_->garbage_collector();
+  local_store_->CollectGarbageSlice(garbage_collector, kGCSliceBudget);
+
+  if (garbage_collector->collection_in_progress()) {
+    lru_callback_ = worker_queue_->EnqueueAfterDelay(
+        std::chrono::milliseconds(0), TimerId::GarbageCollectionDelay,
+        [this] { RunLruGarbageCollectionSlice(); });
+    return;
+  }
+
+  gc_has_run_ = true;
+  ScheduleLruGarbageCollection();
 }
 
 void FirestoreClient::ScheduleIndexBackfiller() {
@@ -427,9 +450,11 @@ std::shared_ptr<QueryListener> FirestoreClient::ListenToQuery(
   auto query_listener = QueryListener::Create(
       std::move(query), std::move(options), std::move(listener));
 
-  worker_queue_->Enqueue([this, query_listener] {
-    event_manager_->AddQueryListener(std::move(query_listener));
-  });
+  worker_queue_->Enqueue(
+      [this, query_listener] {
+        event_manager_->AddQueryListener(std::move(query_listener));
+      },
+      "FirestoreClient::ListenToQuery");
 
   return query_listener;
 }
@@ -442,7 +467,8 @@ void FirestoreClient::RemoveListener(
     return;
   }
   worker_queue_->Enqueue(
-      [this, listener] { event_manager_->RemoveQueryListener(listener); });
+      [this, listener] { event_manager_->RemoveQueryListener(listener); },
+      "FirestoreClient::RemoveListener");
 }
 
 void FirestoreClient::GetDocumentFromLocalCache(
@@ -451,33 +477,35 @@ void FirestoreClient::GetDocumentFromLocalCache(
 
   // TODO(c++14): move `callback` into lambda.
   auto shared_callback = absl::ShareUniquePtr(std::move(callback));
-  worker_queue_->Enqueue([this, doc, shared_callback] {
-    Document document = local_store_->ReadDocument(doc.key());
-    StatusOr<DocumentSnapshot> maybe_snapshot;
-
-    if (document->is_found_document()) {
-      maybe_snapshot = DocumentSnapshot::FromDocument(
-          doc.firestore(), document,
-          SnapshotMetadata{document->has_local_mutations(),
-                           /*from_cache=*/true});
-    } else if (document->is_no_document()) {
-      maybe_snapshot = DocumentSnapshot::FromNoDocument(
-          doc.firestore(), doc.key(),
-          SnapshotMetadata{/*pending_writes=*/false,
-                           /*from_cache=*/true});
-    } else {
-      maybe_snapshot =
-          Status{Error::kErrorUnavailable,
-                 "Failed to get document from cache. (However, this document "
-                 "may exist on the server. Run again without setting source to "
-                 "FirestoreSourceCache to attempt to retrieve the document "};
-    }
+  worker_queue_->Enqueue(
+      [this, doc, shared_callback] {
+        Document document = local_store_->ReadDocument(doc.key());
+        StatusOr<DocumentSnapshot> maybe_snapshot;
+
+        if (document->is_found_document()) {
+          maybe_snapshot = DocumentSnapshot::FromDocument(
+              doc.firestore(), document,
+              SnapshotMetadata{document->has_local_mutations(),
+                               /*from_cache=*/true});
+        } else if (document->is_no_document()) {
+          maybe_snapshot = DocumentSnapshot::FromNoDocument(
+              doc.firestore(), doc.key(),
+              SnapshotMetadata{/*pending_writes=*/false,
+                               /*from_cache=*/true});
+        } else {
+          maybe_snapshot = Status{
+              Error::kErrorUnavailable,
+              "Failed to get document from cache. (However, this document "
+              "may exist on the server. Run again without setting source to "
+              "FirestoreSourceCache to attempt to retrieve the document "};
+        }
 
-    if (shared_callback) {
-      user_executor_->Execute(
-          [=] { shared_callback->OnEvent(std::move(maybe_snapshot)); });
-    }
-  });
+        if (shared_callback) {
+          user_executor_->Execute(
+              [=] { shared_callback->OnEvent(std::move(maybe_snapshot)); });
+        }
+      },
+      "FirestoreClient::GetDocumentFromLocalCache");
 }
 
 void FirestoreClient::GetDocumentsFromLocalCache(
@@ -486,32 +514,34 @@ void FirestoreClient::GetDocumentsFromLocalCache(
 
   // TODO(c++14): move `callback` into lambda.
   auto shared_callback = absl::ShareUniquePtr(std::move(callback));
-  worker_queue_->Enqueue([this, query, shared_callback] {
-    QueryResult query_result = local_store_->ExecuteQuery(
-        query.query(), /* use_previous_results= */ true);
-
-    View view(query.query(), query_result.remote_keys());
-    ViewDocumentChanges view_doc_changes =
-        view.ComputeDocumentChanges(query_result.documents());
-    ViewChange view_change = view.ApplyChanges(view_doc_changes);
-    HARD_ASSERT(
-        view_change.limbo_changes().empty(),
-        "View returned limbo documents during local-only query execution.");
-
-    HARD_ASSERT(view_change.snapshot().has_value(), "Expected a snapshot");
-
-    ViewSnapshot snapshot = std::move(view_change.snapshot()).value();
-    SnapshotMetadata metadata(snapshot.has_pending_writes(),
-                              snapshot.from_cache());
-
-    QuerySnapshot result(query.firestore(), query.query(), std::move(snapshot),
-                         std::move(metadata));
-
-    if (shared_callback) {
-      user_executor_->Execute(
-          [=] { shared_callback->OnEvent(std::move(result)); });
-    }
-  });
+  worker_queue_->Enqueue(
+      [this, query, shared_callback] {
+        QueryResult query_result = local_store_->ExecuteQuery(
+            query.query(), /* use_previous_results= */ true);
+
+        View view(query.query(), query_result.remote_keys());
+        ViewDocumentChanges view_doc_changes =
+            view.ComputeDocumentChanges(query_result);
+        ViewChange view_change = view.ApplyChanges(view_doc_changes);
+        HARD_ASSERT(
+            view_change.limbo_changes().empty(),
+            "View returned limbo documents during local-only query execution.");
+
+        HARD_ASSERT(view_change.snapshot().has_value(), "Expected a snapshot");
+
+        ViewSnapshot snapshot = std::move(view_change.snapshot()).value();
+        SnapshotMetadata metadata(snapshot.has_pending_writes(),
+                                  snapshot.from_cache());
+
+        QuerySnapshot result(query.firestore(), query.query(),
+                             std::move(snapshot), std::move(metadata));
+
+        if (shared_callback) {
+          user_executor_->Execute(
+              [=] { shared_callback->OnEvent(std::move(result)); });
+        }
+      },
+      "FirestoreClient::GetDocumentsFromLocalCache");
 }
 
 void FirestoreClient::WriteMutations(std::vector<Mutation>&& mutations,
@@ -519,21 +549,23 @@ void FirestoreClient::WriteMutations(std::vector<Mutation>&& mutations,
   VerifyNotTerminated();
 
   // TODO(c++14): move `mutations` into lambda (C++14).
-  worker_queue_->Enqueue([this, mutations, callback]() mutable {
-    if (mutations.empty()) {
-      if (callback) {
-        user_executor_->Execute([=] { callback(Status::OK()); });
-      }
-    } else {
-      sync_engine_->WriteMutations(
-          std::move(mutations), [this, callback](Status error) {
-            // Dispatch the result back onto the user dispatch queue.
-            if (callback) {
-              user_executor_->Execute([=] { callback(std::move(error)); });
-            }
-          });
-    }
-  });
+  worker_queue_->Enqueue(
+      [this, mutations, callback]() mutable {
+        if (mutations.empty()) {
+          if (callback) {
+            user_executor_->Execute([=] { callback(Status::OK()); });
+          }
+        } else {
+          sync_engine_->WriteMutations(
+              std::move(mutations), [this, callback](Status error) {
+                // Dispatch the result back onto the user dispatch queue.
+                if (callback) {
+                  user_executor_->Execute([=] { callback(std::move(error)); });
+                }
+              });
+        }
+      },
+      "FirestoreClient::WriteMutations");
 }
 
 void FirestoreClient::Transaction(int max_attempts,
@@ -548,11 +580,13 @@ void FirestoreClient::Transaction(int max_attempts,
     }
   };
 
-  worker_queue_->Enqueue([this, max_attempts, update_callback, async_callback] {
-    sync_engine_->Transaction(max_attempts, worker_queue_,
-                              std::move(update_callback),
-                              std::move(async_callback));
-  });
+  worker_queue_->Enqueue(
+      [this, max_attempts, update_callback, async_callback] {
+        sync_engine_->Transaction(max_attempts, worker_queue_,
+                                  std::move(update_callback),
+                                  std::move(async_callback));
+      },
+      "FirestoreClient::Transaction");
 }
 
 void FirestoreClient::RunAggregateQuery(
@@ -569,10 +603,31 @@ void FirestoreClient::RunAggregateQuery(
     }
   };
 
-  worker_queue_->Enqueue([this, query, aggregates, async_callback] {
-    sync_engine_->RunAggregateQuery(query, aggregates,
-                                    std::move(async_callback));
-  });
+  worker_queue_->Enqueue(
+      [this, query, aggregates, async_callback] {
+        sync_engine_->RunAggregateQuery(query, aggregates,
+                                        std::move(async_callback));
+      },
+      "FirestoreClient::RunAggregateQuery");
+}
+
+void FirestoreClient::RunAggregateQueryFromLocalCache(
+    const Query& query,
+    const std::vector<AggregateField>& aggregates,
+    api::AggregateQueryCallback&& result_callback) {
+  VerifyNotTerminated();
+
+  worker_queue_->Enqueue(
+      [this, query, aggregates, result_callback] {
+        auto result = std::make_shared<ObjectValue>(
+            local_store_->ExecuteAggregateQuery(query, aggregates));
+        if (result_callback) {
+          user_executor_->Execute([result_callback, result] {
+            result_callback(StatusOr<ObjectValue>(std::move(*result)));
+          });
+        }
+      },
+      "FirestoreClient::RunAggregateQueryFromLocalCache");
 }
 
 void FirestoreClient::AddSnapshotsInSyncListener(
@@ -618,9 +673,11 @@ void FirestoreClient::LoadBundle(
       remote::Serializer(database_info_.database_id()));
   auto reader = std::make_shared<bundle::BundleReader>(
       std::move(bundle_serializer), std::move(bundle_data));
-  worker_queue_->Enqueue([this, reader, result_task] {
-    sync_engine_->LoadBundle(std::move(reader), std::move(result_task));
-  });
+  worker_queue_->Enqueue(
+      [this, reader, result_task] {
+        sync_engine_->LoadBundle(std::move(reader), std::move(result_task));
+      },
+      "FirestoreClient::LoadBundle");
 }
 
 void FirestoreClient::GetNamedQuery(const std::string& name,
@@ -647,9 +704,11 @@ void FirestoreClient::GetNamedQuery(const std::string& name,
         }
       };
 
-  worker_queue_->Enqueue([this, name, async_callback] {
-    async_callback(local_store_->GetNamedQuery(name));
-  });
+  worker_queue_->Enqueue(
+      [this, name, async_callback] {
+        async_callback(local_store_->GetNamedQuery(name));
+      },
+      "FirestoreClient::GetNamedQuery");
 }
 
 }  // namespace core
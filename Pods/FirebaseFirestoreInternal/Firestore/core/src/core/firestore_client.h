@@ -159,6 +159,15 @@ class FirestoreClient : public std::enable_shared_from_this<FirestoreClient> {
                          const std::vector<model::AggregateField>& aggregates,
                          api::AggregateQueryCallback&& result_callback);
 
+  /**
+   * Computes the given aggregations over the documents in the cache that match
+   * the given query, without contacting the backend.
+   */
+  void RunAggregateQueryFromLocalCache(
+      const Query& query,
+      const std::vector<model::AggregateField>& aggregates,
+      api::AggregateQueryCallback&& result_callback);
+
   /**
    * Adds a listener to be called when a snapshots-in-sync event fires.
    */
@@ -225,6 +234,12 @@ class FirestoreClient : public std::enable_shared_from_this<FirestoreClient> {
    */
   void ScheduleLruGarbageCollection();
 
+  /**
+   * Runs one time slice of LRU garbage collection and schedules the next slice
+   * if the collection isn't complete yet.
+   */
+  void RunLruGarbageCollectionSlice();
+
   /**
    * Schedules a callback to try running index backfiller. Reschedules
    * itself after the backfiller has run.
@@ -146,7 +146,7 @@ ViewSnapshot SyncEngine::InitializeViewAndComputeSnapshot(
 
   View view(query, query_result.remote_keys());
   ViewDocumentChanges view_doc_changes =
-      view.ComputeDocumentChanges(query_result.documents());
+      view.ComputeDocumentChanges(query_result);
   ViewChange view_change =
       view.ApplyChanges(view_doc_changes, synthesized_current_change);
   UpdateTrackedLimboDocuments(view_change.limbo_changes(), target_id);
@@ -518,8 +518,8 @@ void SyncEngine::EmitNewSnapshotsAndNotifyLocalStore(
       // any good docs that had been past the limit.
       QueryResult query_result = local_store_->ExecuteQuery(
           query_view->query(), /* use_previous_results= */ false);
-      view_doc_changes = view.ComputeDocumentChanges(query_result.documents(),
-                                                     view_doc_changes);
+      view_doc_changes =
+          view.ComputeDocumentChanges(query_result, view_doc_changes);
     }
 
     absl::optional<TargetChange> target_changes;
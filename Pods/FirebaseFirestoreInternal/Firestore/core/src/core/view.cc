@@ -49,11 +49,14 @@ bool operator==(const LimboDocumentChange& lhs,
 
 // MARK: - ViewDocumentChanges
 
-ViewDocumentChanges::ViewDocumentChanges(model::DocumentSet new_documents,
-                                         DocumentViewChangeSet changes,
-                                         model::DocumentKeySet mutated_keys,
-                                         bool needs_refill)
+ViewDocumentChanges::ViewDocumentChanges(
+    model::DocumentSet new_documents,
+    model::DocumentSet overflow_documents,
+    DocumentViewChangeSet changes,
+    model::DocumentKeySet mutated_keys,
+    bool needs_refill)
     : document_set_(std::move(new_documents)),
+      overflow_documents_(std::move(overflow_documents)),
       change_set_(std::move(changes)),
       mutated_keys_(std::move(mutated_keys)),
       needs_refill_(needs_refill) {
@@ -85,6 +88,7 @@ int GetDocumentViewChangeTypePosition(DocumentViewChange::Type change_type) {
 View::View(Query query, DocumentKeySet remote_documents)
     : query_(std::move(query)),
       document_set_(query_.Comparator()),
+      overflow_documents_(query_.Comparator()),
       synced_documents_(std::move(remote_documents)) {
 }
 
@@ -95,6 +99,21 @@ ComparisonResult View::Compare(const Document& lhs, const Document& rhs) const {
 ViewDocumentChanges View::ComputeDocumentChanges(
     const DocumentMap& doc_changes,
     const absl::optional<ViewDocumentChanges>& previous_changes) const {
+  return ComputeDocumentChanges(doc_changes, previous_changes,
+                                /* has_all_matches= */ false);
+}
+
+ViewDocumentChanges View::ComputeDocumentChanges(
+    const local::QueryResult& query_result,
+    const absl::optional<ViewDocumentChanges>& previous_changes) const {
+  return ComputeDocumentChanges(query_result.documents(), previous_changes,
+                                query_result.has_all_matches());
+}
+
+ViewDocumentChanges View::ComputeDocumentChanges(
+    const DocumentMap& doc_changes,
+    const absl::optional<ViewDocumentChanges>& previous_changes,
+    bool has_all_matches) const {
   DocumentViewChangeSet change_set;
   if (previous_changes) {
     change_set = previous_changes->change_set();
@@ -106,26 +125,33 @@ ViewDocumentChanges View::ComputeDocumentChanges(
       previous_changes ? previous_changes->mutated_keys() : mutated_keys_;
   DocumentKeySet old_mutated_keys = mutated_keys_;
   DocumentSet new_document_set = old_document_set;
-  bool needs_refill = false;
-
-  // Track the last doc in a (full) limit. This is necessary, because some
-  // update (a delete, or an update moving a doc past the old limit) might mean
-  // there is some other document in the local cache that either should come (1)
-  // between the old last limit doc and the new last document, in the case of
-  // updates, or (2) after the new last document, in the case of deletes. So we
-  // keep this doc at the old limit to compare the updates to.
+
+  // A refill starts from documents that may be missing some of the results,
+  // so it only holds on to documents past the limit that come with all the
+  // matching documents of the local cache.
+  DocumentSet new_overflow_documents =
+      previous_changes ? DocumentSet{query_.Comparator()} : overflow_documents_;
+
+  // The view holds every matching document up to the last document of a full
+  // limit, and up to the last of the documents past the limit it buffers. No
+  // such boundary is known in a refill, which only ever adds documents, and
+  // none is needed when `doc_changes` holds every matching document.
   //
-  // Note that this should never get used in a refill (when previous_changes is
-  // set), because there will only be adds -- no deletes or updates.
-  absl::optional<Document> last_doc_in_limit;
-  if (query_.has_limit_to_first() &&
-      old_document_set.size() == static_cast<size_t>(query_.limit())) {
-    last_doc_in_limit = old_document_set.GetLastDocument();
-  }
-  absl::optional<Document> first_doc_in_limit;
-  if (query_.has_limit_to_last() &&
-      old_document_set.size() == static_cast<size_t>(query_.limit())) {
-    first_doc_in_limit = old_document_set.GetFirstDocument();
+  // Any document that sorts past the boundary may have some other document in
+  // the local cache sorting before it that the view hasn't seen, so it can't
+  // be shown without going back to the local cache. Documents up to the
+  // boundary are known to be complete: any change to one of them is part of
+  // `doc_changes`.
+  bool limit_to_first = query_.has_limit_to_first();
+  size_t limit = 0;
+  absl::optional<Document> boundary_doc;
+  if (query_.limit_type() != LimitType::None) {
+    limit = static_cast<size_t>(query_.limit());
+    if (!previous_changes && old_document_set.size() == limit) {
+      boundary_doc = OuterDocument(new_overflow_documents.empty()
+                                       ? old_document_set
+                                       : new_overflow_documents);
+    }
   }
 
   for (const auto& kv : doc_changes) {
@@ -136,6 +162,11 @@ ViewDocumentChanges View::ComputeDocumentChanges(
                                            ? absl::optional<Document>{kv.second}
                                            : absl::nullopt;
 
+    // A buffered document that changes is treated like one the view has not
+    // seen, which adds it to the window if it still matches. It is returned to
+    // the buffer below if it doesn't make the limit.
+    new_overflow_documents = new_overflow_documents.erase(key);
+
     bool old_doc_had_pending_mutations =
         old_doc && old_mutated_keys.contains(key);
 
@@ -155,19 +186,6 @@ ViewDocumentChanges View::ComputeDocumentChanges(
           change_set.AddChange(
               DocumentViewChange{*new_doc, DocumentViewChange::Type::Modified});
           change_applied = true;
-
-          bool outside_limit =
-              last_doc_in_limit &&
-              util::Descending(Compare(*new_doc, *last_doc_in_limit));
-          bool outside_limit_to_last =
-              first_doc_in_limit &&
-              util::Ascending(Compare(*new_doc, *first_doc_in_limit));
-          if (outside_limit || outside_limit_to_last) {
-            // This doc moved from inside the limit to after the limit. That
-            // means there may be some doc in the local cache that's actually
-            // less than this one.
-            needs_refill = true;
-          }
         }
       } else if (old_doc_had_pending_mutations !=
                  new_doc_has_pending_mutations) {
@@ -184,13 +202,6 @@ ViewDocumentChanges View::ComputeDocumentChanges(
       change_set.AddChange(
           DocumentViewChange{*old_doc, DocumentViewChange::Type::Removed});
       change_applied = true;
-
-      if (last_doc_in_limit || first_doc_in_limit) {
-        // A doc was removed from a full limit query. We'll need to re-query
-        // from the local cache to see if we know about some other doc that
-        // should be in the results.
-        needs_refill = true;
-      }
     }
 
     if (change_applied) {
@@ -208,28 +219,88 @@ ViewDocumentChanges View::ComputeDocumentChanges(
     }
   }
 
-  // Drop documents out to meet limitToFirst/limitToLast requirement.
-  if (query_.limit_type() != LimitType::None) {
-    auto limit = static_cast<size_t>(query_.limit());
-    if (limit < new_document_set.size()) {
-      for (size_t i = new_document_set.size() - limit; i > 0; --i) {
-        absl::optional<Document> found =
-            query_.has_limit_to_first() ? new_document_set.GetLastDocument()
-                                        : new_document_set.GetFirstDocument();
-        const Document& old_doc = *found;
-        new_document_set = new_document_set.erase(old_doc->key());
-        new_mutated_keys = new_mutated_keys.erase(old_doc->key());
-        change_set.AddChange(
-            DocumentViewChange{old_doc, DocumentViewChange::Type::Removed});
-      }
+  if (query_.limit_type() == LimitType::None) {
+    return ViewDocumentChanges(
+        std::move(new_document_set), std::move(new_overflow_documents),
+        std::move(change_set), new_mutated_keys, /* needs_refill= */ false);
+  }
+
+  // Whether `lhs` sorts further from the start of the limit than `rhs`.
+  auto sorts_past = [&](const Document& lhs, const Document& rhs) {
+    ComparisonResult result = Compare(lhs, rhs);
+    return limit_to_first ? util::Descending(result)
+                          : util::Ascending(result);
+  };
+
+  // Moves the outermost document of the window into the buffer, or drops it
+  // if the view can't tell where it sorts relative to the rest of the cache.
+  auto spill_outer_document = [&] {
+    Document doc = *OuterDocument(new_document_set);
+    new_document_set = new_document_set.erase(doc->key());
+    new_mutated_keys = new_mutated_keys.erase(doc->key());
+    change_set.AddChange(
+        DocumentViewChange{doc, DocumentViewChange::Type::Removed});
+    if (has_all_matches || (boundary_doc && !sorts_past(doc, *boundary_doc))) {
+      new_overflow_documents = new_overflow_documents.insert(doc);
     }
+  };
+
+  // Drop documents out to meet limitToFirst/limitToLast requirement, then make
+  // sure that everything left in the window sorts ahead of the buffer.
+  while (new_document_set.size() > limit) {
+    spill_outer_document();
+  }
+  while (!new_document_set.empty() && !new_overflow_documents.empty() &&
+         sorts_past(*OuterDocument(new_document_set),
+                    *InnerDocument(new_overflow_documents))) {
+    spill_outer_document();
   }
 
+  // Slide documents from the buffer into the window to fill the limit back up.
+  while (new_document_set.size() < limit && !new_overflow_documents.empty()) {
+    Document doc = *InnerDocument(new_overflow_documents);
+    new_overflow_documents = new_overflow_documents.erase(doc->key());
+    new_document_set = new_document_set.insert(doc);
+    if (doc->has_local_mutations()) {
+      new_mutated_keys = new_mutated_keys.insert(doc->key());
+    } else {
+      new_mutated_keys = new_mutated_keys.erase(doc->key());
+    }
+    change_set.AddChange(
+        DocumentViewChange{doc, DocumentViewChange::Type::Added});
+  }
+
+  // Buffering as many documents as fit in the limit lets the window slide by
+  // a full page, while bounding the memory the view uses to twice the limit.
+  while (new_overflow_documents.size() > limit) {
+    Document doc = *OuterDocument(new_overflow_documents);
+    new_overflow_documents = new_overflow_documents.erase(doc->key());
+  }
+
+  // A full limit that lost documents the buffer couldn't replace, or that now
+  // shows a document past the boundary, may be missing a document from the
+  // local cache.
+  bool needs_refill =
+      !has_all_matches && boundary_doc &&
+      (new_document_set.size() < limit ||
+       sorts_past(*OuterDocument(new_document_set), *boundary_doc));
+
   HARD_ASSERT(!needs_refill || !previous_changes,
               "View was refilled using docs that themselves needed refilling.");
 
-  return ViewDocumentChanges(std::move(new_document_set), std::move(change_set),
-                             new_mutated_keys, needs_refill);
+  return ViewDocumentChanges(
+      std::move(new_document_set), std::move(new_overflow_documents),
+      std::move(change_set), new_mutated_keys, needs_refill);
+}
+
+absl::optional<Document> View::InnerDocument(const DocumentSet& set) const {
+  return query_.has_limit_to_first() ? set.GetFirstDocument()
+                                     : set.GetLastDocument();
+}
+
+absl::optional<Document> View::OuterDocument(const DocumentSet& set) const {
+  return query_.has_limit_to_first() ? set.GetLastDocument()
+                                     : set.GetFirstDocument();
 }
 
 bool View::ShouldWaitForSyncedDocument(const Document& new_doc,
@@ -254,6 +325,7 @@ ViewChange View::ApplyChanges(const ViewDocumentChanges& doc_changes,
 
   DocumentSet old_documents = document_set_;
   document_set_ = doc_changes.document_set();
+  overflow_documents_ = doc_changes.overflow_documents();
   mutated_keys_ = doc_changes.mutated_keys();
 
   // Sort changes based on type and query comparator.
@@ -311,8 +383,9 @@ ViewChange View::ApplyOnlineStateChange(OnlineState online_state) {
     // once the client is back online.
     current_ = false;
     return ApplyChanges(
-        ViewDocumentChanges(document_set_, DocumentViewChangeSet{},
-                            mutated_keys_, /* needs_refill= */ false));
+        ViewDocumentChanges(document_set_, overflow_documents_,
+                            DocumentViewChangeSet{}, mutated_keys_,
+                            /* needs_refill= */ false));
   } else {
     // No effect, just return a no-op ViewChange.
     return ViewChange(absl::nullopt, {});
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "Firestore/core/src/core/view_snapshot.h"
+#include "Firestore/core/src/local/query_result.h"
 #include "Firestore/core/src/model/document_key_set.h"
 #include "Firestore/core/src/model/document_set.h"
 #include "Firestore/core/src/model/types.h"
@@ -68,6 +69,7 @@ class LimboDocumentChange {
 class ViewDocumentChanges {
  public:
   ViewDocumentChanges(model::DocumentSet new_documents,
+                      model::DocumentSet overflow_documents,
                       DocumentViewChangeSet changes,
                       model::DocumentKeySet mutated_keys,
                       bool needs_refill);
@@ -77,6 +79,14 @@ class ViewDocumentChanges {
     return document_set_;
   }
 
+  /**
+   * The matching docs that sort just past the limit of the view, which are
+   * kept to fill the limit back up when docs leave it.
+   */
+  const model::DocumentSet& overflow_documents() const {
+    return overflow_documents_;
+  }
+
   /** The diff of these docs with the previous set of docs. */
   const core::DocumentViewChangeSet& change_set() const {
     return change_set_;
@@ -97,6 +107,7 @@ class ViewDocumentChanges {
 
  private:
   model::DocumentSet document_set_;
+  model::DocumentSet overflow_documents_;
   core::DocumentViewChangeSet change_set_;
   model::DocumentKeySet mutated_keys_;
   bool needs_refill_ = false;
@@ -161,6 +172,16 @@ class View {
       const absl::optional<core::ViewDocumentChanges>& previous_changes =
           absl::nullopt) const;
 
+  /**
+   * Like `ComputeDocumentChanges` above, using the documents of the view's
+   * query run against the local cache. If the result holds every matching
+   * document, the docs that sort past the limit seed the view's buffer.
+   */
+  core::ViewDocumentChanges ComputeDocumentChanges(
+      const local::QueryResult& query_result,
+      const absl::optional<core::ViewDocumentChanges>& previous_changes =
+          absl::nullopt) const;
+
   /**
    * Updates the view with the given ViewDocumentChanges and updates limbo docs
    * and sync state from the given (optional) target change.
@@ -192,6 +213,25 @@ class View {
   util::ComparisonResult Compare(const model::Document& lhs,
                                  const model::Document& rhs) const;
 
+  core::ViewDocumentChanges ComputeDocumentChanges(
+      const model::DocumentMap& doc_changes,
+      const absl::optional<core::ViewDocumentChanges>& previous_changes,
+      bool has_all_matches) const;
+
+  /**
+   * Returns the doc of the given set that sorts closest to the start of the
+   * limit (the first doc for limitToFirst, the last for limitToLast).
+   */
+  absl::optional<model::Document> InnerDocument(
+      const model::DocumentSet& set) const;
+
+  /**
+   * Returns the doc of the given set that sorts furthest from the start of the
+   * limit.
+   */
+  absl::optional<model::Document> OuterDocument(
+      const model::DocumentSet& set) const;
+
   bool ShouldBeInLimbo(const model::DocumentKey& key) const;
 
   bool ShouldWaitForSyncedDocument(const model::Document& new_doc,
@@ -206,6 +246,14 @@ class View {
 
   model::DocumentSet document_set_;
 
+  /**
+   * For limit queries, the matching documents that sort just past the limit.
+   * The view holds every matching document from the start of the limit up to
+   * the last of these, so documents can slide into the limit as others leave
+   * it without re-running the query against the local cache.
+   */
+  model::DocumentSet overflow_documents_;
+
   /** Documents included in the remote target. */
   model::DocumentKeySet synced_documents_;
 
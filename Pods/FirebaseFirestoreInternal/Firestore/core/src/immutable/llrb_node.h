@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Firestore/core/src/immutable/llrb_node_iterator.h"
 #include "Firestore/core/src/immutable/sorted_container.h"
@@ -101,6 +102,14 @@ class LlrbNode : public SortedMapBase {
   template <typename Comparator>
   LlrbNode erase(const K& key, const Comparator& comparator) const;
 
+  /**
+   * Builds a tree from `size` entries in ascending key order without
+   * duplicates, where `entry_at(i)` returns the i-th entry. Unlike repeated
+   * insertion, this takes linear time and allocates each node exactly once.
+   */
+  template <typename EntryAt>
+  static LlrbNode FromSorted(size_type size, const EntryAt& entry_at);
+
   const LlrbNode& min() const {
     const LlrbNode* node = this;
     while (!node->left().empty()) {
@@ -213,6 +222,11 @@ class LlrbNode : public SortedMapBase {
     rep_->right_ = std::move(right);
   }
 
+  template <typename EntryAt>
+  static LlrbNode BuildPerfect(size_type start,
+                               size_type size,
+                               const EntryAt& entry_at);
+
   template <typename Comparator>
   LlrbNode InnerInsert(const K& key,
                        const V& value,
@@ -249,6 +263,66 @@ LlrbNode<K, V> LlrbNode<K, V>::insert(const K& key,
   return root;
 }
 
+template <typename K, typename V>
+template <typename EntryAt>
+LlrbNode<K, V> LlrbNode<K, V>::FromSorted(size_type size,
+                                          const EntryAt& entry_at) {
+  // The tree is assembled from a chain of "pennants": a node whose right child
+  // is a perfect black tree of 2^k - 1 entries. Writing size + 1 as
+  // 2^n + value, the chain has one black pennant of each size 2^k for k < n,
+  // plus a red one right below it wherever bit k of `value` is set. Each
+  // pennant becomes the left child of the one above, so red links only lean
+  // left and every path from the root has n black nodes. See "Constructing
+  // Red-Black Trees" by Ralf Hinze.
+  struct Pennant {
+    size_type start;
+    size_type size;
+    Color color;
+  };
+
+  size_type total = size + 1;
+  int length = 0;
+  while ((total >> (length + 1)) != 0) {
+    ++length;
+  }
+  size_type value = total & ((size_type{1} << length) - 1);
+
+  // Pennants from the root downwards, holding decreasing ranges of entries.
+  std::vector<Pennant> chain;
+  size_type end = size;
+  for (int bit = length - 1; bit >= 0; --bit) {
+    size_type chunk = size_type{1} << bit;
+    end -= chunk;
+    chain.push_back({end, chunk, Color::Black});
+    if ((value & chunk) != 0) {
+      end -= chunk;
+      chain.push_back({end, chunk, Color::Red});
+    }
+  }
+
+  LlrbNode result;
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    LlrbNode right = BuildPerfect(it->start + 1, it->size - 1, entry_at);
+    result = LlrbNode{Rep{entry_at(it->start), it->color, std::move(result),
+                          std::move(right)}};
+  }
+  return result;
+}
+
+template <typename K, typename V>
+template <typename EntryAt>
+LlrbNode<K, V> LlrbNode<K, V>::BuildPerfect(size_type start,
+                                            size_type size,
+                                            const EntryAt& entry_at) {
+  if (size == 0) return LlrbNode{};
+
+  size_type half = size / 2;
+  LlrbNode left = BuildPerfect(start, half, entry_at);
+  LlrbNode right = BuildPerfect(start + half + 1, half, entry_at);
+  return LlrbNode{Rep{entry_at(start + half), Color::Black, std::move(left),
+                      std::move(right)}};
+}
+
 template <typename K, typename V>
 template <typename Comparator>
 LlrbNode<K, V> LlrbNode<K, V>::InnerInsert(const K& key,
@@ -25,6 +25,7 @@
 #include "Firestore/core/src/immutable/sorted_map_iterator.h"
 #include "Firestore/core/src/immutable/tree_sorted_map.h"
 #include "Firestore/core/src/util/comparison.h"
+#include "Firestore/core/src/util/hard_assert.h"
 #include "absl/base/attributes.h"
 #include "absl/types/optional.h"
 
@@ -73,6 +74,29 @@ class SortedMap : public SortedMapBase {
     }
   }
 
+  /**
+   * Creates a SortedMap from `size` entries that are already sorted according
+   * to `comparator` and unique, where `entry_at(i)` returns the i-th entry.
+   * Takes linear time, unlike inserting the entries one at a time.
+   */
+  template <typename EntryAt>
+  static SortedMap FromSorted(size_type size,
+                              const EntryAt& entry_at,
+                              const C& comparator = {}) {
+    if (size <= kFixedSize) {
+      array_type array{comparator};
+      for (size_type i = 0; i < size; ++i) {
+        value_type entry = entry_at(i);
+        HARD_ASSERT(array.empty() || util::Ascending(comparator.Compare(
+                                         array.max()->first, entry.first)),
+                    "FromSorted requires strictly ascending keys");
+        array = array.insert(entry.first, entry.second);
+      }
+      return SortedMap{std::move(array)};
+    }
+    return SortedMap{tree_type::FromSorted(size, entry_at, comparator)};
+  }
+
   SortedMap(const SortedMap& other) : tag_{other.tag_} {
     switch (tag_) {
       case Tag::Array:
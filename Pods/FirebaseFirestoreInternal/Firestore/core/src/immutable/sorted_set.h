@@ -141,6 +141,23 @@ class SortedSet : public SortedContainer {
     return map_.keys_in(start_key, end_key);
   }
 
+  /**
+   * Creates a set from a random-access range of keys that is already sorted
+   * according to `comparator` and has no duplicates, in linear time.
+   */
+  template <typename RandomIt>
+  static SortedSet FromSorted(RandomIt first,
+                              RandomIt last,
+                              const C& comparator = {}) {
+    auto size = static_cast<size_type>(last - first);
+    return SortedSet{map_type::FromSorted(
+        size,
+        [first](size_type i) {
+          return typename map_type::value_type{first[i], {}};
+        },
+        comparator)};
+  }
+
   template <typename MapType>
   static SortedSet FromKeysOf(const MapType& map) {
     SortedSet result;
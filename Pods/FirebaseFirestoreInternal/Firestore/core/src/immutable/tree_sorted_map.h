@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -28,6 +29,7 @@
 #include "Firestore/core/src/immutable/sorted_container.h"
 #include "Firestore/core/src/util/comparison.h"
 #include "Firestore/core/src/util/compressed_member.h"
+#include "Firestore/core/src/util/hard_assert.h"
 
 namespace firebase {
 namespace firestore {
@@ -74,6 +76,33 @@ class TreeSortedMap : public SortedMapBase, private util::CompressedMember<C> {
     return TreeSortedMap{std::move(node), comparator};
   }
 
+  /**
+   * Creates a TreeSortedMap from `size` entries that are already sorted
+   * according to `comparator` and unique, where `entry_at(i)` returns the i-th
+   * entry.
+   */
+  template <typename EntryAt>
+  static TreeSortedMap FromSorted(size_type size,
+                                  const EntryAt& entry_at,
+                                  const C& comparator) {
+    TreeSortedMap result{node_type::FromSorted(size, entry_at), comparator};
+
+    // The tree takes the entries' order on trust, so out of order or
+    // duplicate keys would silently break lookups. Checking the finished tree
+    // costs one comparison per entry and no copies.
+    const_iterator previous = result.begin();
+    const_iterator end = result.end();
+    if (previous != end) {
+      for (const_iterator it = std::next(previous); it != end;
+           previous = it, ++it) {
+        HARD_ASSERT(util::Ascending(comparator.Compare(previous->first,
+                                                       it->first)),
+                    "FromSorted requires strictly ascending keys");
+      }
+    }
+    return result;
+  }
+
   /** Returns true if the map contains no elements. */
   bool empty() const {
     return root_.empty();
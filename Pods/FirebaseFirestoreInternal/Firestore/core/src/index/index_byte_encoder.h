@@ -17,14 +17,13 @@
 #ifndef FIRESTORE_CORE_SRC_INDEX_INDEX_BYTE_ENCODER_H_
 #define FIRESTORE_CORE_SRC_INDEX_INDEX_BYTE_ENCODER_H_
 
-#include <memory>
 #include <string>
+#include <utility>
 
 #include "Firestore/core/src/model/field_index.h"
 #include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/nanopb/nanopb_util.h"
 #include "Firestore/core/src/util/ordered_code.h"
-#include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 
 namespace firebase {
@@ -47,112 +46,128 @@ class DirectionalIndexByteEncoder {
   virtual void WriteInfinity() = 0;
 };
 
-class AscendingIndexByteEncoder;
-class DescendingIndexByteEncoder;
-
-/**
- * Manages index encoders and a buffer storing the encoded content.
- */
-class IndexEncodingBuffer {
+class AscendingIndexByteEncoder : public DirectionalIndexByteEncoder {
  public:
-  IndexEncodingBuffer()
-      : ascendingEncoder_(absl::make_unique<AscendingIndexByteEncoder>(this)),
-        descendingEncoder_(
-            absl::make_unique<DescendingIndexByteEncoder>(this)) {
+  explicit AscendingIndexByteEncoder(std::string* buffer) : buffer_(buffer) {
   }
 
-  void Seed(const std::string& bytes) {
-    util::AppendBytes<false>(&buffer_, bytes.data(), bytes.size());
+  void WriteBytes(pb_bytes_array_t* val) override {
+    util::OrderedCode::WriteString(buffer_, nanopb::MakeStringView(val));
   }
 
-  /** Returns a pointer to the encoder used by the given segment kind. */
-  DirectionalIndexByteEncoder* ForKind(model::Segment::Kind kind) {
-    if (kind == model::Segment::Kind::kDescending) {
-      return reinterpret_cast<DirectionalIndexByteEncoder*>(
-          descendingEncoder_.get());
-    } else {
-      return reinterpret_cast<DirectionalIndexByteEncoder*>(
-          ascendingEncoder_.get());
-    }
+  void WriteString(absl::string_view val) override {
+    util::OrderedCode::WriteString(buffer_, val);
   }
 
-  const std::string& GetEncodedBytes() const {
-    return buffer_;
+  void WriteLong(int64_t val) override {
+    util::OrderedCode::WriteSignedNumIncreasing(buffer_, val);
   }
 
-  void Reset() {
-    buffer_.clear();
+  void WriteDouble(double val) override {
+    util::OrderedCode::WriteDoubleIncreasing(buffer_, val);
   }
 
- private:
-  friend class AscendingIndexByteEncoder;
-  friend class DescendingIndexByteEncoder;
+  void WriteInfinity() override {
+    util::OrderedCode::WriteInfinity(buffer_);
+  }
 
-  std::string buffer_;
-  std::unique_ptr<AscendingIndexByteEncoder> ascendingEncoder_;
-  std::unique_ptr<DescendingIndexByteEncoder> descendingEncoder_;
+ private:
+  std::string* buffer_;
 };
 
-class AscendingIndexByteEncoder : public DirectionalIndexByteEncoder {
+class DescendingIndexByteEncoder : public DirectionalIndexByteEncoder {
  public:
-  explicit AscendingIndexByteEncoder(IndexEncodingBuffer* encoder)
-      : encoder_(encoder) {
+  explicit DescendingIndexByteEncoder(std::string* buffer) : buffer_(buffer) {
   }
 
   void WriteBytes(pb_bytes_array_t* val) override {
-    util::OrderedCode::WriteString(&encoder_->buffer_,
-                                   nanopb::MakeStringView(val));
+    util::OrderedCode::WriteStringDecreasing(buffer_,
+                                             nanopb::MakeStringView(val));
   }
 
   void WriteString(absl::string_view val) override {
-    util::OrderedCode::WriteString(&encoder_->buffer_, val);
+    util::OrderedCode::WriteStringDecreasing(buffer_, val);
   }
 
   void WriteLong(int64_t val) override {
-    util::OrderedCode::WriteSignedNumIncreasing(&encoder_->buffer_, val);
+    util::OrderedCode::WriteSignedNumDecreasing(buffer_, val);
   }
 
   void WriteDouble(double val) override {
-    util::OrderedCode::WriteDoubleIncreasing(&encoder_->buffer_, val);
+    util::OrderedCode::WriteDoubleDecreasing(buffer_, val);
   }
 
   void WriteInfinity() override {
-    util::OrderedCode::WriteInfinity(&encoder_->buffer_);
+    util::OrderedCode::WriteInfinity(buffer_);
   }
 
  private:
-  IndexEncodingBuffer* encoder_;
+  std::string* buffer_;
 };
 
-class DescendingIndexByteEncoder : public DirectionalIndexByteEncoder {
+/**
+ * Manages index encoders and a buffer storing the encoded content.
+ *
+ * The encoders are stored inline and write straight into the buffer, so a
+ * buffer costs no allocations beyond the encoded bytes themselves. Callers
+ * that encode many values should keep one buffer around and `Reset` it between
+ * values, which reuses its capacity.
+ */
+class IndexEncodingBuffer {
  public:
-  explicit DescendingIndexByteEncoder(IndexEncodingBuffer* encoder)
-      : encoder_(encoder) {
+  IndexEncodingBuffer()
+      : ascending_encoder_(&buffer_), descending_encoder_(&buffer_) {
   }
 
-  void WriteBytes(pb_bytes_array_t* val) override {
-    util::OrderedCode::WriteStringDecreasing(&encoder_->buffer_,
-                                             nanopb::MakeStringView(val));
+  // The encoders point at `buffer_`, so copies and moves must not copy them.
+  IndexEncodingBuffer(const IndexEncodingBuffer& other)
+      : buffer_(other.buffer_),
+        ascending_encoder_(&buffer_),
+        descending_encoder_(&buffer_) {
   }
 
-  void WriteString(absl::string_view val) override {
-    util::OrderedCode::WriteStringDecreasing(&encoder_->buffer_, val);
+  IndexEncodingBuffer(IndexEncodingBuffer&& other) noexcept
+      : buffer_(std::move(other.buffer_)),
+        ascending_encoder_(&buffer_),
+        descending_encoder_(&buffer_) {
   }
 
-  void WriteLong(int64_t val) override {
-    util::OrderedCode::WriteSignedNumDecreasing(&encoder_->buffer_, val);
+  IndexEncodingBuffer& operator=(const IndexEncodingBuffer& other) {
+    buffer_ = other.buffer_;
+    return *this;
   }
 
-  void WriteDouble(double val) override {
-    util::OrderedCode::WriteDoubleDecreasing(&encoder_->buffer_, val);
+  IndexEncodingBuffer& operator=(IndexEncodingBuffer&& other) noexcept {
+    buffer_ = std::move(other.buffer_);
+    return *this;
   }
 
-  void WriteInfinity() override {
-    util::OrderedCode::WriteInfinity(&encoder_->buffer_);
+  void Seed(const std::string& bytes) {
+    util::AppendBytes<false>(&buffer_, bytes.data(), bytes.size());
+  }
+
+  /** Returns a pointer to the encoder used by the given segment kind. */
+  DirectionalIndexByteEncoder* ForKind(model::Segment::Kind kind) {
+    if (kind == model::Segment::Kind::kDescending) {
+      return &descending_encoder_;
+    } else {
+      return &ascending_encoder_;
+    }
+  }
+
+  const std::string& GetEncodedBytes() const {
+    return buffer_;
+  }
+
+  /** Clears the encoded content, keeping the allocated capacity. */
+  void Reset() {
+    buffer_.clear();
   }
 
  private:
-  IndexEncodingBuffer* encoder_;
+  std::string buffer_;
+  AscendingIndexByteEncoder ascending_encoder_;
+  DescendingIndexByteEncoder descending_encoder_;
 };
 
 }  // namespace index
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_LOCAL_FIELD_NAME_DICTIONARY_H_
+#define FIRESTORE_CORE_SRC_LOCAL_FIELD_NAME_DICTIONARY_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+/**
+ * Assigns small integer IDs to field names so that documents can be stored
+ * without repeating the names of their fields. IDs are never reassigned: once
+ * a field name has an ID, the mapping holds for the lifetime of the storage
+ * backing the dictionary.
+ */
+class FieldNameDictionary {
+ public:
+  virtual ~FieldNameDictionary() = default;
+
+  /** Returns the ID of `field_name`, assigning a new ID if it has none. */
+  virtual int32_t GetOrAssignId(absl::string_view field_name) = 0;
+
+  /**
+   * Returns the field name with the given ID, or nullptr if no field name has
+   * that ID. The result remains valid for the lifetime of the dictionary.
+   */
+  virtual const std::string* FindFieldName(int32_t id) const = 0;
+};
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_LOCAL_FIELD_NAME_DICTIONARY_H_
@@ -34,6 +34,10 @@ namespace local {
  *
  * `sessionToken` tracks server interaction across Listen and Write streams.
  * This facilitates cache synchronization and invalidation.
+ *
+ * `sequenceNumberHistogram` summarizes the sequence numbers of the orphaned
+ * documents, so that LRU garbage collection doesn't have to enumerate them to
+ * pick the documents to collect.
  */
 class GlobalsCache {
  public:
@@ -48,6 +52,17 @@ class GlobalsCache {
    * Sets session token.
    */
   virtual void SetSessionToken(const ByteString& session_token) = 0;
+
+  /**
+   * Gets the encoded sequence number histogram, or an empty `ByteString` if
+   * none has been saved.
+   */
+  virtual ByteString GetSequenceNumberHistogram() const = 0;
+
+  /**
+   * Sets the encoded sequence number histogram.
+   */
+  virtual void SetSequenceNumberHistogram(const ByteString& histogram) = 0;
 };
 
 }  // namespace local
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/leveldb_field_name_dictionary.h"
+
+#include <limits>
+#include <utility>
+
+#include "Firestore/core/src/local/leveldb_key.h"
+#include "Firestore/core/src/local/leveldb_persistence.h"
+#include "Firestore/core/src/local/leveldb_transaction.h"
+#include "Firestore/core/src/util/hard_assert.h"
+#include "absl/strings/match.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+LevelDbFieldNameDictionary::LevelDbFieldNameDictionary(
+    LevelDbPersistence* db, std::string collection_group)
+    : db_(NOT_NULL(db)), collection_group_(std::move(collection_group)) {
+  Load();
+}
+
+LevelDbFieldNameDictionary::LevelDbFieldNameDictionary(
+    LevelDbTransaction* transaction, std::string collection_group)
+    : transaction_(NOT_NULL(transaction)),
+      collection_group_(std::move(collection_group)) {
+  Load();
+}
+
+void LevelDbFieldNameDictionary::Load() {
+  auto it = transaction()->NewIterator();
+  std::string key_prefix = LevelDbFieldNameKey::KeyPrefix(collection_group_);
+  LevelDbFieldNameKey row_key;
+  for (it->Seek(key_prefix); it->Valid(); it->Next()) {
+    if (!absl::StartsWith(it->key(), key_prefix) ||
+        !row_key.Decode(it->key())) {
+      break;
+    }
+
+    // IDs are assigned densely from zero and rows are sorted by ID.
+    HARD_ASSERT(row_key.field_name_id() ==
+                    static_cast<int32_t>(field_names_.size()),
+                "Field name dictionary for %s is missing ID %s",
+                collection_group_, field_names_.size());
+    field_names_.push_back(it->value());
+    ids_.emplace(field_names_.back(), row_key.field_name_id());
+  }
+}
+
+int32_t LevelDbFieldNameDictionary::GetOrAssignId(
+    absl::string_view field_name) {
+  auto found = ids_.find(field_name);
+  if (found != ids_.end()) {
+    return found->second;
+  }
+
+  HARD_ASSERT(field_names_.size() <
+                  static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+              "Field name dictionary for %s is full", collection_group_);
+  auto id = static_cast<int32_t>(field_names_.size());
+  field_names_.emplace_back(field_name);
+  ids_.emplace(field_names_.back(), id);
+
+  transaction()->Put(LevelDbFieldNameKey::Key(collection_group_, id),
+                     field_name);
+  return id;
+}
+
+const std::string* LevelDbFieldNameDictionary::FindFieldName(
+    int32_t id) const {
+  if (id < 0 || static_cast<size_t>(id) >= field_names_.size()) {
+    return nullptr;
+  }
+  return &field_names_[static_cast<size_t>(id)];
+}
+
+LevelDbTransaction* LevelDbFieldNameDictionary::transaction() const {
+  return db_ != nullptr ? db_->current_transaction() : transaction_;
+}
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_LOCAL_LEVELDB_FIELD_NAME_DICTIONARY_H_
+#define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_FIELD_NAME_DICTIONARY_H_
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "Firestore/core/src/local/field_name_dictionary.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+class LevelDbPersistence;
+class LevelDbTransaction;
+
+/**
+ * Marks a stored document whose field names have been replaced by IDs from the
+ * field name dictionary. An encoded protocol buffer never starts with a zero
+ * byte, as 0 is not a valid field number, so this prefix can't be mistaken for
+ * the start of a plainly encoded document.
+ *
+ * Only documents with at least one field are stored this way, so the
+ * field_names table is never empty while any such document exists.
+ */
+constexpr absl::string_view kFieldNameDictionaryPrefix("\0", 1);
+
+/**
+ * The field name dictionary of a single collection group, backed by the
+ * field_names table in leveldb.
+ *
+ * The existing entries are read from the current transaction when the
+ * dictionary is created and kept in memory from then on. New entries are
+ * written to the current transaction as they are assigned.
+ *
+ * `FindFieldName` may be called concurrently from multiple threads, but not
+ * concurrently with `GetOrAssignId`.
+ */
+class LevelDbFieldNameDictionary : public FieldNameDictionary {
+ public:
+  LevelDbFieldNameDictionary(LevelDbPersistence* db,
+                             std::string collection_group);
+
+  /**
+   * Creates a dictionary that reads from and writes to the given transaction
+   * rather than the current transaction of a `LevelDbPersistence`, for use in
+   * migrations. The dictionary must not outlive `transaction`.
+   */
+  LevelDbFieldNameDictionary(LevelDbTransaction* transaction,
+                             std::string collection_group);
+
+  int32_t GetOrAssignId(absl::string_view field_name) override;
+
+  const std::string* FindFieldName(int32_t id) const override;
+
+ private:
+  void Load();
+
+  LevelDbTransaction* transaction() const;
+
+  // The LevelDbFieldNameDictionary instance is owned by
+  // LevelDbRemoteDocumentCache, which is owned by LevelDbPersistence. Only
+  // one of `db_` and `transaction_` is set.
+  LevelDbPersistence* db_ = nullptr;
+  LevelDbTransaction* transaction_ = nullptr;
+  std::string collection_group_;
+
+  // Field names indexed by their ID. A deque keeps the strings in place as it
+  // grows, so the views in `ids_` and the pointers handed out by
+  // `FindFieldName` stay valid.
+  std::deque<std::string> field_names_;
+  absl::flat_hash_map<absl::string_view, int32_t> ids_;
+};
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_LOCAL_LEVELDB_FIELD_NAME_DICTIONARY_H_
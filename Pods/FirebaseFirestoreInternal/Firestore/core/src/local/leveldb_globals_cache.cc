@@ -19,6 +19,7 @@
 #include "Firestore/core/src/local/leveldb_globals_cache.h"
 #include "Firestore/core/src/local/leveldb_key.h"
 #include "Firestore/core/src/local/leveldb_persistence.h"
+#include "Firestore/core/src/nanopb/nanopb_util.h"
 
 namespace firebase {
 namespace firestore {
@@ -27,6 +28,7 @@ namespace local {
 namespace {
 
 const char* kSessionToken = "session_token";
+const char* kSequenceNumberHistogram = "sequence_number_histogram";
 
 }
 
@@ -52,6 +54,26 @@ void LevelDbGlobalsCache::SetSessionToken(const ByteString& session_token) {
   db_->current_transaction()->Put(key, session_token.ToString());
 }
 
+ByteString LevelDbGlobalsCache::GetSequenceNumberHistogram() const {
+  auto key = LevelDbGlobalKey::Key(kSequenceNumberHistogram);
+
+  std::string encoded;
+  auto done = db_->current_transaction()->Get(key, &encoded);
+
+  if (!done.ok()) {
+    return ByteString();
+  }
+
+  return ByteString(encoded);
+}
+
+void LevelDbGlobalsCache::SetSequenceNumberHistogram(
+    const ByteString& histogram) {
+  auto key = LevelDbGlobalKey::Key(kSequenceNumberHistogram);
+  db_->current_transaction()->Put(
+      key, std::string(nanopb::MakeStringView(histogram)));
+}
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
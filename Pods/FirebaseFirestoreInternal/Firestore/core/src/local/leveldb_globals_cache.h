@@ -40,6 +40,16 @@ class LevelDbGlobalsCache : public GlobalsCache {
    */
   void SetSessionToken(const ByteString& session_token) override;
 
+  /**
+   * Gets the encoded sequence number histogram.
+   */
+  ByteString GetSequenceNumberHistogram() const override;
+
+  /**
+   * Sets the encoded sequence number histogram.
+   */
+  void SetSequenceNumberHistogram(const ByteString& histogram) override;
+
  private:
   // The LevelDbGlobalsCache is owned by LevelDbPersistence.
   LevelDbPersistence* db_ = nullptr;
@@ -860,23 +860,24 @@ std::set<IndexEntry> LevelDbIndexManager::ComputeIndexEntries(
 
 absl::optional<std::string> LevelDbIndexManager::EncodeDirectionalElements(
     const FieldIndex& index, const model::Document& document) {
-  IndexEncodingBuffer index_buffer;
+  encoding_buffer_.Reset();
   for (const auto& segment : index.GetDirectionalSegments()) {
     auto field = document->field(segment.field_path());
     if (!field.has_value()) {
       return absl::nullopt;
     }
-    index::WriteIndexValue(field.value(), index_buffer.ForKind(segment.kind()));
+    index::WriteIndexValue(field.value(),
+                           encoding_buffer_.ForKind(segment.kind()));
   }
-  return index_buffer.GetEncodedBytes();
+  return encoding_buffer_.GetEncodedBytes();
 }
 
 std::string LevelDbIndexManager::EncodeSingleElement(
     const _google_firestore_v1_Value& value) {
-  IndexEncodingBuffer index_buffer;
+  encoding_buffer_.Reset();
   index::WriteIndexValue(value,
-                         index_buffer.ForKind(model::Segment::kAscending));
-  return index_buffer.GetEncodedBytes();
+                         encoding_buffer_.ForKind(model::Segment::kAscending));
+  return encoding_buffer_.GetEncodedBytes();
 }
 
 void LevelDbIndexManager::UpdateEntries(
@@ -937,10 +938,10 @@ std::string LevelDbIndexManager::EncodedDirectionalKey(
   auto kind = index.GetDirectionalSegments().empty()
                   ? model::Segment::kAscending
                   : index.GetDirectionalSegments().rbegin()->kind();
-  IndexEncodingBuffer buffer;
+  encoding_buffer_.Reset();
   index::WriteIndexValue(*model::RefValue(serializer_->database_id(), key),
-                         buffer.ForKind(kind));
-  return buffer.GetEncodedBytes();
+                         encoding_buffer_.ForKind(kind));
+  return encoding_buffer_.GetEncodedBytes();
 }
 
 void LevelDbIndexManager::DeleteIndexEntry(const model::Document& document,
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "Firestore/core/src/core/target.h"
+#include "Firestore/core/src/index/index_byte_encoder.h"
 #include "Firestore/core/src/local/index_manager.h"
 #include "Firestore/core/src/local/leveldb_key.h"
 #include "Firestore/core/src/local/memory_index_manager.h"
@@ -250,6 +251,12 @@ class LevelDbIndexManager : public IndexManager {
   bool started_ = false;
 
   std::string uid_;
+
+  /**
+   * Scratch space for encoding index values, reused so that computing index
+   * entries does not reallocate it for every value.
+   */
+  index::IndexEncodingBuffer encoding_buffer_;
 };
 
 }  // namespace local
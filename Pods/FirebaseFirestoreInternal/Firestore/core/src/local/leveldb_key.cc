@@ -42,6 +42,7 @@ const char* kVersionGlobalTable = "version";
 const char* kGlobalsTable = "globals";
 const char* kMutationsTable = "mutation";
 const char* kDocumentMutationsTable = "document_mutation";
+const char* kCollectionMutationsTable = "collection_mutation";
 const char* kMutationQueuesTable = "mutation_queue";
 const char* kTargetGlobalTable = "target_global";
 const char* kTargetsTable = "target";
@@ -66,6 +67,7 @@ const char* kDocumentOverlaysCollectionIndexTable =
 const char* kDocumentOverlaysCollectionGroupIndexTable =
     "document_overlays_collection_group_index";
 const char* kDataMigrationTable = "data_migration";
+const char* kFieldNamesTable = "field_names";
 
 /**
  * Labels for the components of keys. These serve to make keys self-describing.
@@ -165,6 +167,9 @@ enum ComponentLabel {
    */
   GlobalName = 26,
 
+  /** A component containing the ID of a field name in a field name table. */
+  FieldNameId = 27,
+
   /**
    * A path segment describes just a single segment in a resource path. Path
    * segments that occur sequentially in a key represent successive segments in
@@ -283,6 +288,10 @@ class Reader {
     return ReadLabeledString(ComponentLabel::DataMigrationName);
   }
 
+  int32_t ReadFieldNameId() {
+    return ReadLabeledInt32(ComponentLabel::FieldNameId);
+  }
+
   /**
    * Reads a snapshot version, encoded as a component label and a pair of
    * seconds (int64) and nanoseconds (int32).
@@ -697,6 +706,11 @@ std::string Reader::Describe() {
         absl::StrAppend(&description,
                         " data_migration_name=", std::move(value));
       }
+    } else if (label == ComponentLabel::FieldNameId) {
+      int32_t field_name_id = ReadFieldNameId();
+      if (ok_) {
+        absl::StrAppend(&description, " field_name_id=", field_name_id);
+      }
     } else {
       absl::StrAppend(&description, " unknown label=", static_cast<int>(label));
       Fail();
@@ -812,6 +826,10 @@ class Writer {
     WriteLabeledString(ComponentLabel::DataMigrationName, name);
   }
 
+  void WriteFieldNameId(int32_t id) {
+    WriteLabeledInt32(ComponentLabel::FieldNameId, id);
+  }
+
  private:
   /** Writes a component label to the given key destination. */
   void WriteComponentLabel(ComponentLabel label) {
@@ -948,6 +966,52 @@ bool LevelDbDocumentMutationKey::Decode(absl::string_view key) {
   return reader.ok();
 }
 
+std::string LevelDbCollectionMutationKey::KeyPrefix() {
+  Writer writer;
+  writer.WriteTableName(kCollectionMutationsTable);
+  return writer.result();
+}
+
+std::string LevelDbCollectionMutationKey::KeyPrefix(
+    absl::string_view user_id) {
+  Writer writer;
+  writer.WriteTableName(kCollectionMutationsTable);
+  writer.WriteUserId(user_id);
+  return writer.result();
+}
+
+std::string LevelDbCollectionMutationKey::KeyPrefix(
+    absl::string_view user_id, const ResourcePath& collection_path) {
+  Writer writer;
+  writer.WriteTableName(kCollectionMutationsTable);
+  writer.WriteUserId(user_id);
+  writer.WriteResourcePath(collection_path);
+  return writer.result();
+}
+
+std::string LevelDbCollectionMutationKey::Key(
+    absl::string_view user_id,
+    const ResourcePath& collection_path,
+    model::BatchId batch_id) {
+  Writer writer;
+  writer.WriteTableName(kCollectionMutationsTable);
+  writer.WriteUserId(user_id);
+  writer.WriteResourcePath(collection_path);
+  writer.WriteBatchId(batch_id);
+  writer.WriteTerminator();
+  return writer.result();
+}
+
+bool LevelDbCollectionMutationKey::Decode(absl::string_view key) {
+  Reader reader{key};
+  reader.ReadTableNameMatching(kCollectionMutationsTable);
+  user_id_ = reader.ReadUserId();
+  collection_path_ = reader.ReadResourcePath();
+  batch_id_ = reader.ReadBatchId();
+  reader.ReadTerminator();
+  return reader.ok();
+}
+
 std::string LevelDbMutationQueueKey::KeyPrefix() {
   Writer writer;
   writer.WriteTableName(kMutationQueuesTable);
@@ -1654,6 +1718,39 @@ bool LevelDbDataMigrationKey::Decode(absl::string_view key) {
   return reader.ok();
 }
 
+std::string LevelDbFieldNameKey::KeyPrefix() {
+  Writer writer;
+  writer.WriteTableName(kFieldNamesTable);
+  return writer.result();
+}
+
+std::string LevelDbFieldNameKey::KeyPrefix(
+    absl::string_view collection_group) {
+  Writer writer;
+  writer.WriteTableName(kFieldNamesTable);
+  writer.WriteCollectionGroup(collection_group);
+  return writer.result();
+}
+
+std::string LevelDbFieldNameKey::Key(absl::string_view collection_group,
+                                     int32_t field_name_id) {
+  Writer writer;
+  writer.WriteTableName(kFieldNamesTable);
+  writer.WriteCollectionGroup(collection_group);
+  writer.WriteFieldNameId(field_name_id);
+  writer.WriteTerminator();
+  return writer.result();
+}
+
+bool LevelDbFieldNameKey::Decode(absl::string_view key) {
+  Reader reader{key};
+  reader.ReadTableNameMatching(kFieldNamesTable);
+  collection_group_ = reader.ReadCollectionGroup();
+  field_name_id_ = reader.ReadFieldNameId();
+  reader.ReadTerminator();
+  return reader.ok();
+}
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
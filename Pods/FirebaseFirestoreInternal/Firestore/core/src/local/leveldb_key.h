@@ -283,6 +283,75 @@ class LevelDbDocumentMutationKey {
   model::BatchId batch_id_ = model::kBatchIdUnknown;
 };
 
+/**
+ * A key in the collection mutations index, which stores the batches that
+ * mutate documents directly within a collection. Unlike the document mutations
+ * index, the batches of a collection are contiguous and in order, and
+ * mutations to documents in subcollections are kept separate.
+ */
+class LevelDbCollectionMutationKey {
+ public:
+  /**
+   * Creates a key prefix that points just before the first key in the table.
+   */
+  static std::string KeyPrefix();
+
+  /**
+   * Creates a key prefix that points just before the first key for the given
+   * user_id.
+   */
+  static std::string KeyPrefix(absl::string_view user_id);
+
+  /**
+   * Creates a key prefix that points just before the first key for the user_id
+   * and collection path.
+   *
+   * Note that the rows for subcollections of the collection sort after the
+   * rows for the collection itself and share this prefix.
+   */
+  static std::string KeyPrefix(absl::string_view user_id,
+                               const model::ResourcePath& collection_path);
+
+  /**
+   * Creates a complete key that points to a specific user_id, collection path,
+   * and batch_id.
+   */
+  static std::string Key(absl::string_view user_id,
+                         const model::ResourcePath& collection_path,
+                         model::BatchId batch_id);
+
+  /**
+   * Decodes the given complete key, storing the decoded values in this
+   * instance.
+   *
+   * @return true if the key successfully decoded, false otherwise. If false is
+   * returned, this instance is in an undefined state until the next call to
+   * `Decode()`.
+   */
+  ABSL_MUST_USE_RESULT
+  bool Decode(absl::string_view key);
+
+  /** The user that owns the mutation batches. */
+  const std::string& user_id() const {
+    return user_id_;
+  }
+
+  /** The path to the collection, as encoded in the key. */
+  const model::ResourcePath& collection_path() const {
+    return collection_path_;
+  }
+
+  /** The batch_id that mutates documents in the collection. */
+  model::BatchId batch_id() const {
+    return batch_id_;
+  }
+
+ private:
+  std::string user_id_;
+  model::ResourcePath collection_path_;
+  model::BatchId batch_id_ = model::kBatchIdUnknown;
+};
+
 /**
  * A key in the mutation_queues table.
  *
@@ -1375,6 +1444,58 @@ class LevelDbDataMigrationKey {
   std::string migration_name_;
 };
 
+/**
+ * A key in the field_names table, which maps the IDs used for field names in
+ * dictionary-encoded remote documents back to the field names, separately for
+ * each collection group.
+ */
+class LevelDbFieldNameKey {
+ public:
+  /**
+   * Creates a key prefix that points just before the first key in the table.
+   */
+  static std::string KeyPrefix();
+
+  /**
+   * Creates a key prefix that points just before the first key for the given
+   * collection_group.
+   */
+  static std::string KeyPrefix(absl::string_view collection_group);
+
+  /**
+   * Creates a complete key that points to a specific collection_group and
+   * field_name_id.
+   */
+  static std::string Key(absl::string_view collection_group,
+                         int32_t field_name_id);
+
+  /**
+   * Decodes the given complete key, storing the decoded values in this
+   * instance.
+   *
+   * @return true if the key successfully decoded, false otherwise. If false is
+   * returned, this instance is in an undefined state until the next call to
+   * `Decode()`.
+   */
+  ABSL_MUST_USE_RESULT
+  bool Decode(absl::string_view key);
+
+  /** The collection group, as encoded in the key. */
+  const std::string& collection_group() const {
+    return collection_group_;
+  }
+
+  /** The field name ID, as encoded in the key. */
+  int32_t field_name_id() const {
+    return field_name_id_;
+  }
+
+ private:
+  // Deliberately uninitialized: will be assigned in Decode
+  std::string collection_group_;
+  int32_t field_name_id_;
+};
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
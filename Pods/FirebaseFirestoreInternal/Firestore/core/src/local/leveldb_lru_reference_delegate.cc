@@ -16,10 +16,12 @@
 
 #include "Firestore/core/src/local/leveldb_lru_reference_delegate.h"
 
+#include <chrono>
 #include <set>
 #include <string>
 #include <utility>
 
+#include "Firestore/core/src/local/leveldb_globals_cache.h"
 #include "Firestore/core/src/local/leveldb_key.h"
 #include "Firestore/core/src/local/leveldb_persistence.h"
 #include "Firestore/core/src/local/listen_sequence.h"
@@ -27,6 +29,7 @@
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/resource_path.h"
 #include "Firestore/core/src/model/types.h"
+#include "Firestore/core/src/nanopb/nanopb_util.h"
 #include "Firestore/core/src/util/statusor.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/match.h"
@@ -38,6 +41,8 @@ namespace local {
 using model::DocumentKey;
 using model::ListenSequenceNumber;
 using model::ResourcePath;
+using nanopb::ByteString;
+using nanopb::MakeStringView;
 using util::StatusOr;
 
 LevelDbLruReferenceDelegate::LevelDbLruReferenceDelegate(
@@ -99,6 +104,9 @@ void LevelDbLruReferenceDelegate::OnTransactionStarted(absl::string_view) {
 }
 
 void LevelDbLruReferenceDelegate::OnTransactionCommitted() {
+  // This is called before the underlying transaction is committed, so the
+  // histogram is saved atomically with the rows it describes.
+  UpdateHistogram();
   current_sequence_number_ = kListenSequenceNumberInvalid;
 }
 
@@ -112,6 +120,11 @@ StatusOr<int64_t> LevelDbLruReferenceDelegate::CalculateByteSize() {
 
 size_t LevelDbLruReferenceDelegate::GetSequenceNumberCount() {
   size_t total_count = db_->target_cache()->size();
+  if (const SequenceNumberHistogram* histogram =
+          GetOrphanedDocumentHistogram()) {
+    return total_count + static_cast<size_t>(histogram->total_count());
+  }
+
   EnumerateOrphanedDocuments(
       [&total_count](const DocumentKey&, ListenSequenceNumber) {
         total_count++;
@@ -129,10 +142,29 @@ void LevelDbLruReferenceDelegate::EnumerateOrphanedDocuments(
   db_->target_cache()->EnumerateOrphanedDocuments(callback);
 }
 
+void LevelDbLruReferenceDelegate::EnumerateOrphanedDocumentsUntil(
+    absl::optional<DocumentKey>* resume_key,
+    const OrphanedDocumentCallback& callback,
+    LruDeadline deadline) {
+  *resume_key = db_->target_cache()->EnumerateOrphanedDocuments(
+      *resume_key, callback,
+      [deadline] { return std::chrono::steady_clock::now() >= deadline; });
+}
+
 int LevelDbLruReferenceDelegate::RemoveOrphanedDocuments(
     ListenSequenceNumber upper_bound) {
+  absl::optional<DocumentKey> resume_key;
+  return RemoveOrphanedDocumentsUntil(upper_bound, &resume_key,
+                                      LruDeadline::max());
+}
+
+int LevelDbLruReferenceDelegate::RemoveOrphanedDocumentsUntil(
+    ListenSequenceNumber upper_bound,
+    absl::optional<DocumentKey>* resume_key,
+    LruDeadline deadline) {
   int count = 0;
-  db_->target_cache()->EnumerateOrphanedDocuments(
+  *resume_key = db_->target_cache()->EnumerateOrphanedDocuments(
+      *resume_key,
       [&](const DocumentKey& key, ListenSequenceNumber sequence_number) {
         if (sequence_number <= upper_bound) {
           if (!IsPinned(key)) {
@@ -141,7 +173,8 @@ int LevelDbLruReferenceDelegate::RemoveOrphanedDocuments(
             RemoveSentinel(key);
           }
         }
-      });
+      },
+      [deadline] { return std::chrono::steady_clock::now() >= deadline; });
   return count;
 }
 
@@ -151,6 +184,97 @@ int LevelDbLruReferenceDelegate::RemoveTargets(
       db_->target_cache()->RemoveTargets(sequence_number, live_queries));
 }
 
+const SequenceNumberHistogram*
+LevelDbLruReferenceDelegate::GetOrphanedDocumentHistogram() {
+  EnsureHistogramLoaded();
+  return histogram_complete_ ? &*histogram_ : nullptr;
+}
+
+bool LevelDbLruReferenceDelegate::BuildOrphanedDocumentHistogramUntil(
+    LruDeadline deadline) {
+  EnsureHistogramLoaded();
+  if (histogram_complete_) {
+    return true;
+  }
+
+  // Documents tracked earlier in this transaction would be counted twice if
+  // the histogram grew past them now.
+  HARD_ASSERT(tracked_documents_.empty(),
+              "The histogram must be built before the transaction changes "
+              "any document");
+  histogram_resume_key_ = db_->target_cache()->EnumerateOrphanedDocuments(
+      histogram_resume_key_,
+      [this](const DocumentKey&, ListenSequenceNumber sequence_number) {
+        histogram_->Add(sequence_number);
+      },
+      [deadline] { return std::chrono::steady_clock::now() >= deadline; });
+  if (histogram_resume_key_) {
+    return false;
+  }
+
+  histogram_complete_ = true;
+  histogram_dirty_ = true;
+  return true;
+}
+
+void LevelDbLruReferenceDelegate::TrackOrphanedDocument(
+    const DocumentKey& key) {
+  EnsureHistogramLoaded();
+  if (!HistogramCounts(key) ||
+      tracked_documents_.find(key) != tracked_documents_.end()) {
+    return;
+  }
+  tracked_documents_.emplace(
+      key, db_->target_cache()->GetOrphanedSequenceNumber(key));
+}
+
+void LevelDbLruReferenceDelegate::EnsureHistogramLoaded() {
+  if (histogram_) {
+    return;
+  }
+
+  ByteString encoded = db_->globals_cache()->GetSequenceNumberHistogram();
+  if (!encoded.empty()) {
+    histogram_ = SequenceNumberHistogram::Decode(MakeStringView(encoded));
+  }
+  histogram_complete_ = histogram_.has_value();
+  if (!histogram_complete_) {
+    histogram_ = SequenceNumberHistogram();
+  }
+}
+
+bool LevelDbLruReferenceDelegate::HistogramCounts(
+    const DocumentKey& key) const {
+  return histogram_complete_ ||
+         (histogram_resume_key_ && key < *histogram_resume_key_);
+}
+
+void LevelDbLruReferenceDelegate::UpdateHistogram() {
+  for (const auto& tracked : tracked_documents_) {
+    const absl::optional<ListenSequenceNumber>& before = tracked.second;
+    absl::optional<ListenSequenceNumber> after =
+        db_->target_cache()->GetOrphanedSequenceNumber(tracked.first);
+    if (before == after) {
+      continue;
+    }
+
+    if (before) {
+      histogram_->Remove(*before);
+    }
+    if (after) {
+      histogram_->Add(*after);
+    }
+    histogram_dirty_ = true;
+  }
+  tracked_documents_.clear();
+
+  if (histogram_dirty_ && histogram_complete_) {
+    db_->globals_cache()->SetSequenceNumberHistogram(
+        ByteString(histogram_->Encode()));
+    histogram_dirty_ = false;
+  }
+}
+
 bool LevelDbLruReferenceDelegate::IsPinned(const DocumentKey& key) {
   if (additional_references_->ContainsKey(key)) {
     return true;
@@ -178,11 +302,13 @@ bool LevelDbLruReferenceDelegate::MutationQueuesContainKey(
 }
 
 void LevelDbLruReferenceDelegate::RemoveSentinel(const DocumentKey& key) {
+  TrackOrphanedDocument(key);
   db_->current_transaction()->Delete(
       LevelDbDocumentTargetKey::SentinelKey(key));
 }
 
 void LevelDbLruReferenceDelegate::WriteSentinel(const DocumentKey& key) {
+  TrackOrphanedDocument(key);
   std::string sentinel_key = LevelDbDocumentTargetKey::SentinelKey(key);
   std::string encoded_sequence_number =
       LevelDbDocumentTargetKey::EncodeSentinelValue(current_sequence_number());
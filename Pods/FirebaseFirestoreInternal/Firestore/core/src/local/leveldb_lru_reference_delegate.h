@@ -18,8 +18,12 @@
 #define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_LRU_REFERENCE_DELEGATE_H_
 
 #include <memory>
+#include <unordered_map>
 
 #include "Firestore/core/src/local/lru_garbage_collector.h"
+#include "Firestore/core/src/local/sequence_number_histogram.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "absl/types/optional.h"
 
 namespace firebase {
 namespace firestore {
@@ -64,11 +68,31 @@ class LevelDbLruReferenceDelegate : public LruDelegate {
       const SequenceNumberCallback& callback) override;
   void EnumerateOrphanedDocuments(
       const OrphanedDocumentCallback& callback) override;
+  void EnumerateOrphanedDocumentsUntil(
+      absl::optional<model::DocumentKey>* resume_key,
+      const OrphanedDocumentCallback& callback,
+      LruDeadline deadline) override;
 
   int RemoveOrphanedDocuments(model::ListenSequenceNumber upper_bound) override;
+  int RemoveOrphanedDocumentsUntil(
+      model::ListenSequenceNumber upper_bound,
+      absl::optional<model::DocumentKey>* resume_key,
+      LruDeadline deadline) override;
   int RemoveTargets(model::ListenSequenceNumber sequence_number,
                     const LiveQueryMap& live_queries) override;
 
+  const SequenceNumberHistogram* GetOrphanedDocumentHistogram() override;
+  bool BuildOrphanedDocumentHistogramUntil(LruDeadline deadline) override;
+
+  // Non-interface methods
+
+  /**
+   * Remembers whether the document with `key` is orphaned before the current
+   * transaction changes its sentinel or target rows, so that the histogram of
+   * orphaned documents can be updated when the transaction commits.
+   */
+  void TrackOrphanedDocument(const model::DocumentKey& key);
+
  private:
   bool IsPinned(const model::DocumentKey& key);
 
@@ -77,6 +101,21 @@ class LevelDbLruReferenceDelegate : public LruDelegate {
   void RemoveSentinel(const model::DocumentKey& key);
   void WriteSentinel(const model::DocumentKey& key);
 
+  /**
+   * Loads the persisted histogram of orphaned documents from the globals cache
+   * the first time it's needed, or starts building it if none was saved.
+   */
+  void EnsureHistogramLoaded();
+
+  /** Whether the histogram counts the document with `key`. */
+  bool HistogramCounts(const model::DocumentKey& key) const;
+
+  /**
+   * Applies the changes to the orphaned documents tracked in the current
+   * transaction to the histogram, and saves it if it changed.
+   */
+  void UpdateHistogram();
+
   std::unique_ptr<LruGarbageCollector> gc_;
 
   // Persistence instances are owned by FirestoreClient
@@ -93,6 +132,22 @@ class LevelDbLruReferenceDelegate : public LruDelegate {
   // transaction is active, resets back to kListenSequenceNumberInvalid.
   model::ListenSequenceNumber current_sequence_number_ =
       kListenSequenceNumberInvalid;
+
+  // The histogram of the sequence numbers of all orphaned documents, saved in
+  // the globals cache. Caches that predate it build it in slices: until
+  // `histogram_complete_`, it only counts the documents before
+  // `histogram_resume_key_`.
+  absl::optional<SequenceNumberHistogram> histogram_;
+  bool histogram_complete_ = false;
+  absl::optional<model::DocumentKey> histogram_resume_key_;
+  bool histogram_dirty_ = false;
+
+  // The sequence numbers of the documents tracked in the current transaction
+  // as of before their first change, or empty if they weren't orphaned.
+  std::unordered_map<model::DocumentKey,
+                     absl::optional<model::ListenSequenceNumber>,
+                     model::DocumentKeyHash>
+      tracked_documents_;
 };
 
 }  // namespace local
@@ -16,22 +16,29 @@
 
 #include "Firestore/core/src/local/leveldb_migrations.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "Firestore/Protos/nanopb/firestore/local/maybe_document.nanopb.h"
 #include "Firestore/Protos/nanopb/firestore/local/mutation.nanopb.h"
 #include "Firestore/Protos/nanopb/firestore/local/target.nanopb.h"
+#include "Firestore/core/src/local/leveldb_field_name_dictionary.h"
 #include "Firestore/core/src/local/leveldb_key.h"
 #include "Firestore/core/src/local/memory_index_manager.h"
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/model/mutable_document.h"
 #include "Firestore/core/src/model/types.h"
 #include "Firestore/core/src/nanopb/message.h"
 #include "Firestore/core/src/nanopb/reader.h"
 #include "Firestore/core/src/nanopb/writer.h"
 #include "Firestore/core/src/util/log.h"
 #include "Firestore/core/src/util/statusor.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/match.h"
+#include "absl/strings/strip.h"
 
 namespace firebase {
 namespace firestore {
@@ -40,6 +47,7 @@ namespace {
 
 using leveldb::Status;
 using model::DocumentKey;
+using model::MutableDocument;
 using model::ResourcePath;
 using nanopb::Message;
 using nanopb::StringReader;
@@ -370,6 +378,51 @@ void EnsureOverlayDataMigrationIsRequired(leveldb::DB* db) {
   transaction.Commit();
 }
 
+/**
+ * Migration 9.
+ *
+ * Adds the field_names table. Documents are only dictionary-encoded once the
+ * encoding is enabled, so there is nothing to rewrite.
+ */
+void AddFieldNameDictionary(leveldb::DB* db) {
+  LevelDbTransaction transaction(db, "Add field name dictionary");
+  SaveVersion(9, &transaction);
+  transaction.Commit();
+}
+
+/**
+ * Migration 10.
+ *
+ * Builds the collection_mutation index from the document_mutation index.
+ */
+void EnsureCollectionMutationsIndex(leveldb::DB* db) {
+  // Clients that predate the index may have run since it was last built (see
+  // the downgrade handling in `RunMigrations`) and left rows for batches they
+  // removed, so the index is always rebuilt from scratch.
+  DeleteEverythingWithPrefix(LevelDbCollectionMutationKey::KeyPrefix(), db);
+
+  LevelDbTransaction transaction(db, "Ensure Collection Mutations Index");
+
+  std::string mutations_prefix = LevelDbDocumentMutationKey::KeyPrefix();
+  auto it = transaction.NewIterator();
+  it->Seek(mutations_prefix);
+  LevelDbDocumentMutationKey key;
+  std::string empty_buffer;
+  for (; it->Valid() && absl::StartsWith(it->key(), mutations_prefix);
+       it->Next()) {
+    HARD_ASSERT(key.Decode(it->key()),
+                "Failed to decode document-mutation key");
+
+    transaction.Put(LevelDbCollectionMutationKey::Key(
+                        key.user_id(), key.document_key().path().PopLast(),
+                        key.batch_id()),
+                    empty_buffer);
+  }
+
+  SaveVersion(10, &transaction);
+  transaction.Commit();
+}
+
 }  // namespace
 
 LevelDbMigrations::SchemaVersion LevelDbMigrations::ReadSchemaVersion(
@@ -401,6 +454,11 @@ void LevelDbMigrations::RunMigrations(leveldb::DB* db,
   // detect it when we go to upgrade again, allowing us to rerun the
   // data migrations.
   if (from_version > to_version) {
+    // Versions before 9 can't read dictionary-encoded documents.
+    if (from_version >= 9 && to_version < 9) {
+      RemoveFieldNameDictionaryEncoding(db, serializer);
+    }
+
     LevelDbTransaction transaction(db, "Save downgrade version");
     SaveVersion(to_version, &transaction);
     transaction.Commit();
@@ -433,6 +491,81 @@ void LevelDbMigrations::RunMigrations(leveldb::DB* db,
   if (from_version < 8 && to_version >= 8) {
     EnsureOverlayDataMigrationIsRequired(db);
   }
+
+  if (from_version < 9 && to_version >= 9) {
+    AddFieldNameDictionary(db);
+  }
+
+  if (from_version < 10 && to_version >= 10) {
+    EnsureCollectionMutationsIndex(db);
+  }
+}
+
+void LevelDbMigrations::RemoveFieldNameDictionaryEncoding(
+    leveldb::DB* db, const LocalSerializer& serializer) {
+  std::string field_names_prefix = LevelDbFieldNameKey::KeyPrefix();
+  {
+    LevelDbTransaction transaction(db, "Check field name dictionary");
+    auto it = transaction.NewIterator();
+    it->Seek(field_names_prefix);
+    if (!it->Valid() || !absl::StartsWith(it->key(), field_names_prefix)) {
+      return;
+    }
+  }
+
+  std::string documents_prefix = LevelDbRemoteDocumentKey::KeyPrefix();
+  std::string start_key = documents_prefix;
+  bool more_documents = true;
+  while (more_documents) {
+    LevelDbTransaction transaction(db, "Remove field name dictionary encoding");
+    absl::flat_hash_map<std::string,
+                        std::unique_ptr<LevelDbFieldNameDictionary>>
+        dictionaries;
+    auto it = transaction.NewIterator();
+    LevelDbRemoteDocumentKey document_key;
+
+    more_documents = false;
+    for (it->Seek(start_key);
+         it->Valid() && absl::StartsWith(it->key(), documents_prefix);
+         it->Next()) {
+      if (transaction.changed_keys() >= 1000) {
+        start_key = it->key();
+        more_documents = true;
+        break;
+      }
+
+      absl::string_view encoded = it->value();
+      if (!absl::ConsumePrefix(&encoded, kFieldNameDictionaryPrefix)) {
+        continue;
+      }
+
+      HARD_ASSERT(document_key.Decode(it->key()),
+                  "Failed to decode remote document key");
+      std::string collection_group =
+          *document_key.document_key().GetCollectionGroup();
+      std::unique_ptr<LevelDbFieldNameDictionary>& dictionary =
+          dictionaries[collection_group];
+      if (!dictionary) {
+        dictionary = absl::make_unique<LevelDbFieldNameDictionary>(
+            &transaction, std::move(collection_group));
+      }
+
+      StringReader reader{encoded};
+      auto message = Message<firestore_client_MaybeDocument>::TryParse(&reader);
+      MutableDocument document =
+          serializer.DecodeMaybeDocument(&reader, *message, *dictionary);
+      HARD_ASSERT(reader.ok(), "MaybeDocument proto failed to parse: %s",
+                  reader.status().ToString());
+
+      std::string key = it->key();
+      transaction.Put(key, serializer.EncodeMaybeDocument(document));
+    }
+
+    transaction.Commit();
+  }
+
+  // Only drop the dictionary once no document refers to it any more.
+  DeleteEverythingWithPrefix(field_names_prefix, db);
 }
 
 }  // namespace local
@@ -49,6 +49,15 @@ class LevelDbMigrations {
   static void RunMigrations(leveldb::DB* db,
                             SchemaVersion version,
                             const LocalSerializer& serializer);
+
+  /**
+   * Rewrites every remote document stored with dictionary-encoded field names
+   * as a plain document and drops the field_names table, leaving the database
+   * readable by versions that predate schema version 9. Does nothing if the
+   * table is empty.
+   */
+  static void RemoveFieldNameDictionaryEncoding(
+      leveldb::DB* db, const LocalSerializer& serializer);
 };
 
 /**
@@ -73,8 +82,13 @@ class LevelDbMigrations {
  *   * Migration 6 populates the collection_parents index.
  *   * Migration 7 rewrites query_targets canonical ids in new format.
  *   * Migration 8 kicks off overlay data migration.
+ *   * Migration 9 adds the field_names table, which lets remote documents be
+ *     stored with dictionary-encoded field names. The table starts out empty,
+ *     so the migration only records the version. Downgrading below 9 rewrites
+ *     such documents as plain ones (see `RemoveFieldNameDictionaryEncoding`).
+ *   * Migration 10 populates the collection_mutation index.
  */
-const LevelDbMigrations::SchemaVersion kSchemaVersion = 8;
+const LevelDbMigrations::SchemaVersion kSchemaVersion = 10;
 
 }  // namespace local
 }  // namespace firestore
@@ -16,6 +16,7 @@
 
 #include "Firestore/core/src/local/leveldb_mutation_queue.h"
 
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -179,9 +180,17 @@ MutationBatch LevelDbMutationQueue::AddMutationBatch(
     key = LevelDbDocumentMutationKey::Key(user_id_, mutation.key(), batch_id);
     db_->current_transaction()->Put(key, empty_buffer);
 
-    index_manager_->AddToCollectionParentIndex(mutation.key().path().PopLast());
+    // Batches that touch several documents of a collection write the same row
+    // repeatedly, which the transaction collapses into a single write.
+    ResourcePath collection_path = mutation.key().path().PopLast();
+    key = LevelDbCollectionMutationKey::Key(user_id_, collection_path,
+                                            batch_id);
+    db_->current_transaction()->Put(key, empty_buffer);
+
+    index_manager_->AddToCollectionParentIndex(collection_path);
   }
 
+  CacheMutationBatch(batch);
   return batch;
 }
 
@@ -206,8 +215,13 @@ void LevelDbMutationQueue::RemoveMutationBatch(const MutationBatch& batch) {
   for (const Mutation& mutation : batch.mutations()) {
     key = LevelDbDocumentMutationKey::Key(user_id_, mutation.key(), batch_id);
     db_->current_transaction()->Delete(key);
+    key = LevelDbCollectionMutationKey::Key(
+        user_id_, mutation.key().path().PopLast(), batch_id);
+    db_->current_transaction()->Delete(key);
     db_->reference_delegate()->RemoveMutationReference(mutation.key());
   }
+
+  batches_.erase(batch_id);
 }
 
 std::vector<MutationBatch> LevelDbMutationQueue::AllMutationBatches() {
@@ -216,8 +230,11 @@ std::vector<MutationBatch> LevelDbMutationQueue::AllMutationBatches() {
   auto it = db_->current_transaction()->NewIterator();
   it->Seek(user_key);
   std::vector<MutationBatch> result;
+  LevelDbMutationKey row_key;
   for (; it->Valid() && absl::StartsWith(it->key(), user_key); it->Next()) {
-    result.push_back(ParseMutationBatch(it->value()));
+    HARD_ASSERT(row_key.Decode(it->key()), "Failed to decode mutation key %s",
+                DescribeKey(it));
+    result.push_back(CacheMutationBatch(row_key.batch_id(), it->value()));
   }
   return result;
 }
@@ -258,7 +275,8 @@ LevelDbMutationQueue::AllMutationBatchesAffectingDocumentKeys(
     }
   }
 
-  return AllMutationBatchesWithIds(batch_ids);
+  return AllMutationBatchesWithIds(
+      std::vector<BatchId>(batch_ids.begin(), batch_ids.end()));
 }
 
 std::vector<MutationBatch>
@@ -275,65 +293,42 @@ LevelDbMutationQueue::AllMutationBatchesAffectingQuery(const Query& query) {
       !query.IsCollectionGroupQuery(),
       "CollectionGroup queries should be handled in LocalDocumentsView");
 
-  const ResourcePath& query_path = query.path();
-  size_t immediate_children_path_length = query_path.size() + 1;
-
-  // TODO(mcg): Actually implement a single-collection query
-  //
-  // This is actually executing an ancestor query, traversing the whole subtree
-  // below the collection which can be horrifically inefficient for some
-  // structures. The right way to solve this is to implement the full value
-  // index, but that's not in the cards in the near future so this is the best
-  // we can do for the moment.
-  //
   // Since we don't yet index the actual properties in the mutations, our
   // current approach is to just return all mutation batches that affect
   // documents in the collection being queried.
   //
-  // Unlike AllMutationBatchesAffectingDocumentKey, this iteration will scan the
-  // document-mutation index for more than a single document so the associated
-  // batch_ids will be neither necessarily unique nor in order. This means an
-  // efficient simultaneous scan isn't possible.
+  // The collection-mutation index lists the batches for the documents directly
+  // within the collection in batch_id order, ahead of the rows for any of its
+  // subcollections, so a single range scan yields exactly the batch_ids that
+  // are needed, already sorted and free of duplicates.
+  const ResourcePath& query_path = query.path();
   std::string index_prefix =
-      LevelDbDocumentMutationKey::KeyPrefix(user_id_, query_path);
+      LevelDbCollectionMutationKey::KeyPrefix(user_id_, query_path);
   auto index_iterator = db_->current_transaction()->NewIterator();
   index_iterator->Seek(index_prefix);
 
-  LevelDbDocumentMutationKey row_key;
-
-  // Collect up unique batch_ids encountered during a scan of the index. Use a
-  // set<BatchId> to accumulate the IDs so they can be traversed in order in a
-  // scan of the main table.
-  //
-  // This method is faster than performing lookups of the keys with _db->Get and
-  // keeping a hash of batch_ids that have already been looked up. The
-  // performance difference is minor for small numbers of keys but > 30% faster
-  // for larger numbers of keys.
-  std::set<BatchId> unique_batch_ids;
+  LevelDbCollectionMutationKey row_key;
+  std::vector<BatchId> batch_ids;
   for (; index_iterator->Valid(); index_iterator->Next()) {
     if (!absl::StartsWith(index_iterator->key(), index_prefix) ||
-        !row_key.Decode(index_iterator->key())) {
+        !row_key.Decode(index_iterator->key()) ||
+        row_key.collection_path() != query_path) {
       break;
     }
 
-    // Rows with document keys more than one segment longer than the query path
-    // can't be matches. For example, a query on 'rooms' can't match the
-    // document /rooms/abc/messages/xyx.
-    // TODO(mcg): we'll need a different scanner when we implement ancestor
-    // queries.
-    if (row_key.document_key().path().size() !=
-        immediate_children_path_length) {
-      continue;
-    }
-
-    unique_batch_ids.insert(row_key.batch_id());
+    batch_ids.push_back(row_key.batch_id());
   }
 
-  return AllMutationBatchesWithIds(unique_batch_ids);
+  return AllMutationBatchesWithIds(batch_ids);
 }
 
 absl::optional<MutationBatch> LevelDbMutationQueue::LookupMutationBatch(
     model::BatchId batch_id) {
+  auto cached = batches_.find(batch_id);
+  if (cached != batches_.end()) {
+    return cached->second;
+  }
+
   std::string key = mutation_batch_key(batch_id);
 
   std::string value;
@@ -346,7 +341,7 @@ absl::optional<MutationBatch> LevelDbMutationQueue::LookupMutationBatch(
               batch_id, status.ToString());
   }
 
-  return ParseMutationBatch(value);
+  return CacheMutationBatch(batch_id, value);
 }
 
 absl::optional<MutationBatch>
@@ -370,7 +365,7 @@ LevelDbMutationQueue::NextMutationBatchAfterBatchId(model::BatchId batch_id) {
 
   HARD_ASSERT(row_key.batch_id() >= next_batch_id,
               "Should have found mutation after %s", next_batch_id);
-  return ParseMutationBatch(it->value());
+  return CacheMutationBatch(row_key.batch_id(), it->value());
 }
 
 BatchId LevelDbMutationQueue::GetHighestUnacknowledgedBatchId() {
@@ -432,13 +427,23 @@ void LevelDbMutationQueue::SetLastStreamToken(ByteString stream_token) {
 }
 
 std::vector<MutationBatch> LevelDbMutationQueue::AllMutationBatchesWithIds(
-    const std::set<BatchId>& batch_ids) {
+    const std::vector<BatchId>& batch_ids) {
   std::vector<MutationBatch> result;
+  result.reserve(batch_ids.size());
 
   // Given an ordered set of unique batch_ids perform a skipping scan over the
-  // main table to find the mutation batches.
-  auto mutation_iterator = db_->current_transaction()->NewIterator();
+  // main table to find the mutation batches that haven't been parsed yet.
+  std::unique_ptr<LevelDbTransaction::Iterator> mutation_iterator;
   for (BatchId batch_id : batch_ids) {
+    auto cached = batches_.find(batch_id);
+    if (cached != batches_.end()) {
+      result.push_back(cached->second);
+      continue;
+    }
+
+    if (!mutation_iterator) {
+      mutation_iterator = db_->current_transaction()->NewIterator();
+    }
     std::string mutation_key = mutation_batch_key(batch_id);
     mutation_iterator->Seek(mutation_key);
     if (!mutation_iterator->Valid() ||
@@ -449,12 +454,15 @@ std::vector<MutationBatch> LevelDbMutationQueue::AllMutationBatchesWithIds(
           DescribeKey(mutation_key), DescribeKey(mutation_iterator));
     }
 
-    result.push_back(ParseMutationBatch(mutation_iterator->value()));
+    result.push_back(
+        CacheMutationBatch(batch_id, mutation_iterator->value()));
   }
 
   return result;
 }
 
+constexpr size_t LevelDbMutationQueue::kMaxCachedBatches;
+
 std::string LevelDbMutationQueue::mutation_queue_key() const {
   return LevelDbMutationQueueKey::Key(user_id_);
 }
@@ -498,6 +506,25 @@ MutationBatch LevelDbMutationQueue::ParseMutationBatch(
   return result;
 }
 
+MutationBatch LevelDbMutationQueue::CacheMutationBatch(
+    BatchId batch_id, absl::string_view encoded) {
+  auto found = batches_.find(batch_id);
+  if (found != batches_.end()) {
+    return found->second;
+  }
+
+  MutationBatch batch = ParseMutationBatch(encoded);
+  CacheMutationBatch(batch);
+  return batch;
+}
+
+void LevelDbMutationQueue::CacheMutationBatch(const MutationBatch& batch) {
+  batches_.emplace(batch.batch_id(), batch);
+  if (batches_.size() > kMaxCachedBatches) {
+    batches_.erase(std::prev(batches_.end()));
+  }
+}
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
@@ -17,6 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_LEVELDB_MUTATION_QUEUE_H_
 #define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_MUTATION_QUEUE_H_
 
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -97,12 +98,23 @@ class LevelDbMutationQueue : public MutationQueue {
   void SetLastStreamToken(nanopb::ByteString stream_token) override;
 
  private:
+  friend class LevelDbMutationQueueTest;
+
+  /**
+   * The maximum number of parsed batches kept in `batches_`. A queue only
+   * grows this long while the client is offline, and reading or adding
+   * batches beyond the limit falls back to parsing them on every access.
+   */
+  static constexpr size_t kMaxCachedBatches = 100;
+
   /**
    * Constructs a vector of matching batches, sorted by batch_id to ensure that
    * multiple mutations affecting the same document key are applied in order.
+   *
+   * @param batch_ids The IDs of the batches, sorted and without duplicates.
    */
   std::vector<model::MutationBatch> AllMutationBatchesWithIds(
-      const std::set<model::BatchId>& batch_ids);
+      const std::vector<model::BatchId>& batch_ids);
 
   std::string mutation_queue_key() const;
 
@@ -114,6 +126,19 @@ class LevelDbMutationQueue : public MutationQueue {
 
   model::MutationBatch ParseMutationBatch(absl::string_view encoded);
 
+  /**
+   * Returns the batch with the given ID, which is parsed from `encoded` unless
+   * it is already in `batches_`.
+   */
+  model::MutationBatch CacheMutationBatch(model::BatchId batch_id,
+                                          absl::string_view encoded);
+
+  /**
+   * Adds `batch` to `batches_`, evicting the batch with the highest ID if
+   * that takes the cache past `kMaxCachedBatches`.
+   */
+  void CacheMutationBatch(const model::MutationBatch& batch);
+
   // The LevelDbMutationQueue instance is owned by LevelDbPersistence.
   LevelDbPersistence* db_;
   IndexManager* index_manager_;
@@ -140,6 +165,17 @@ class LevelDbMutationQueue : public MutationQueue {
    * A write-through cache copy of the metadata describing the current queue.
    */
   nanopb::Message<firestore_client_MutationQueue> metadata_;
+
+  /**
+   * Parsed copies of batches in the queue that have been added or read since
+   * the queue was started. Only this queue writes the mutations of its user,
+   * so entries only need to be dropped when their batch is removed.
+   *
+   * When full, the cache keeps the batches with the lowest IDs: batches are
+   * acknowledged and removed from the front of the queue, and every local
+   * view of a document applies its oldest batches too.
+   */
+  std::map<model::BatchId, model::MutationBatch> batches_;
 };
 
 }  // namespace local
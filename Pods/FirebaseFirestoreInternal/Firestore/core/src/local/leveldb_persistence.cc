@@ -137,6 +137,14 @@ LevelDbPersistence::LevelDbPersistence(std::unique_ptr<leveldb::DB> db,
 // Handle unique_ptrs to forward declarations
 LevelDbPersistence::~LevelDbPersistence() = default;
 
+void LevelDbPersistence::SetFieldNameDictionaryEnabled(bool enabled) {
+  if (!enabled) {
+    LevelDbMigrations::RemoveFieldNameDictionaryEncoding(db_.get(),
+                                                         serializer_);
+  }
+  document_cache_->SetFieldNameDictionaryEnabled(enabled);
+}
+
 // MARK: - Startup
 
 Status LevelDbPersistence::EnsureDirectory(const Path& dir) {
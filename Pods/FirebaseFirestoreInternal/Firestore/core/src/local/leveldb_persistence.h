@@ -77,6 +77,16 @@ class LevelDbPersistence : public Persistence {
 
   util::StatusOr<int64_t> CalculateByteSize();
 
+  /**
+   * Sets whether remote documents are stored with dictionary-encoded field
+   * names (see `LevelDbRemoteDocumentCache::SetFieldNameDictionaryEnabled`).
+   * Turning the encoding off rewrites any documents stored that way, so that
+   * the cache can be opened again by SDK versions that predate the encoding.
+   *
+   * Must be called before the persistence is used.
+   */
+  void SetFieldNameDictionaryEnabled(bool enabled);
+
   // MARK: Persistence overrides
 
   model::ListenSequenceNumber current_sequence_number() const override;
@@ -16,12 +16,16 @@
 
 #include "Firestore/core/src/local/leveldb_remote_document_cache.h"
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "Firestore/Protos/nanopb/firestore/local/maybe_document.nanopb.h"
 #include "Firestore/core/src/core/query.h"
+#include "Firestore/core/src/local/leveldb_field_name_dictionary.h"
 #include "Firestore/core/src/local/leveldb_key.h"
 #include "Firestore/core/src/local/leveldb_persistence.h"
 #include "Firestore/core/src/local/local_serializer.h"
@@ -36,6 +40,8 @@
 #include "Firestore/core/src/util/executor.h"
 #include "Firestore/core/src/util/status.h"
 #include "Firestore/core/src/util/string_util.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/strip.h"
 #include "leveldb/db.h"
 
 namespace firebase {
@@ -57,6 +63,12 @@ using nanopb::StringReader;
 using util::BackgroundQueue;
 using util::Executor;
 
+/**
+ * The fewest documents worth handing to a separate task when scanning a
+ * collection. Smaller slices cost more in scheduling than they save.
+ */
+constexpr size_t kMinDocumentsPerSlice = 32;
+
 /**
  * An accumulator for results produced asynchronously. This accumulates
  * values in a vector to avoid contention caused by accumulating into more
@@ -99,6 +111,7 @@ LevelDbRemoteDocumentCache::LevelDbRemoteDocumentCache(
     // If the standard library doesn't know, guess something reasonable.
     hw_concurrency = 4;
   }
+  concurrency_ = hw_concurrency;
   executor_ = Executor::CreateConcurrent("com.google.firebase.firestore.query",
                                          static_cast<int>(hw_concurrency));
 }
@@ -112,8 +125,16 @@ void LevelDbRemoteDocumentCache::Add(const MutableDocument& document,
   const ResourcePath& path = key.path();
 
   std::string ldb_document_key = LevelDbRemoteDocumentKey::Key(key);
-  db_->current_transaction()->Put(ldb_document_key,
-                                  serializer_->EncodeMaybeDocument(document));
+  if (field_name_dictionary_enabled_ && document.is_found_document() &&
+      document.data().Get().map_value.fields_count > 0) {
+    db_->current_transaction()->Put(
+        ldb_document_key, kFieldNameDictionaryPrefix,
+        serializer_->EncodeMaybeDocument(document,
+                                         GetFieldNameDictionary(key)));
+  } else {
+    db_->current_transaction()->Put(ldb_document_key,
+                                    serializer_->EncodeMaybeDocument(document));
+  }
 
   std::string ldb_read_time_key = LevelDbRemoteDocumentReadTimeKey::Key(
       path.PopLast(), read_time, path.last_segment());
@@ -177,26 +198,54 @@ MutableDocumentMap LevelDbRemoteDocumentCache::GetAllExisting(
     DocumentVersionMap&& remote_map,
     const core::Query& query,
     const model::OverlayByDocumentKeyMap& mutated_docs) const {
+  std::vector<std::pair<DocumentKey, SnapshotVersion>> candidates(
+      std::make_move_iterator(remote_map.begin()),
+      std::make_move_iterator(remote_map.end()));
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<DocumentKey, SnapshotVersion>& lhs,
+               const std::pair<DocumentKey, SnapshotVersion>& rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  // Split the candidates into contiguous slices of the key range, one per
+  // worker, so that each task reads, decodes and filters its slice into its
+  // own vector. Concatenating the slices then yields the results in key
+  // order without any locking or sorting.
+  size_t slice_count = std::max<size_t>(
+      1, std::min(concurrency_, candidates.size() / kMinDocumentsPerSlice));
+  size_t slice_size = (candidates.size() + slice_count - 1) / slice_count;
+  std::vector<std::vector<std::pair<DocumentKey, MutableDocument>>> slices(
+      slice_count);
+
   BackgroundQueue tasks(executor_.get());
-  AsyncResults<std::pair<DocumentKey, MutableDocument>> results;
-  for (const auto& key_version : remote_map) {
-    tasks.Execute([this, &results, &key_version, query, &mutated_docs] {
-      auto document = Get(key_version.first).WithReadTime(key_version.second);
-      if (document.is_found_document() &&
-          // Either the document matches the given query, or it is mutated.
-          (query.Matches(document) ||
-           mutated_docs.find(key_version.first) != mutated_docs.end())) {
-        results.Insert(std::make_pair(key_version.first, std::move(document)));
+  for (size_t i = 0; i < slice_count; ++i) {
+    tasks.Execute([&, i] {
+      size_t begin = std::min(i * slice_size, candidates.size());
+      size_t end = std::min(begin + slice_size, candidates.size());
+      for (size_t j = begin; j < end; ++j) {
+        const DocumentKey& key = candidates[j].first;
+        auto document = Get(key).WithReadTime(candidates[j].second);
+        if (document.is_found_document() &&
+            // Either the document matches the given query, or it is mutated.
+            (query.Matches(document) ||
+             mutated_docs.find(key) != mutated_docs.end())) {
+          slices[i].emplace_back(key, std::move(document));
+        }
       }
     });
   }
   tasks.AwaitAll();
 
-  MutableDocumentMap map;
-  for (const auto& entry : results.Result()) {
-    map = map.insert(entry.first, entry.second);
+  std::vector<std::pair<DocumentKey, MutableDocument>> results;
+  if (slice_count == 1) {
+    results = std::move(slices[0]);
+  } else {
+    for (auto& slice : slices) {
+      std::move(slice.begin(), slice.end(), std::back_inserter(results));
+    }
   }
-  return map;
+  return MutableDocumentMap::FromSorted(
+      results.size(), [&](size_t i) { return results[i]; });
 }
 
 MutableDocumentMap LevelDbRemoteDocumentCache::GetAll(
@@ -285,11 +334,16 @@ MutableDocumentMap LevelDbRemoteDocumentCache::GetDocumentsMatchingQuery(
 
 MutableDocument LevelDbRemoteDocumentCache::DecodeMaybeDocument(
     absl::string_view encoded, const DocumentKey& key) const {
+  bool uses_field_name_dictionary =
+      absl::ConsumePrefix(&encoded, kFieldNameDictionaryPrefix);
   StringReader reader{encoded};
 
   auto message = Message<firestore_client_MaybeDocument>::TryParse(&reader);
   MutableDocument maybe_document =
-      serializer_->DecodeMaybeDocument(&reader, *message);
+      uses_field_name_dictionary
+          ? serializer_->DecodeMaybeDocument(&reader, *message,
+                                             *GetFieldNameDictionary(key))
+          : serializer_->DecodeMaybeDocument(&reader, *message);
 
   if (!reader.ok()) {
     HARD_FAIL("MaybeDocument proto failed to parse: %s",
@@ -302,6 +356,29 @@ MutableDocument LevelDbRemoteDocumentCache::DecodeMaybeDocument(
   return maybe_document;
 }
 
+LevelDbFieldNameDictionary* LevelDbRemoteDocumentCache::GetFieldNameDictionary(
+    const DocumentKey& key) const {
+  std::string collection_group = *key.GetCollectionGroup();
+
+  std::lock_guard<std::mutex> lock(field_name_dictionaries_mutex_);
+  auto found = field_name_dictionaries_.find(collection_group);
+  if (found == field_name_dictionaries_.end()) {
+    auto dictionary =
+        absl::make_unique<LevelDbFieldNameDictionary>(db_, collection_group);
+    found = field_name_dictionaries_
+                .emplace(std::move(collection_group), std::move(dictionary))
+                .first;
+  }
+  return found->second.get();
+}
+
+void LevelDbRemoteDocumentCache::SetFieldNameDictionaryEnabled(bool enabled) {
+  field_name_dictionary_enabled_ = enabled;
+
+  std::lock_guard<std::mutex> lock(field_name_dictionaries_mutex_);
+  field_name_dictionaries_.clear();
+}
+
 void LevelDbRemoteDocumentCache::SetIndexManager(IndexManager* manager) {
   index_manager_ = NOT_NULL(manager);
 }
@@ -18,8 +18,10 @@
 #define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_REMOTE_DOCUMENT_CACHE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "Firestore/core/src/core/query.h"
@@ -45,6 +47,7 @@ class SnapshotVersion;
 
 namespace local {
 
+class LevelDbFieldNameDictionary;
 class LevelDbPersistence;
 class LocalSerializer;
 
@@ -79,6 +82,18 @@ class LevelDbRemoteDocumentCache : public RemoteDocumentCache {
 
   void SetIndexManager(IndexManager* manager) override;
 
+  /**
+   * Sets whether documents added from now on are stored with the names of
+   * their fields replaced by IDs from a dictionary kept per collection group,
+   * which saves space when many documents share the same field names.
+   * Documents are read back correctly whichever way they were stored.
+   *
+   * Also forgets the dictionaries loaded so far. Callers go through
+   * `LevelDbPersistence::SetFieldNameDictionaryEnabled`, which rewrites the
+   * stored documents when the encoding is turned off.
+   */
+  void SetFieldNameDictionaryEnabled(bool enabled);
+
  private:
   /**
    * Looks up a set of entries in the cache, returning only existing entries of
@@ -92,6 +107,13 @@ class LevelDbRemoteDocumentCache : public RemoteDocumentCache {
   model::MutableDocument DecodeMaybeDocument(
       absl::string_view encoded, const model::DocumentKey& key) const;
 
+  /**
+   * Returns the field name dictionary of the collection group containing
+   * `key`, loading it from leveldb on first use.
+   */
+  LevelDbFieldNameDictionary* GetFieldNameDictionary(
+      const model::DocumentKey& key) const;
+
   // The LevelDbRemoteDocumentCache instance is owned by LevelDbPersistence.
   LevelDbPersistence* db_;
   // The LevelDbIndexManager instance is owned by LevelDbPersistence.
@@ -100,6 +122,17 @@ class LevelDbRemoteDocumentCache : public RemoteDocumentCache {
   LocalSerializer* serializer_ = nullptr;
 
   std::unique_ptr<util::Executor> executor_;
+  // The number of tasks `executor_` runs at once.
+  size_t concurrency_ = 1;
+
+  bool field_name_dictionary_enabled_ = false;
+
+  // Documents are decoded concurrently, so loading the dictionaries is
+  // guarded by a mutex.
+  mutable std::mutex field_name_dictionaries_mutex_;
+  mutable std::unordered_map<std::string,
+                             std::unique_ptr<LevelDbFieldNameDictionary>>
+      field_name_dictionaries_;
 };
 
 }  // namespace local
@@ -250,22 +250,22 @@ void LevelDbTargetCache::AddMatchingKeys(const DocumentKeySet& keys,
   std::string empty_buffer;
 
   for (const DocumentKey& key : keys) {
+    db_->reference_delegate()->AddReference(key);
     db_->current_transaction()->Put(
         LevelDbTargetDocumentKey::Key(target_id, key), empty_buffer);
     db_->current_transaction()->Put(
         LevelDbDocumentTargetKey::Key(key, target_id), empty_buffer);
-    db_->reference_delegate()->AddReference(key);
   }
 }
 
 void LevelDbTargetCache::RemoveMatchingKeys(const DocumentKeySet& keys,
                                             TargetId target_id) {
   for (const DocumentKey& key : keys) {
+    db_->reference_delegate()->RemoveReference(key);
     db_->current_transaction()->Delete(
         LevelDbTargetDocumentKey::Key(target_id, key));
     db_->current_transaction()->Delete(
         LevelDbDocumentTargetKey::Key(key, target_id));
-    db_->reference_delegate()->RemoveReference(key);
   }
 }
 
@@ -283,6 +283,7 @@ void LevelDbTargetCache::RemoveMatchingKeysForTarget(TargetId target_id) {
       break;
     }
     const DocumentKey& document_key = row_key.document_key();
+    db_->reference_delegate()->TrackOrphanedDocument(document_key);
 
     // Delete both index rows
     db_->current_transaction()->Delete(index_key);
@@ -365,12 +366,21 @@ void LevelDbTargetCache::SetLastRemoteSnapshotVersion(SnapshotVersion version) {
 
 void LevelDbTargetCache::EnumerateOrphanedDocuments(
     const OrphanedDocumentCallback& callback) {
+  EnumerateOrphanedDocuments(absl::nullopt, callback, [] { return false; });
+}
+
+absl::optional<DocumentKey> LevelDbTargetCache::EnumerateOrphanedDocuments(
+    const absl::optional<DocumentKey>& start_key,
+    const OrphanedDocumentCallback& callback,
+    const std::function<bool()>& should_stop) {
   std::string document_target_prefix = LevelDbDocumentTargetKey::KeyPrefix();
   auto it = db_->current_transaction()->NewIterator();
-  it->Seek(document_target_prefix);
+  it->Seek(start_key ? LevelDbDocumentTargetKey::KeyPrefix(start_key->path())
+                     : document_target_prefix);
   ListenSequenceNumber next_to_report = 0;
   DocumentKey key_to_report;
   LevelDbDocumentTargetKey key;
+  bool examined_any = false;
 
   for (; it->Valid() && absl::StartsWith(it->key(), document_target_prefix);
        it->Next()) {
@@ -381,6 +391,11 @@ void LevelDbTargetCache::EnumerateOrphanedDocuments(
       if (next_to_report != 0) {
         callback(key_to_report, next_to_report);
       }
+      // Examine at least one document so that every call makes progress.
+      if (examined_any && should_stop()) {
+        return key.document_key();
+      }
+      examined_any = true;
       // set next_to_report to be this sequence number. It's the next one we
       // might report, if we don't find any targets for this document.
       next_to_report =
@@ -397,6 +412,28 @@ void LevelDbTargetCache::EnumerateOrphanedDocuments(
   if (next_to_report != 0) {
     callback(key_to_report, next_to_report);
   }
+  return absl::nullopt;
+}
+
+absl::optional<ListenSequenceNumber>
+LevelDbTargetCache::GetOrphanedSequenceNumber(const DocumentKey& key) {
+  auto it = db_->current_transaction()->NewIterator();
+  it->Seek(LevelDbDocumentTargetKey::SentinelKey(key));
+  LevelDbDocumentTargetKey row_key;
+  if (!it->Valid() || !row_key.Decode(it->key()) || !row_key.IsSentinel() ||
+      row_key.document_key() != key) {
+    return absl::nullopt;
+  }
+  ListenSequenceNumber sequence_number =
+      LevelDbDocumentTargetKey::DecodeSentinelValue(it->value());
+
+  // The sentinel row sorts before the rows of the document's targets.
+  it->Next();
+  if (it->Valid() && row_key.Decode(it->key()) &&
+      row_key.document_key() == key) {
+    return absl::nullopt;
+  }
+  return sequence_number;
 }
 
 void LevelDbTargetCache::Save(const TargetData& target_data) {
@@ -17,11 +17,13 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_LEVELDB_TARGET_CACHE_H_
 #define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_TARGET_CACHE_H_
 
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "Firestore/Protos/nanopb/firestore/local/target.nanopb.h"
 #include "Firestore/core/src/local/target_cache.h"
+#include "Firestore/core/src/model/document_key.h"
 #include "Firestore/core/src/model/model_fwd.h"
 #include "Firestore/core/src/model/snapshot_version.h"
 #include "Firestore/core/src/nanopb/message.h"
@@ -125,6 +127,28 @@ class LevelDbTargetCache : public TargetCache {
 
   void EnumerateOrphanedDocuments(const OrphanedDocumentCallback& callback);
 
+  /**
+   * Enumerates orphaned documents like the overload above, but starts at the
+   * document with `start_key` (or the first document if it's empty) and stops
+   * once `should_stop` returns true between documents. At least one document
+   * is examined.
+   *
+   * Returns the key of the first document that wasn't examined, or an empty
+   * optional if the enumeration reached the last document.
+   */
+  absl::optional<model::DocumentKey> EnumerateOrphanedDocuments(
+      const absl::optional<model::DocumentKey>& start_key,
+      const OrphanedDocumentCallback& callback,
+      const std::function<bool()>& should_stop);
+
+  /**
+   * Returns the sequence number in the sentinel row of the document with `key`
+   * if the document is orphaned, that is if it has a sentinel row but doesn't
+   * belong to any target, and an empty optional otherwise.
+   */
+  absl::optional<model::ListenSequenceNumber> GetOrphanedSequenceNumber(
+      const model::DocumentKey& key);
+
  private:
   void Save(const TargetData& target_data);
   bool UpdateMetadata(const TargetData& target_data);
@@ -14,11 +14,15 @@
  * limitations under the License.
  */
 
+#include <pb_encode.h>
+
+#include <cstring>
 #include <type_traits>
 
 #include "Firestore/core/src/local/leveldb_transaction.h"
 
 #include "Firestore/core/src/local/leveldb_key.h"
+#include "Firestore/core/src/local/leveldb_util.h"
 #include "Firestore/core/src/util/hard_assert.h"
 #include "Firestore/core/src/util/log.h"
 #include "absl/memory/memory.h"
@@ -41,7 +45,7 @@ LevelDbTransaction::Iterator::Iterator(LevelDbTransaction* txn)
     : db_iter_(txn->db_->NewIterator(txn->read_options_)),
       last_version_(txn->version_),
       txn_(txn),
-      mutations_iter_(txn->mutations_.begin()),
+      buffer_iter_(&txn->writes_),
       current_(),
       is_mutation_(false),
       // Iterator doesn't really point to anything yet, so is
@@ -50,7 +54,7 @@ LevelDbTransaction::Iterator::Iterator(LevelDbTransaction* txn)
 }
 
 void LevelDbTransaction::Iterator::UpdateCurrent() {
-  bool mutation_is_valid = mutations_iter_ != txn_->mutations_.end();
+  bool mutation_is_valid = buffer_iter_.Valid();
   is_valid_ = mutation_is_valid || db_iter_->Valid();
 
   if (is_valid_) {
@@ -63,10 +67,13 @@ void LevelDbTransaction::Iterator::UpdateCurrent() {
       // than the current mutation key, we are looking at a mutation next. It's
       // either sooner in the iteration or directly shadowing the underlying
       // committed value in leveldb.
-      is_mutation_ = db_iter_->key().compare(mutations_iter_->first) >= 0;
+      is_mutation_ =
+          db_iter_->key().compare(MakeSlice(buffer_iter_.entry().key)) >= 0;
     }
     if (is_mutation_) {
-      current_ = *mutations_iter_;
+      const LevelDbWriteBuffer::Entry& entry = buffer_iter_.entry();
+      current_.first.assign(entry.key.data(), entry.key.size());
+      current_.second.assign(entry.value.data(), entry.value.size());
     } else {
       current_ = {db_iter_->key().ToString(), db_iter_->value().ToString()};
     }
@@ -81,7 +88,8 @@ void LevelDbTransaction::Iterator::Seek(const std::string& key) {
   }
   HARD_ASSERT(db_iter_->status().ok(), "leveldb iterator reported an error: %s",
               db_iter_->status().ToString());
-  mutations_iter_ = txn_->mutations_.lower_bound(key);
+  buffer_iter_.Seek(key);
+  SkipBufferedDeletions();
   UpdateCurrent();
   last_version_ = txn_->version_;
 }
@@ -97,7 +105,15 @@ const std::string& LevelDbTransaction::Iterator::value() const {
 }
 
 bool LevelDbTransaction::Iterator::IsDeleted(leveldb::Slice slice) {
-  return txn_->deletions_.find(slice.ToString()) != txn_->deletions_.end();
+  const LevelDbWriteBuffer::Entry* entry =
+      txn_->writes_.Find(MakeStringView(slice));
+  return entry != nullptr && entry->deleted;
+}
+
+void LevelDbTransaction::Iterator::SkipBufferedDeletions() {
+  while (buffer_iter_.Valid() && buffer_iter_.entry().deleted) {
+    buffer_iter_.Next();
+  }
 }
 
 bool LevelDbTransaction::Iterator::SyncToTransaction() {
@@ -127,10 +143,12 @@ void LevelDbTransaction::Iterator::Next() {
   if (!advanced && is_valid_) {
     if (is_mutation_) {
       // A mutation might be shadowing leveldb. If so, advance both.
-      if (db_iter_->Valid() && db_iter_->key() == mutations_iter_->first) {
+      if (db_iter_->Valid() &&
+          db_iter_->key() == MakeSlice(buffer_iter_.entry().key)) {
         AdvanceLDB();
       }
-      ++mutations_iter_;
+      buffer_iter_.Next();
+      SkipBufferedDeletions();
     } else {
       AdvanceLDB();
     }
@@ -168,9 +186,31 @@ const WriteOptions& LevelDbTransaction::DefaultWriteOptions() {
   return options;
 }
 
-void LevelDbTransaction::Put(std::string key, std::string value) {
-  deletions_.erase(key);
-  mutations_[std::move(key)] = std::move(value);
+void LevelDbTransaction::Put(absl::string_view key, absl::string_view value) {
+  writes_.Put(key, value);
+  version_++;
+}
+
+void LevelDbTransaction::PutEncoded(absl::string_view key,
+                                    absl::string_view prefix,
+                                    const pb_field_t* fields,
+                                    const void* src_struct) {
+  size_t size = 0;
+  bool sized = pb_get_encoded_size(&size, fields, src_struct);
+  HARD_ASSERT(sized, "Unable to compute the encoded size of the value for %s",
+              DescribeKey(key));
+
+  // Encode in place so the value is never copied before the commit.
+  char* data = writes_.PutUninitialized(key, prefix.size() + size);
+  if (!prefix.empty()) {
+    std::memcpy(data, prefix.data(), prefix.size());
+    data += prefix.size();
+  }
+  pb_ostream_t stream =
+      pb_ostream_from_buffer(reinterpret_cast<pb_byte_t*>(data), size);
+  bool encoded = pb_encode(&stream, fields, src_struct);
+  HARD_ASSERT(encoded, "Unable to encode the value for %s: %s",
+              DescribeKey(key), PB_GET_ERROR(&stream));
   version_++;
 }
 
@@ -180,35 +220,34 @@ LevelDbTransaction::NewIterator() {
 }
 
 Status LevelDbTransaction::Get(absl::string_view key, std::string* value) {
-  std::string key_string(key);
-  if (deletions_.find(key_string) != deletions_.end()) {
-    return Status::NotFound(key_string + " is not present in the transaction");
+  const LevelDbWriteBuffer::Entry* entry = writes_.Find(key);
+  if (entry == nullptr) {
+    return db_->Get(read_options_, MakeSlice(key), value);
+  } else if (entry->deleted) {
+    return Status::NotFound(
+        absl::StrCat(key, " is not present in the transaction"));
   } else {
-    Mutations::iterator iter{mutations_.find(key_string)};
-    if (iter != mutations_.end()) {
-      *value = iter->second;
-      return Status::OK();
-    } else {
-      return db_->Get(read_options_, key_string, value);
-    }
+    value->assign(entry->value.data(), entry->value.size());
+    return Status::OK();
   }
 }
 
 void LevelDbTransaction::Delete(absl::string_view key) {
-  std::string to_delete(key);
-  deletions_.insert(to_delete);
-  mutations_.erase(to_delete);
+  writes_.Delete(key);
   version_++;
 }
 
 void LevelDbTransaction::Commit() {
+  // Keys and values are appended to the batch straight from the write buffer.
   WriteBatch batch;
-  for (const auto& deletion : deletions_) {
-    batch.Delete(deletion);
-  }
-
-  for (const auto& entry : mutations_) {
-    batch.Put(entry.first, entry.second);
+  LevelDbWriteBuffer::Cursor cursor(&writes_);
+  for (cursor.SeekToFirst(); cursor.Valid(); cursor.Next()) {
+    const LevelDbWriteBuffer::Entry& entry = cursor.entry();
+    if (entry.deleted) {
+      batch.Delete(MakeSlice(entry.key));
+    } else {
+      batch.Put(MakeSlice(entry.key), MakeSlice(entry.value));
+    }
   }
 
   LOG_DEBUG("Committing transaction: %s", ToString());
@@ -220,20 +259,21 @@ void LevelDbTransaction::Commit() {
 
 std::string LevelDbTransaction::ToString() {
   std::string dest = absl::StrCat("<LevelDbTransaction ", label_, ": ");
-  size_t changes = deletions_.size() + mutations_.size();
-  size_t bytes = 0;  // accumulator for size of individual mutations.
-  dest += std::to_string(changes) + " changes ";
-  std::string items;  // accumulator for individual changes.
-  for (const auto& deletion : deletions_) {
-    absl::StrAppend(&items, "\n  - Delete ", DescribeKey(deletion));
-  }
-  for (const auto& entry : mutations_) {
-    size_t change_bytes = entry.second.size();
-    bytes += change_bytes;
-    absl::StrAppend(&items, "\n  - Put ", DescribeKey(entry.first), " (",
-                    change_bytes, " bytes)");
+  dest += std::to_string(writes_.size()) + " changes ";
+  std::string deletes;  // accumulator for individual deletions.
+  std::string puts;     // accumulator for individual puts.
+  LevelDbWriteBuffer::Cursor cursor(&writes_);
+  for (cursor.SeekToFirst(); cursor.Valid(); cursor.Next()) {
+    const LevelDbWriteBuffer::Entry& entry = cursor.entry();
+    if (entry.deleted) {
+      absl::StrAppend(&deletes, "\n  - Delete ", DescribeKey(entry.key));
+    } else {
+      absl::StrAppend(&puts, "\n  - Put ", DescribeKey(entry.key), " (",
+                      entry.value.size(), " bytes)");
+    }
   }
-  absl::StrAppend(&dest, "(", bytes, " bytes):", items, ">");
+  absl::StrAppend(&dest, "(", writes_.value_bytes(), " bytes):", deletes, puts,
+                  ">");
   return dest;
 }
 
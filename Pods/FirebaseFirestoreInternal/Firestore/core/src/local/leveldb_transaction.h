@@ -18,12 +18,11 @@
 #define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_TRANSACTION_H_
 
 #include <cstdint>
-#include <map>
 #include <memory>
-#include <set>
 #include <string>
 #include <utility>
 
+#include "Firestore/core/src/local/leveldb_write_buffer.h"
 #include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/nanopb/message.h"
 #include "Firestore/core/src/nanopb/writer.h"
@@ -40,9 +39,6 @@ namespace local {
  * changes and committed values.
  */
 class LevelDbTransaction {
-  using Deletions = std::set<std::string>;
-  using Mutations = std::map<std::string, std::string>;
-
  public:
   /**
    * Iterator iterates over a merged view of pending changes from the
@@ -87,11 +83,17 @@ class LevelDbTransaction {
     void AdvanceLDB();
 
     /**
-     * Returns true if the given slice matches a key present in the deletions_
-     * set.
+     * Returns true if the given slice matches a key deleted in this
+     * transaction.
      */
     bool IsDeleted(leveldb::Slice slice);
 
+    /**
+     * Advances `buffer_iter_` past any deletions, leaving it at the next
+     * pending write (if any).
+     */
+    void SkipBufferedDeletions();
+
     /**
      * Syncs with the underlying transaction. If the transaction has been
      * updated, the mutation iterator may need to be reset. Returns true if this
@@ -112,13 +114,13 @@ class LevelDbTransaction {
     int32_t last_version_;
     // The underlying transaction.
     LevelDbTransaction* txn_;
-    Mutations::iterator mutations_iter_;
+    LevelDbWriteBuffer::Cursor buffer_iter_;
     // We save the current key and value so that once an iterator is Valid(), it
     // remains so at least until the next call to Seek() or Next(), even if the
     // underlying data is deleted.
     std::pair<std::string, std::string> current_;
-    // True if current_ represents an entry in the mutations_ map, rather than
-    // committed data.
+    // True if current_ represents a pending write in the transaction, rather
+    // than committed data.
     bool is_mutation_;
     // True if the iterator pointed to a valid entry the last time Next() or
     // Seek() was called.
@@ -146,7 +148,7 @@ class LevelDbTransaction {
   static const leveldb::WriteOptions& DefaultWriteOptions();
 
   size_t changed_keys() const {
-    return mutations_.size() + deletions_.size();
+    return writes_.size();
   }
 
   /**
@@ -159,15 +161,27 @@ class LevelDbTransaction {
    * Schedules the row identified by `key` to be set to `value` when this
    * transaction commits.
    */
-  void Put(std::string key, std::string value);
+  void Put(absl::string_view key, absl::string_view value);
 
   /**
    * Schedules the row identified by `key` to be set to the given protocol
-   * buffer message when this transaction commits.
+   * buffer message when this transaction commits. The message is encoded
+   * directly into the transaction's write buffer.
+   */
+  template <typename T>
+  void Put(absl::string_view key, const nanopb::Message<T>& message) {
+    PutEncoded(key, {}, message.fields(), message.get());
+  }
+
+  /**
+   * Like `Put` above, but stores the bytes of `prefix` in front of the encoded
+   * message.
    */
   template <typename T>
-  void Put(std::string key, const nanopb::Message<T>& message) {
-    Put(std::move(key), MakeStdString(message));
+  void Put(absl::string_view key,
+           absl::string_view prefix,
+           const nanopb::Message<T>& message) {
+    PutEncoded(key, prefix, message.fields(), message.get());
   }
 
   /**
@@ -193,9 +207,13 @@ class LevelDbTransaction {
   std::string ToString();
 
  private:
+  void PutEncoded(absl::string_view key,
+                  absl::string_view prefix,
+                  const pb_field_t* fields,
+                  const void* src_struct);
+
   leveldb::DB* db_ = nullptr;
-  Mutations mutations_;
-  Deletions deletions_;
+  LevelDbWriteBuffer writes_;
   leveldb::ReadOptions read_options_;
   leveldb::WriteOptions write_options_;
   int32_t version_ = 0;
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/leveldb_write_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "Firestore/core/src/util/hard_assert.h"
+#include "absl/memory/memory.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+using Entry = LevelDbWriteBuffer::Entry;
+
+namespace {
+
+// The recent run is never folded into the main run while smaller than this,
+// so small transactions keep a single run.
+const size_t kMinRecentRunSize = 64;
+
+}  // namespace
+
+/**
+ * A bump allocator for the keys and values of the buffer. Memory is handed
+ * out from fixed-size blocks; values too large to share a block get a block
+ * of their own.
+ */
+class LevelDbWriteBuffer::Arena {
+ public:
+  char* Allocate(size_t size) {
+    if (size > remaining_) {
+      if (size > kBlockSize / 4) {
+        // Avoid wasting the rest of the current block on a large value.
+        return AllocateBlock(size);
+      }
+      current_ = AllocateBlock(kBlockSize);
+      remaining_ = kBlockSize;
+    }
+
+    char* result = current_;
+    current_ += size;
+    remaining_ -= size;
+    return result;
+  }
+
+ private:
+  static constexpr size_t kBlockSize = 8192;
+
+  char* AllocateBlock(size_t size) {
+    blocks_.emplace_back(new char[size]);
+    return blocks_.back().get();
+  }
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* current_ = nullptr;
+  size_t remaining_ = 0;
+};
+
+// MARK: - LevelDbWriteBuffer::Cursor
+
+LevelDbWriteBuffer::Cursor::Cursor(const LevelDbWriteBuffer* buffer)
+    : buffer_(buffer) {
+}
+
+bool LevelDbWriteBuffer::Cursor::Valid() const {
+  return main_pos_ < buffer_->main_run_.size() ||
+         recent_pos_ < buffer_->recent_run_.size();
+}
+
+void LevelDbWriteBuffer::Cursor::Seek(absl::string_view key) {
+  buffer_->Sort();
+
+  const std::vector<Entry>& entries = buffer_->entries_;
+  auto key_less = [&entries](uint32_t index, absl::string_view key) {
+    return entries[index].key < key;
+  };
+
+  const std::vector<uint32_t>& main = buffer_->main_run_;
+  const std::vector<uint32_t>& recent = buffer_->recent_run_;
+  main_pos_ = std::lower_bound(main.begin(), main.end(), key, key_less) -
+              main.begin();
+  recent_pos_ = std::lower_bound(recent.begin(), recent.end(), key, key_less) -
+                recent.begin();
+}
+
+void LevelDbWriteBuffer::Cursor::SeekToFirst() {
+  buffer_->Sort();
+  main_pos_ = 0;
+  recent_pos_ = 0;
+}
+
+const Entry& LevelDbWriteBuffer::Cursor::entry() const {
+  HARD_ASSERT(Valid(), "entry() called on invalid cursor");
+  return buffer_->entries_[CurrentIndex()];
+}
+
+void LevelDbWriteBuffer::Cursor::Next() {
+  HARD_ASSERT(Valid(), "Next() called on invalid cursor");
+  if (InRecentRun()) {
+    ++recent_pos_;
+  } else {
+    ++main_pos_;
+  }
+}
+
+bool LevelDbWriteBuffer::Cursor::InRecentRun() const {
+  // The runs are disjoint, so the smaller of the two current keys is next.
+  const std::vector<uint32_t>& main = buffer_->main_run_;
+  const std::vector<uint32_t>& recent = buffer_->recent_run_;
+  if (recent_pos_ == recent.size()) return false;
+  if (main_pos_ == main.size()) return true;
+  return buffer_->KeyLess(recent[recent_pos_], main[main_pos_]);
+}
+
+uint32_t LevelDbWriteBuffer::Cursor::CurrentIndex() const {
+  return InRecentRun() ? buffer_->recent_run_[recent_pos_]
+                       : buffer_->main_run_[main_pos_];
+}
+
+// MARK: - LevelDbWriteBuffer
+
+LevelDbWriteBuffer::LevelDbWriteBuffer() : arena_(absl::make_unique<Arena>()) {
+}
+
+LevelDbWriteBuffer::~LevelDbWriteBuffer() = default;
+
+void LevelDbWriteBuffer::Put(absl::string_view key, absl::string_view value) {
+  char* data = PutUninitialized(key, value.size());
+  if (!value.empty()) {
+    std::memcpy(data, value.data(), value.size());
+  }
+}
+
+char* LevelDbWriteBuffer::PutUninitialized(absl::string_view key,
+                                           size_t size) {
+  Entry* entry = Upsert(key);
+  if (!entry->deleted) {
+    value_bytes_ -= entry->value.size();
+  }
+
+  char* data = arena_->Allocate(size);
+  entry->value = absl::string_view(data, size);
+  entry->deleted = false;
+  value_bytes_ += size;
+  return data;
+}
+
+void LevelDbWriteBuffer::Delete(absl::string_view key) {
+  Entry* entry = Upsert(key);
+  if (!entry->deleted) {
+    value_bytes_ -= entry->value.size();
+  }
+
+  entry->value = {};
+  entry->deleted = true;
+}
+
+const Entry* LevelDbWriteBuffer::Find(absl::string_view key) const {
+  auto found = index_.find(key);
+  return found != index_.end() ? &entries_[found->second] : nullptr;
+}
+
+Entry* LevelDbWriteBuffer::Upsert(absl::string_view key) {
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    return &entries_[found->second];
+  }
+
+  // New entries start out as empty values; callers fill them in.
+  Entry entry;
+  entry.key = Copy(key);
+  index_.emplace(entry.key, static_cast<uint32_t>(entries_.size()));
+  entries_.push_back(entry);
+  return &entries_.back();
+}
+
+void LevelDbWriteBuffer::Sort() const {
+  size_t sorted = main_run_.size() + recent_run_.size();
+  if (sorted == entries_.size()) return;
+
+  auto key_less = [this](uint32_t lhs, uint32_t rhs) {
+    return KeyLess(lhs, rhs);
+  };
+
+  // Sort the newly appended entries and merge them into the recent run.
+  size_t recent_size = recent_run_.size();
+  for (size_t i = sorted; i < entries_.size(); ++i) {
+    recent_run_.push_back(static_cast<uint32_t>(i));
+  }
+  auto appended = recent_run_.begin() + recent_size;
+  std::sort(appended, recent_run_.end(), key_less);
+  if (recent_size > 0 && key_less(*appended, *(appended - 1))) {
+    std::inplace_merge(recent_run_.begin(), appended, recent_run_.end(),
+                       key_less);
+  }
+
+  // Keeping the recent run within about the square root of the main run
+  // bounds both the cost of merging into it and how often the main run has to
+  // be rewritten.
+  auto root =
+      static_cast<size_t>(std::sqrt(static_cast<double>(main_run_.size())));
+  if (recent_run_.size() <= std::max(kMinRecentRunSize, 2 * root)) return;
+
+  if (main_run_.empty()) {
+    main_run_.swap(recent_run_);
+    return;
+  }
+
+  std::vector<uint32_t> merged;
+  merged.reserve(main_run_.size() + recent_run_.size());
+  std::merge(main_run_.begin(), main_run_.end(), recent_run_.begin(),
+             recent_run_.end(), std::back_inserter(merged), key_less);
+  main_run_.swap(merged);
+  recent_run_.clear();
+}
+
+absl::string_view LevelDbWriteBuffer::Copy(absl::string_view data) {
+  char* copy = arena_->Allocate(data.size());
+  if (!data.empty()) {
+    std::memcpy(copy, data.data(), data.size());
+  }
+  return absl::string_view(copy, data.size());
+}
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_LOCAL_LEVELDB_WRITE_BUFFER_H_
+#define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_WRITE_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+/**
+ * The pending writes of a `LevelDbTransaction`: an ordered map from keys to
+ * either a new value or a deletion.
+ *
+ * Keys and values are copied into an arena owned by the buffer, and entries
+ * are appended to a flat array, so buffering a write costs no per-entry heap
+ * allocation. A hash index over the entries serves point lookups and
+ * overwrites. Key order is only established when a `Cursor` needs it: the
+ * entries appended since the last sort are sorted and merged into a small run
+ * of recent entries, which is folded into the main sorted run once it grows
+ * past roughly the square root of the main run. Cursors walk both runs at
+ * once, so reads interleaved with writes stay cheap in large transactions.
+ *
+ * The memory for overwritten values is only reclaimed when the buffer is
+ * destroyed, which suits the short lifetime of a transaction.
+ */
+class LevelDbWriteBuffer {
+ public:
+  struct Entry {
+    absl::string_view key;
+    absl::string_view value;
+    bool deleted = false;
+  };
+
+  /**
+   * Walks the entries of a buffer in key order, including deletions. A cursor
+   * is invalidated by any modification of the buffer; reposition it with
+   * `Seek` afterwards.
+   */
+  class Cursor {
+   public:
+    explicit Cursor(const LevelDbWriteBuffer* buffer);
+
+    bool Valid() const;
+
+    /** Positions the cursor at the first entry with a key >= `key`. */
+    void Seek(absl::string_view key);
+
+    void SeekToFirst();
+
+    void Next();
+
+    const Entry& entry() const;
+
+   private:
+    // Whether the current entry comes from the recent run.
+    bool InRecentRun() const;
+    uint32_t CurrentIndex() const;
+
+    const LevelDbWriteBuffer* buffer_ = nullptr;
+    size_t main_pos_ = 0;
+    size_t recent_pos_ = 0;
+  };
+
+  LevelDbWriteBuffer();
+  ~LevelDbWriteBuffer();
+
+  LevelDbWriteBuffer(const LevelDbWriteBuffer& other) = delete;
+  LevelDbWriteBuffer& operator=(const LevelDbWriteBuffer& other) = delete;
+
+  /** The number of distinct keys written or deleted. */
+  size_t size() const {
+    return entries_.size();
+  }
+
+  /** The total size of all buffered values. */
+  size_t value_bytes() const {
+    return value_bytes_;
+  }
+
+  void Put(absl::string_view key, absl::string_view value);
+
+  /**
+   * Schedules `key` to be set to a value of `size` bytes and returns a pointer
+   * to arena storage that the caller must fill in before the buffer is next
+   * read. This allows values to be encoded in place without an intermediate
+   * copy.
+   */
+  char* PutUninitialized(absl::string_view key, size_t size);
+
+  void Delete(absl::string_view key);
+
+  /**
+   * Returns the entry for `key`, or nullptr if `key` has been neither written
+   * nor deleted. The result is invalidated by any modification of the buffer.
+   */
+  const Entry* Find(absl::string_view key) const;
+
+ private:
+  class Arena;
+
+  Entry* Upsert(absl::string_view key);
+
+  /**
+   * Brings the sorted runs up to date with the entries appended since the
+   * last call.
+   */
+  void Sort() const;
+
+  bool KeyLess(uint32_t lhs, uint32_t rhs) const {
+    return entries_[lhs].key < entries_[rhs].key;
+  }
+
+  absl::string_view Copy(absl::string_view data);
+
+  std::unique_ptr<Arena> arena_;
+
+  // Entries in insertion order. Entries are never removed, so indexes into
+  // this array are stable.
+  std::vector<Entry> entries_;
+
+  // Maps each key to the index of its entry.
+  absl::flat_hash_map<absl::string_view, uint32_t> index_;
+
+  // Two disjoint runs of indexes into `entries_`, each in key order. Together
+  // they cover every entry except those appended since the last call to
+  // `Sort`, which are always at the end of `entries_`.
+  mutable std::vector<uint32_t> main_run_;
+  mutable std::vector<uint32_t> recent_run_;
+
+  size_t value_bytes_ = 0;
+};
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_LOCAL_LEVELDB_WRITE_BUFFER_H_
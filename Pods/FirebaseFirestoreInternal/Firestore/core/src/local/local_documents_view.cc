@@ -182,25 +182,32 @@ DocumentMap LocalDocumentsView::GetDocumentsMatchingCollectionQuery(
     }
   }
 
-  // Apply the overlays and match against the query.
-  DocumentMap results;
+  // Apply the overlays and match against the query. The remote document cache
+  // only returns documents that match the query or have an overlay, so only
+  // the overlaid documents need to be matched again. Documents are visited in
+  // key order, which lets the result be built in one pass.
+  std::vector<std::pair<DocumentKey, Document>> results;
+  results.reserve(remote_documents.size());
   for (const auto& entry : remote_documents) {
     const auto& key = entry.first;
-    MutableDocument doc = entry.second;
-
     auto overlay_it = overlays.find(key);
-    if (overlay_it != overlays.end()) {
-      (*overlay_it)
-          .second.mutation()
-          .ApplyToLocalView(doc, FieldMask(), Timestamp::Now());
+    if (overlay_it == overlays.end()) {
+      results.emplace_back(key, Document(entry.second));
+      continue;
     }
-    // Finally, insert the documents that still match the query
+
+    MutableDocument doc = entry.second;
+    (*overlay_it)
+        .second.mutation()
+        .ApplyToLocalView(doc, FieldMask(), Timestamp::Now());
+    // Finally, keep the documents that still match the query
     if (query.Matches(doc)) {
-      results = results.insert(key, std::move(doc));
+      results.emplace_back(key, Document(std::move(doc)));
     }
   }
 
-  return results;
+  return DocumentMap::FromSorted(results.size(),
+                                 [&](size_t i) { return results[i]; });
 }
 
 Document LocalDocumentsView::GetDocument(const DocumentKey& key) {
@@ -283,7 +290,8 @@ model::OverlayedDocumentMap LocalDocumentsView::ComputeViews(
   }
 
   auto recalculate_fields =
-      RecalculateAndSaveOverlays(std::move(recalculate_documents));
+      RecalculateAndSaveOverlays(std::move(recalculate_documents),
+                                 absl::nullopt);
   mutated_fields.insert(recalculate_fields.begin(), recalculate_fields.end());
 
   model::OverlayedDocumentMap results;
@@ -297,17 +305,19 @@ model::OverlayedDocumentMap LocalDocumentsView::ComputeViews(
 }
 
 void LocalDocumentsView::RecalculateAndSaveOverlays(
-    const DocumentKeySet& keys) const {
+    const DocumentKeySet& keys,
+    absl::optional<BatchId> changed_batch_id) const {
   model::MutableDocumentPtrMap docs;
   auto remote_docs = remote_document_cache_->GetAll(keys);
   for (const auto& entry : remote_docs) {
     docs[entry.first] = const_cast<MutableDocument*>(&(entry.second));
   }
-  RecalculateAndSaveOverlays(std::move(docs));
+  RecalculateAndSaveOverlays(std::move(docs), changed_batch_id);
 }
 
 model::FieldMaskMap LocalDocumentsView::RecalculateAndSaveOverlays(
-    model::MutableDocumentPtrMap&& docs) const {
+    model::MutableDocumentPtrMap&& docs,
+    absl::optional<BatchId> changed_batch_id) const {
   DocumentKeySet keys;
   for (const auto& doc : docs) {
     keys = keys.insert(doc.first);
@@ -315,36 +325,70 @@ model::FieldMaskMap LocalDocumentsView::RecalculateAndSaveOverlays(
   std::vector<MutationBatch> batches =
       mutation_queue_->AllMutationBatchesAffectingDocumentKeys(std::move(keys));
 
+  // A mutation that replaces a document outright makes the local view
+  // independent of the remote document and of all earlier batches. Find the
+  // last such batch for each document, so that replaying can start there.
+  std::unordered_map<DocumentKey, size_t, DocumentKeyHash> first_batch_index;
+  for (size_t i = 0; i < batches.size(); ++i) {
+    for (const Mutation& mutation : batches[i].mutations()) {
+      if (OverwritesDocument(mutation) &&
+          docs.find(mutation.key()) != docs.end()) {
+        first_batch_index[mutation.key()] = i;
+      }
+    }
+  }
+
   model::FieldMaskMap masks;
   // A reverse lookup map from batch id to the documents within that batch,
   // ordered by batch id (note that std::map is ordered).
   std::map<BatchId, DocumentKeySet> documents_by_batch_id;
 
   // Apply mutations from mutation queue to the documents, collecting batch id
-  // and field masks along the way.
-  for (const MutationBatch& batch : batches) {
-    for (const DocumentKey& key : batch.keys()) {
+  // and field masks along the way. Each batch is walked once, applying every
+  // mutation to its document: base mutations first, then user mutations, as
+  // `MutationBatch::ApplyToLocalView` does for a single document.
+  for (size_t i = 0; i < batches.size(); ++i) {
+    const MutationBatch& batch = batches[i];
+    DocumentKeySet& batch_documents = documents_by_batch_id[batch.batch_id()];
+
+    auto apply = [&](const Mutation& mutation) {
+      const DocumentKey& key = mutation.key();
       auto base_doc_it = docs.find(key);
       if (base_doc_it == docs.end()) {
         // If this batch has documents not included in passed in `docs`, skip
         // them.
-        continue;
+        return;
       }
-      MutableDocument* base_doc = base_doc_it->second;
+      batch_documents = batch_documents.insert(key);
 
-      absl::optional<FieldMask> mask = FieldMask();
-      auto mask_it = masks.find(key);
-      if (mask_it != masks.end()) {
-        mask = mask_it->second;
+      auto first_it = first_batch_index.find(key);
+      if (first_it != first_batch_index.end() && i < first_it->second) {
+        // Overwritten by a later batch.
+        return;
       }
-      mask = batch.ApplyToLocalView(*base_doc, std::move(mask));
-      masks[key] = mask;
-      BatchId batch_id = batch.batch_id();
-      DocumentKeySet& documents = documents_by_batch_id[batch_id];
-      documents = documents.insert(key);
+
+      auto mask_it = masks.emplace(key, FieldMask()).first;
+      mask_it->second = mutation.ApplyToLocalView(
+          *base_doc_it->second, std::move(mask_it->second),
+          batch.local_write_time());
+    };
+    for (const Mutation& mutation : batch.base_mutations()) {
+      apply(mutation);
+    }
+    for (const Mutation& mutation : batch.mutations()) {
+      apply(mutation);
     }
   }
 
+  // If only `changed_batch_id` changed, the overlay of a document that a later
+  // batch overwrites is still current and does not need to be rewritten.
+  auto is_unchanged = [&](const DocumentKey& key) {
+    if (!changed_batch_id.has_value()) return false;
+    auto first_it = first_batch_index.find(key);
+    return first_it != first_batch_index.end() &&
+           batches[first_it->second].batch_id() > *changed_batch_id;
+  };
+
   DocumentKeySet processed;
   // Iterate in descending order of batch ids, skip documents that are already
   // saved.
@@ -352,23 +396,35 @@ model::FieldMaskMap LocalDocumentsView::RecalculateAndSaveOverlays(
        it != documents_by_batch_id.rend(); ++it) {
     MutationByDocumentKeyMap overlays;
     for (const DocumentKey& key : it->second) {
-      if (!processed.contains(key)) {
-        auto docs_it = docs.find(key);
-        HARD_ASSERT(docs_it != docs.end());
-        absl::optional<Mutation> mutation =
-            Mutation::CalculateOverlayMutation(*docs_it->second, masks[key]);
-        if (mutation.has_value()) {
-          overlays[key] = std::move(mutation).value();
-        }
-        processed = processed.insert(key);
+      if (processed.contains(key)) continue;
+      processed = processed.insert(key);
+      if (is_unchanged(key)) continue;
+
+      auto docs_it = docs.find(key);
+      HARD_ASSERT(docs_it != docs.end());
+      absl::optional<Mutation> mutation =
+          Mutation::CalculateOverlayMutation(*docs_it->second, masks[key]);
+      if (mutation.has_value()) {
+        overlays[key] = std::move(mutation).value();
       }
     }
-    document_overlay_cache_->SaveOverlays(it->first, overlays);
+    if (!overlays.empty()) {
+      document_overlay_cache_->SaveOverlays(it->first, overlays);
+    }
   }
 
   return masks;
 }
 
+bool LocalDocumentsView::OverwritesDocument(const Mutation& mutation) {
+  // A set with transforms reads the previous field values, and a mutation
+  // with a precondition depends on the previous state of the document.
+  return mutation.precondition().is_none() &&
+         (mutation.type() == Mutation::Type::Delete ||
+          (mutation.type() == Mutation::Type::Set &&
+           mutation.field_transforms().empty()));
+}
+
 MutableDocument LocalDocumentsView::GetBaseDocument(
     const DocumentKey& key, const absl::optional<Overlay>& overlay) const {
   return (!overlay.has_value() ||
@@ -129,8 +129,15 @@ class LocalDocumentsView {
   /**
    * Recalculates overlays by reading the documents from remote document cache
    * first, and save them after they are calculated.
+   *
+   * @param changed_batch_id If set, the only change since the overlays were
+   *     last saved is that this batch was acknowledged or rejected. Documents
+   *     that a later batch overwrites entirely do not depend on it, and their
+   *     overlays are left as they are.
    */
-  void RecalculateAndSaveOverlays(const model::DocumentKeySet& keys) const;
+  void RecalculateAndSaveOverlays(
+      const model::DocumentKeySet& keys,
+      absl::optional<model::BatchId> changed_batch_id = absl::nullopt) const;
 
   /**
    * Performs a query against the local view of all documents.
@@ -215,8 +222,21 @@ class LocalDocumentsView {
       model::OverlayByDocumentKeyMap&& overlays,
       const model::DocumentKeySet& existence_state_changed) const;
 
+  /**
+   * Replays the mutation batches affecting `docs` onto them, saving the
+   * resulting overlays, and returns the mutated fields of each document.
+   * Batches before the last one that overwrites a document entirely (a set
+   * without transforms or a delete) are skipped for that document.
+   */
   model::FieldMaskMap RecalculateAndSaveOverlays(
-      model::MutableDocumentPtrMap&& docs) const;
+      model::MutableDocumentPtrMap&& docs,
+      absl::optional<model::BatchId> changed_batch_id) const;
+
+  /**
+   * Whether applying `mutation` yields the same document regardless of the
+   * document's previous state.
+   */
+  static bool OverwritesDocument(const model::Mutation& mutation);
 
   RemoteDocumentCache* remote_document_cache_;
   MutationQueue* mutation_queue_;
@@ -32,6 +32,7 @@
 #include "Firestore/core/src/bundle/bundle_metadata.h"
 #include "Firestore/core/src/bundle/named_query.h"
 #include "Firestore/core/src/core/query.h"
+#include "Firestore/core/src/local/field_name_dictionary.h"
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/field_path.h"
 #include "Firestore/core/src/model/mutable_document.h"
@@ -43,6 +44,7 @@
 #include "Firestore/core/src/util/hard_assert.h"
 #include "Firestore/core/src/util/statusor.h"
 #include "Firestore/core/src/util/string_format.h"
+#include "absl/types/optional.h"
 #include "absl/types/span.h"
 
 namespace firebase {
@@ -67,6 +69,8 @@ using nanopb::ByteString;
 using nanopb::CheckedSize;
 using nanopb::CopyBytesArray;
 using nanopb::MakeArray;
+using nanopb::MakeBytesArray;
+using nanopb::MakeStringView;
 using nanopb::Message;
 using nanopb::Reader;
 using nanopb::ReleaseFieldOwnership;
@@ -76,6 +80,117 @@ using nanopb::Writer;
 using util::Status;
 using util::StringFormat;
 
+// The longest varint encoding of a 32-bit field name ID.
+const size_t kMaxFieldNameIdSize = 5;
+
+/**
+ * Encodes a field name ID as a varint, which takes a single byte for the
+ * first 128 field names of a collection group.
+ */
+pb_bytes_array_t* EncodeFieldNameId(int32_t id) {
+  uint8_t buffer[kMaxFieldNameIdSize];
+  size_t size = 0;
+  auto value = static_cast<uint32_t>(id);
+  do {
+    auto byte = static_cast<uint8_t>(value & 0x7f);
+    value >>= 7;
+    buffer[size++] = value != 0 ? (byte | 0x80) : byte;
+  } while (value != 0);
+  return MakeBytesArray(buffer, size);
+}
+
+absl::optional<int32_t> DecodeFieldNameId(const pb_bytes_array_t* bytes) {
+  if (bytes == nullptr || bytes->size > kMaxFieldNameIdSize) {
+    return absl::nullopt;
+  }
+
+  uint32_t value = 0;
+  for (pb_size_t i = 0; i < bytes->size; ++i) {
+    uint8_t byte = bytes->bytes[i];
+    value |= static_cast<uint32_t>(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      if (i + 1 != bytes->size) return absl::nullopt;
+      return static_cast<int32_t>(value);
+    }
+  }
+  return absl::nullopt;
+}
+
+template <typename Entry>
+void EncodeFieldNames(Entry* fields,
+                      pb_size_t fields_count,
+                      FieldNameDictionary* field_names);
+
+void EncodeFieldNames(google_firestore_v1_Value* value,
+                      FieldNameDictionary* field_names) {
+  if (value->which_value_type == google_firestore_v1_Value_map_value_tag) {
+    EncodeFieldNames(value->map_value.fields, value->map_value.fields_count,
+                     field_names);
+  } else if (value->which_value_type ==
+             google_firestore_v1_Value_array_value_tag) {
+    for (pb_size_t i = 0; i < value->array_value.values_count; ++i) {
+      EncodeFieldNames(&value->array_value.values[i], field_names);
+    }
+  }
+}
+
+/** Replaces the keys of the given map entries with field name IDs. */
+template <typename Entry>
+void EncodeFieldNames(Entry* fields,
+                      pb_size_t fields_count,
+                      FieldNameDictionary* field_names) {
+  for (pb_size_t i = 0; i < fields_count; ++i) {
+    Entry& entry = fields[i];
+    int32_t id = field_names->GetOrAssignId(MakeStringView(entry.key));
+    std::free(entry.key);
+    entry.key = EncodeFieldNameId(id);
+    EncodeFieldNames(&entry.value, field_names);
+  }
+}
+
+template <typename Entry>
+bool DecodeFieldNames(Entry* fields,
+                      pb_size_t fields_count,
+                      const FieldNameDictionary& field_names);
+
+bool DecodeFieldNames(google_firestore_v1_Value* value,
+                      const FieldNameDictionary& field_names) {
+  if (value->which_value_type == google_firestore_v1_Value_map_value_tag) {
+    return DecodeFieldNames(value->map_value.fields,
+                            value->map_value.fields_count, field_names);
+  } else if (value->which_value_type ==
+             google_firestore_v1_Value_array_value_tag) {
+    for (pb_size_t i = 0; i < value->array_value.values_count; ++i) {
+      if (!DecodeFieldNames(&value->array_value.values[i], field_names)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Replaces the field name IDs in the keys of the given map entries with the
+ * field names. Returns false if an ID is unknown.
+ */
+template <typename Entry>
+bool DecodeFieldNames(Entry* fields,
+                      pb_size_t fields_count,
+                      const FieldNameDictionary& field_names) {
+  for (pb_size_t i = 0; i < fields_count; ++i) {
+    Entry& entry = fields[i];
+    absl::optional<int32_t> id = DecodeFieldNameId(entry.key);
+    const std::string* name =
+        id.has_value() ? field_names.FindFieldName(*id) : nullptr;
+    if (name == nullptr) return false;
+
+    std::free(entry.key);
+    entry.key = MakeBytesArray(*name);
+    if (!DecodeFieldNames(&entry.value, field_names)) return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 Message<firestore_client_MaybeDocument> LocalSerializer::EncodeMaybeDocument(
@@ -135,6 +250,35 @@ MutableDocument LocalSerializer::DecodeMaybeDocument(
   UNREACHABLE();
 }
 
+Message<firestore_client_MaybeDocument> LocalSerializer::EncodeMaybeDocument(
+    const MutableDocument& document, FieldNameDictionary* field_names) const {
+  Message<firestore_client_MaybeDocument> result =
+      EncodeMaybeDocument(document);
+  if (result->which_document_type ==
+      firestore_client_MaybeDocument_document_tag) {
+    EncodeFieldNames(result->document.fields, result->document.fields_count,
+                     NOT_NULL(field_names));
+  }
+  return result;
+}
+
+MutableDocument LocalSerializer::DecodeMaybeDocument(
+    Reader* reader,
+    firestore_client_MaybeDocument& proto,
+    const FieldNameDictionary& field_names) const {
+  if (!reader->status().ok()) return {};
+
+  if (proto.which_document_type ==
+          firestore_client_MaybeDocument_document_tag &&
+      !DecodeFieldNames(proto.document.fields, proto.document.fields_count,
+                        field_names)) {
+    reader->Fail("Document refers to a field name ID missing from the "
+                 "field name dictionary");
+    return {};
+  }
+  return DecodeMaybeDocument(reader, proto);
+}
+
 google_firestore_v1_Document LocalSerializer::EncodeDocument(
     const MutableDocument& doc) const {
   google_firestore_v1_Document result{};
@@ -60,6 +60,7 @@ class NamedQuery;
 
 namespace local {
 
+class FieldNameDictionary;
 class TargetData;
 
 /**
@@ -100,6 +101,26 @@ class LocalSerializer {
   model::MutableDocument DecodeMaybeDocument(
       nanopb::Reader* reader, firestore_client_MaybeDocument& proto) const;
 
+  /**
+   * @brief Encodes a MaybeDocument model like `EncodeMaybeDocument` above, but
+   * replaces the names of all fields, including those of nested maps, with
+   * IDs assigned by `field_names`.
+   */
+  nanopb::Message<firestore_client_MaybeDocument> EncodeMaybeDocument(
+      const model::MutableDocument& maybe_doc,
+      FieldNameDictionary* field_names) const;
+
+  /**
+   * @brief Decodes a MaybeDocument proto produced by the dictionary-encoding
+   * overload of `EncodeMaybeDocument`, resolving field name IDs through
+   * `field_names`. Fails the reader if an ID is unknown to the dictionary.
+   * Modifies the provided proto to release ownership of any Value messages.
+   */
+  model::MutableDocument DecodeMaybeDocument(
+      nanopb::Reader* reader,
+      firestore_client_MaybeDocument& proto,
+      const FieldNameDictionary& field_names) const;
+
   /**
    * @brief Encodes a TargetData to the equivalent nanopb proto, representing a
    * ::firestore::proto::Target, for local storage.
@@ -16,10 +16,12 @@
 
 #include "Firestore/core/src/local/local_store.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Firestore/core/src/credentials/user.h"
 #include "Firestore/core/src/local/bundle_cache.h"
@@ -38,6 +40,7 @@
 #include "Firestore/core/src/model/mutable_document.h"
 #include "Firestore/core/src/model/mutation_batch.h"
 #include "Firestore/core/src/model/mutation_batch_result.h"
+#include "Firestore/core/src/model/object_value.h"
 #include "Firestore/core/src/model/patch_mutation.h"
 #include "Firestore/core/src/remote/remote_event.h"
 #include "Firestore/core/src/util/log.h"
@@ -260,7 +263,7 @@ DocumentMap LocalStore::AcknowledgeBatch(
     document_overlay_cache_->RemoveOverlaysForBatchId(
         batch_result.batch().batch_id());
     local_documents_->RecalculateAndSaveOverlays(
-        GetKeysWithTransformResults(batch_result));
+        GetKeysWithTransformResults(batch_result), batch.batch_id());
 
     return local_documents_->GetDocuments(batch.keys());
   });
@@ -300,7 +303,8 @@ DocumentMap LocalStore::RejectBatch(BatchId batch_id) {
     mutation_queue_->PerformConsistencyCheck();
 
     document_overlay_cache_->RemoveOverlaysForBatchId(batch_id);
-    local_documents_->RecalculateAndSaveOverlays(to_reject.value().keys());
+    local_documents_->RecalculateAndSaveOverlays(to_reject.value().keys(),
+                                                 batch_id);
 
     return local_documents_->GetDocuments(to_reject->keys());
   });
@@ -564,12 +568,33 @@ QueryResult LocalStore::ExecuteQuery(const Query& query,
       remote_keys = target_cache_->GetMatchingKeys(target_data->target_id());
     }
 
+    bool has_all_matches = false;
     model::DocumentMap documents = query_engine_->GetDocumentsMatchingQuery(
         query,
         use_previous_results ? last_limbo_free_snapshot_version
                              : SnapshotVersion::None(),
-        use_previous_results ? remote_keys : DocumentKeySet{});
-    return QueryResult(std::move(documents), std::move(remote_keys));
+        use_previous_results ? remote_keys : DocumentKeySet{},
+        &has_all_matches);
+    return QueryResult(std::move(documents), std::move(remote_keys),
+                       has_all_matches);
+  });
+}
+
+model::ObjectValue LocalStore::ExecuteAggregateQuery(
+    const Query& query, const std::vector<model::AggregateField>& aggregates) {
+  return persistence_->Run("ExecuteAggregateQuery", [&] {
+    absl::optional<TargetData> target_data = GetTargetData(query.ToTarget());
+    SnapshotVersion last_limbo_free_snapshot_version;
+    DocumentKeySet remote_keys;
+
+    if (target_data) {
+      last_limbo_free_snapshot_version =
+          target_data->last_limbo_free_snapshot_version();
+      remote_keys = target_cache_->GetMatchingKeys(target_data->target_id());
+    }
+
+    return query_engine_->GetAggregatesMatchingQuery(
+        query, aggregates, last_limbo_free_snapshot_version, remote_keys);
   });
 }
 
@@ -585,6 +610,13 @@ LruResults LocalStore::CollectGarbage(LruGarbageCollector* garbage_collector) {
   });
 }
 
+LruResults LocalStore::CollectGarbageSlice(
+    LruGarbageCollector* garbage_collector, std::chrono::milliseconds budget) {
+  return persistence_->Run("Collect garbage", [&] {
+    return garbage_collector->CollectSlice(target_data_by_target_, budget);
+  });
+}
+
 int LocalStore::Backfill() const {
   return persistence_->Run("Backfill Indexes", [&] {
     return index_backfiller_->WriteIndexEntries(this);
@@ -725,18 +757,23 @@ LocalStore::DocumentChangeResult LocalStore::PopulateDocumentChanges(
   MutableDocumentMap changed_docs;
   DocumentKeySet condition_changed;
 
-  DocumentKeySet updated_keys;
+  std::vector<DocumentKey> sorted_keys;
+  sorted_keys.reserve(documents.size());
   for (const auto& kv : documents) {
-    updated_keys = updated_keys.insert(kv.first);
+    sorted_keys.push_back(kv.first);
   }
+  std::sort(sorted_keys.begin(), sorted_keys.end());
+  DocumentKeySet updated_keys =
+      DocumentKeySet::FromSorted(sorted_keys.begin(), sorted_keys.end());
   // Each loop iteration only affects its "own" doc, so it's safe to get all
   // the remote documents in advance in a single call.
   MutableDocumentMap existing_docs =
       remote_document_cache_->GetAll(updated_keys);
 
-  for (const auto& kv : documents) {
-    const DocumentKey& key = kv.first;
-    const MutableDocument& doc = kv.second;
+  // `documents` is unordered; walk it in key order so that the writes below
+  // happen in the same order on every run.
+  for (const DocumentKey& key : sorted_keys) {
+    const MutableDocument& doc = documents.find(key)->second;
     MutableDocument existing_doc = *existing_docs.get(key);
     auto search_version = document_versions.find(key);
     const SnapshotVersion& read_time = search_version != document_versions.end()
@@ -17,6 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_LOCAL_STORE_H_
 #define FIRESTORE_CORE_SRC_LOCAL_LOCAL_STORE_H_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -30,6 +31,7 @@
 #include "Firestore/core/src/local/overlay_migration_manager.h"
 #include "Firestore/core/src/local/reference_set.h"
 #include "Firestore/core/src/local/target_data.h"
+#include "Firestore/core/src/model/aggregate_field.h"
 #include "Firestore/core/src/model/document.h"
 #include "Firestore/core/src/model/model_fwd.h"
 #include "absl/types/optional.h"
@@ -224,6 +226,15 @@ class LocalStore : public bundle::BundleCallback {
    */
   QueryResult ExecuteQuery(const core::Query& query, bool use_previous_results);
 
+  /**
+   * Computes the given aggregations over the documents in the local store that
+   * match `query`, reusing target data from previous executions of the query
+   * where possible. Pending local writes are included in the result.
+   */
+  model::ObjectValue ExecuteAggregateQuery(
+      const core::Query& query,
+      const std::vector<model::AggregateField>& aggregates);
+
   /**
    * Notify the local store of the changed views to locally pin / unpin
    * documents.
@@ -250,6 +261,13 @@ class LocalStore : public bundle::BundleCallback {
 
   LruResults CollectGarbage(LruGarbageCollector* garbage_collector);
 
+  /**
+   * Runs one time slice of garbage collection, see
+   * `LruGarbageCollector::CollectSlice`.
+   */
+  LruResults CollectGarbageSlice(LruGarbageCollector* garbage_collector,
+                                 std::chrono::milliseconds budget);
+
   /**
    * Runs a single backfill operation and returns the number of documents
    * processed.
@@ -16,13 +16,16 @@
 
 #include "Firestore/core/src/local/lru_garbage_collector.h"
 
+#include <algorithm>
 #include <chrono>
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Firestore/core/include/firebase/firestore/timestamp.h"
 #include "Firestore/core/src/api/settings.h"
+#include "Firestore/core/src/local/sequence_number_histogram.h"
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/document_key.h"
 #include "Firestore/core/src/util/log.h"
@@ -114,10 +117,34 @@ StatusOr<int64_t> LruGarbageCollector::CalculateByteSize() const {
   return delegate_->CalculateByteSize();
 }
 
-LruResults LruGarbageCollector::Collect(const LiveQueryMap& live_targets) {
+int LruDelegate::RemoveOrphanedDocumentsUntil(
+    ListenSequenceNumber sequence_number,
+    absl::optional<DocumentKey>* resume_key,
+    LruDeadline) {
+  resume_key->reset();
+  return RemoveOrphanedDocuments(sequence_number);
+}
+
+void LruDelegate::EnumerateOrphanedDocumentsUntil(
+    absl::optional<DocumentKey>* resume_key,
+    const OrphanedDocumentCallback& callback,
+    LruDeadline) {
+  resume_key->reset();
+  EnumerateOrphanedDocuments(callback);
+}
+
+const SequenceNumberHistogram* LruDelegate::GetOrphanedDocumentHistogram() {
+  return nullptr;
+}
+
+bool LruDelegate::BuildOrphanedDocumentHistogramUntil(LruDeadline) {
+  return true;
+}
+
+bool LruGarbageCollector::ShouldCollect() const {
   if (params_.min_bytes_threshold == Settings::CacheSizeUnlimited) {
     LOG_DEBUG("Garbage collection skipped; disabled");
-    return LruResults::DidNotRun();
+    return false;
   }
 
   StatusOr<int64_t> maybe_current_size = CalculateByteSize();
@@ -126,7 +153,7 @@ LruResults LruGarbageCollector::Collect(const LiveQueryMap& live_targets) {
         "Garbage collection skipped; failed to estimate the size of the "
         "cache: %s",
         maybe_current_size.status().ToString());
-    return LruResults::DidNotRun();
+    return false;
   }
 
   int64_t current_size = maybe_current_size.ValueOrDie();
@@ -135,13 +162,108 @@ LruResults LruGarbageCollector::Collect(const LiveQueryMap& live_targets) {
     LOG_DEBUG(
         "Garbage collection skipped; Cache size %s is lower than threshold %s",
         current_size, params_.min_bytes_threshold);
-    return LruResults::DidNotRun();
+    return false;
   }
 
   LOG_DEBUG("Running garbage collection on cache of size: %s", current_size);
+  return true;
+}
+
+LruResults LruGarbageCollector::Collect(const LiveQueryMap& live_targets) {
+  if (!ShouldCollect()) {
+    return LruResults::DidNotRun();
+  }
+
   return RunGarbageCollection(live_targets);
 }
 
+LruResults LruGarbageCollector::CollectSlice(const LiveQueryMap& live_targets,
+                                             std::chrono::milliseconds budget) {
+  LruDeadline deadline = std::chrono::steady_clock::now() + budget;
+
+  if (!pending_collection_) {
+    if (!ShouldCollect()) {
+      return LruResults::DidNotRun();
+    }
+    pending_collection_ = PendingCollection{};
+  }
+
+  PendingCollection& collection = *pending_collection_;
+  if (!collection.counted) {
+    if (!delegate_->BuildOrphanedDocumentHistogramUntil(deadline)) {
+      return LruResults::DidNotRun();
+    }
+
+    const SequenceNumberHistogram* orphaned_documents =
+        delegate_->GetOrphanedDocumentHistogram();
+    if (orphaned_documents) {
+      collection.histogram = *orphaned_documents;
+    } else {
+      SequenceNumberHistogram& histogram = collection.histogram;
+      delegate_->EnumerateOrphanedDocumentsUntil(
+          &collection.resume_key,
+          [&histogram](const DocumentKey&,
+                       ListenSequenceNumber sequence_number) {
+            histogram.Add(sequence_number);
+          },
+          deadline);
+      if (collection.resume_key) {
+        return LruResults::DidNotRun();
+      }
+    }
+
+    // Targets are few compared to documents, so they are all removed at once.
+    RemoveTargetsForCollection(&collection, live_targets);
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return LruResults::DidNotRun();
+    }
+  }
+
+  // Documents touched since the collection started carry newer sequence
+  // numbers, and documents that gained a reference are no longer orphaned, so
+  // resuming with the original cutoff never removes a document in use.
+  collection.results.documents_removed +=
+      delegate_->RemoveOrphanedDocumentsUntil(
+          collection.upper_bound, &collection.resume_key, deadline);
+  if (collection.resume_key) {
+    return LruResults::DidNotRun();
+  }
+
+  LruResults results = collection.results;
+  pending_collection_.reset();
+  LOG_DEBUG(
+      "LRU Garbage Collection: collected %s sequence numbers, removed %s "
+      "targets and %s documents",
+      results.sequence_numbers_collected, results.targets_removed,
+      results.documents_removed);
+  return results;
+}
+
+void LruGarbageCollector::RemoveTargetsForCollection(
+    PendingCollection* collection, const LiveQueryMap& live_targets) {
+  std::vector<ListenSequenceNumber> target_sequence_numbers;
+  delegate_->EnumerateTargetSequenceNumbers(
+      [&](ListenSequenceNumber sequence_number) {
+        target_sequence_numbers.push_back(sequence_number);
+      });
+  std::sort(target_sequence_numbers.begin(), target_sequence_numbers.end());
+
+  size_t total_count = target_sequence_numbers.size() +
+                       static_cast<size_t>(collection->histogram.total_count());
+  int sequence_numbers = std::min(
+      static_cast<int>((params_.percentile_to_collect / 100.0f) * total_count),
+      params_.maximum_sequence_numbers_to_collect);
+  if (sequence_numbers > 0) {
+    collection->upper_bound = collection->histogram.NthSequenceNumber(
+        sequence_numbers, target_sequence_numbers);
+  }
+
+  collection->counted = true;
+  collection->results = LruResults{
+      /* did_run= */ true, sequence_numbers,
+      RemoveTargets(collection->upper_bound, live_targets), 0};
+}
+
 LruResults LruGarbageCollector::RunGarbageCollection(
     const LiveQueryMap& live_targets) {
   Timestamp start = Timestamp::Now();
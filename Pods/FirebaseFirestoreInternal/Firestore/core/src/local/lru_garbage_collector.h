@@ -17,13 +17,17 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_LRU_GARBAGE_COLLECTOR_H_
 #define FIRESTORE_CORE_SRC_LOCAL_LRU_GARBAGE_COLLECTOR_H_
 
+#include <chrono>
 #include <unordered_map>
 
 #include "Firestore/core/src/local/reference_delegate.h"
+#include "Firestore/core/src/local/sequence_number_histogram.h"
 #include "Firestore/core/src/local/target_cache.h"
 #include "Firestore/core/src/local/target_data.h"
+#include "Firestore/core/src/model/document_key.h"
 #include "Firestore/core/src/model/types.h"
 #include "Firestore/core/src/util/status_fwd.h"
+#include "absl/types/optional.h"
 
 namespace firebase {
 namespace firestore {
@@ -60,6 +64,8 @@ struct LruResults {
 
 using LiveQueryMap = std::unordered_map<model::TargetId, TargetData>;
 
+using LruDeadline = std::chrono::steady_clock::time_point;
+
 /**
  * Persistence layers intending to use LRU Garbage collection should implement
  * this interface. This interface defines the operations that the LRU garbage
@@ -90,6 +96,20 @@ class LruDelegate : public ReferenceDelegate {
   virtual void EnumerateOrphanedDocuments(
       const OrphanedDocumentCallback& callback) = 0;
 
+  /**
+   * Enumerates orphaned documents like `EnumerateOrphanedDocuments`, but starts
+   * at the document with `*resume_key` (or the first document if it's empty)
+   * and stops once `deadline` has passed. Sets `*resume_key` to the first
+   * document that wasn't enumerated, or resets it once all documents were
+   * enumerated.
+   *
+   * The default implementation enumerates all documents in one go.
+   */
+  virtual void EnumerateOrphanedDocumentsUntil(
+      absl::optional<model::DocumentKey>* resume_key,
+      const OrphanedDocumentCallback& callback,
+      LruDeadline deadline);
+
   /**
    * Removes all unreferenced documents from the cache that have a sequence
    * number less than or equal to the given sequence number. Returns the number
@@ -98,6 +118,20 @@ class LruDelegate : public ReferenceDelegate {
   virtual int RemoveOrphanedDocuments(
       model::ListenSequenceNumber sequence_number) = 0;
 
+  /**
+   * Removes unreferenced documents like `RemoveOrphanedDocuments`, but starts
+   * at the document with `*resume_key` (or the first document if it's empty)
+   * and stops once `deadline` has passed. Sets `*resume_key` to the first
+   * document that wasn't examined, or resets it once all documents were
+   * examined.
+   *
+   * The default implementation removes all documents in one go.
+   */
+  virtual int RemoveOrphanedDocumentsUntil(
+      model::ListenSequenceNumber sequence_number,
+      absl::optional<model::DocumentKey>* resume_key,
+      LruDeadline deadline);
+
   /**
    * Removes all targets that are not currently being listened to and have a
    * sequence number less than or equal to the given sequence number. Returns
@@ -105,6 +139,25 @@ class LruDelegate : public ReferenceDelegate {
    */
   virtual int RemoveTargets(model::ListenSequenceNumber sequence_number,
                             const LiveQueryMap& live_queries) = 0;
+
+  /**
+   * Returns the histogram of the sequence numbers of all orphaned documents if
+   * the delegate keeps one up to date, so that garbage collection doesn't have
+   * to enumerate the orphaned documents. Returns nullptr otherwise, or while
+   * the histogram is still being built.
+   *
+   * The default implementation keeps no histogram.
+   */
+  virtual const SequenceNumberHistogram* GetOrphanedDocumentHistogram();
+
+  /**
+   * Continues building the histogram returned by
+   * `GetOrphanedDocumentHistogram` until `deadline` has passed, if the delegate
+   * keeps one but hasn't built it yet. Returns false while there is work left.
+   *
+   * The default implementation has nothing to build and returns true.
+   */
+  virtual bool BuildOrphanedDocumentHistogramUntil(LruDeadline deadline);
 };
 
 /**
@@ -147,6 +200,29 @@ class LruGarbageCollector {
 
   local::LruResults Collect(const LiveQueryMap& live_targets);
 
+  /**
+   * Runs garbage collection in time slices: like `Collect`, but stops once
+   * `budget` has elapsed and leaves the remaining work to subsequent calls.
+   * While `collection_in_progress()`, calls resume the pending collection
+   * instead of starting a new one.
+   *
+   * The cutoff is read from the delegate's histogram of the sequence numbers
+   * of the orphaned documents. Delegates that don't keep one have their
+   * orphaned documents counted into a histogram first. The targets and the
+   * orphaned documents up to the cutoff are then removed. All passes over the
+   * documents are split into slices.
+   *
+   * Returns the results of the collection once it completes, and
+   * `LruResults::DidNotRun()` for slices that leave work pending.
+   */
+  local::LruResults CollectSlice(const LiveQueryMap& live_targets,
+                                 std::chrono::milliseconds budget);
+
+  /** Whether a collection started by `CollectSlice` has work pending. */
+  bool collection_in_progress() const {
+    return pending_collection_.has_value();
+  }
+
   /**
    * Visible for testing only!
    */
@@ -155,12 +231,35 @@ class LruGarbageCollector {
   }
 
  private:
+  /** The state of a collection run by `CollectSlice`. */
+  struct PendingCollection {
+    // Whether all orphaned documents were added to `histogram`, and the
+    // targets were removed.
+    bool counted = false;
+    SequenceNumberHistogram histogram;
+    model::ListenSequenceNumber upper_bound = kListenSequenceNumberInvalid;
+    absl::optional<model::DocumentKey> resume_key;
+    LruResults results = LruResults::DidNotRun();
+  };
+
+  /** Returns true if the cache is large enough to warrant collection. */
+  bool ShouldCollect() const;
+
   LruResults RunGarbageCollection(const LiveQueryMap& live_targets);
 
+  /**
+   * Computes the cutoff from the histogram of orphaned documents in
+   * `collection` and removes the targets up to it.
+   */
+  void RemoveTargetsForCollection(PendingCollection* collection,
+                                  const LiveQueryMap& live_targets);
+
   // Delegate owns the LruGarbageCollector; this is a back pointer.
   LruDelegate* delegate_;
 
   LruParams params_ = LruParams::Default();
+
+  absl::optional<PendingCollection> pending_collection_;
 };
 
 }  // namespace local
@@ -28,6 +28,15 @@ void MemoryGlobalsCache::SetSessionToken(const ByteString& session_token) {
   session_token_ = session_token;
 }
 
+ByteString MemoryGlobalsCache::GetSequenceNumberHistogram() const {
+  return sequence_number_histogram_;
+}
+
+void MemoryGlobalsCache::SetSequenceNumberHistogram(
+    const ByteString& histogram) {
+  sequence_number_histogram_ = histogram;
+}
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
@@ -38,8 +38,19 @@ class MemoryGlobalsCache : public GlobalsCache {
    */
   void SetSessionToken(const ByteString& session_token) override;
 
+  /**
+   * Gets the encoded sequence number histogram.
+   */
+  ByteString GetSequenceNumberHistogram() const override;
+
+  /**
+   * Sets the encoded sequence number histogram.
+   */
+  void SetSequenceNumberHistogram(const ByteString& histogram) override;
+
  private:
   ByteString session_token_;
+  ByteString sequence_number_histogram_;
 };
 
 }  // namespace local
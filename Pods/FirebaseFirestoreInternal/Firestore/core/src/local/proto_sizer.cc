@@ -21,7 +21,6 @@
 #include "Firestore/Protos/nanopb/firestore/local/maybe_document.nanopb.h"
 #include "Firestore/core/src/model/document_key.h"
 #include "Firestore/core/src/model/mutable_document.h"
-#include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/nanopb/message.h"
 
 namespace firebase {
@@ -35,19 +34,15 @@ ProtoSizer::ProtoSizer(LocalSerializer serializer)
 }
 
 int64_t ProtoSizer::CalculateByteSize(const MutableDocument& maybe_doc) const {
-  // TODO(varconst): implement a version of `nanopb::Writer` that only
-  // calculates sizes without actually doing the encoding (to the extent
-  // possible). This isn't high priority as long as `ProtoSizer` is only used in
-  // tests.
-  return MakeByteString(serializer_.EncodeMaybeDocument(maybe_doc)).size();
+  return EncodedSize(serializer_.EncodeMaybeDocument(maybe_doc));
 }
 
 int64_t ProtoSizer::CalculateByteSize(const model::MutationBatch& batch) const {
-  return MakeByteString(serializer_.EncodeMutationBatch(batch)).size();
+  return EncodedSize(serializer_.EncodeMutationBatch(batch));
 }
 
 int64_t ProtoSizer::CalculateByteSize(const TargetData& target_data) const {
-  return MakeByteString(serializer_.EncodeTargetData(target_data)).size();
+  return EncodedSize(serializer_.EncodeTargetData(target_data));
 }
 
 }  // namespace local
@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/local/query_engine.h"
 
+#include <cstdint>
+#include <limits>
 #include <utility>
 
 #include "Firestore/core/src/core/query.h"
@@ -25,7 +27,10 @@
 #include "Firestore/core/src/model/document.h"
 #include "Firestore/core/src/model/document_set.h"
 #include "Firestore/core/src/model/mutable_document.h"
+#include "Firestore/core/src/model/object_value.h"
 #include "Firestore/core/src/model/snapshot_version.h"
+#include "Firestore/core/src/model/value_util.h"
+#include "Firestore/core/src/nanopb/message.h"
 #include "Firestore/core/src/util/log.h"
 
 namespace firebase {
@@ -44,6 +49,102 @@ static const int kDefaultIndexAutoCreationMinCollectionSize = 100;
  */
 
 static const double KDefaultRelativeIndexReadCostPerDocument = 3.4;
+
+using model::AggregateField;
+using nanopb::Message;
+
+/**
+ * Accumulates a single aggregation over the documents of a query result,
+ * following the backend's semantics: count counts every document, while sum
+ * and average only consider documents whose field holds a number.
+ */
+class AggregateAccumulator {
+ public:
+  explicit AggregateAccumulator(const AggregateField& aggregate)
+      : aggregate_(aggregate) {
+  }
+
+  void Add(const model::Document& doc) {
+    if (aggregate_.op == AggregateField::OpKind::Count) {
+      ++count_;
+      return;
+    }
+
+    absl::optional<google_firestore_v1_Value> value =
+        doc->field(aggregate_.fieldPath);
+    if (model::IsInteger(value)) {
+      AddInteger(value->integer_value);
+    } else if (model::IsDouble(value)) {
+      AddDouble(value->double_value);
+    }
+  }
+
+  Message<google_firestore_v1_Value> Result() const {
+    Message<google_firestore_v1_Value> result;
+    switch (aggregate_.op) {
+      case AggregateField::OpKind::Count:
+        result->which_value_type = google_firestore_v1_Value_integer_value_tag;
+        result->integer_value = count_;
+        break;
+
+      case AggregateField::OpKind::Sum:
+        // The sum stays an integer as long as all summands are integers and
+        // the sum fits into 64 bits. The sum of no values is integer zero.
+        if (!has_double_ && !integer_overflow_) {
+          result->which_value_type =
+              google_firestore_v1_Value_integer_value_tag;
+          result->integer_value = integer_sum_;
+        } else {
+          result->which_value_type = google_firestore_v1_Value_double_value_tag;
+          result->double_value = double_sum_;
+        }
+        break;
+
+      case AggregateField::OpKind::Avg:
+        if (count_ == 0) {
+          return Message<google_firestore_v1_Value>(model::NullValue());
+        }
+        result->which_value_type = google_firestore_v1_Value_double_value_tag;
+        result->double_value =
+            (!has_double_ && !integer_overflow_
+                 ? static_cast<double>(integer_sum_)
+                 : double_sum_) /
+            static_cast<double>(count_);
+        break;
+    }
+    return result;
+  }
+
+ private:
+  void AddInteger(int64_t value) {
+    ++count_;
+    double_sum_ += static_cast<double>(value);
+    if (integer_overflow_) return;
+
+    if ((value > 0 &&
+         integer_sum_ > std::numeric_limits<int64_t>::max() - value) ||
+        (value < 0 &&
+         integer_sum_ < std::numeric_limits<int64_t>::min() - value)) {
+      integer_overflow_ = true;
+    } else {
+      integer_sum_ += value;
+    }
+  }
+
+  void AddDouble(double value) {
+    ++count_;
+    double_sum_ += value;
+    has_double_ = true;
+  }
+
+  const AggregateField& aggregate_;
+  int64_t count_ = 0;
+  int64_t integer_sum_ = 0;
+  double double_sum_ = 0;
+  bool has_double_ = false;
+  bool integer_overflow_ = false;
+};
+
 }  // namespace
 
 using core::LimitType;
@@ -67,10 +168,16 @@ void QueryEngine::Initialize(LocalDocumentsView* local_documents) {
 const DocumentMap QueryEngine::GetDocumentsMatchingQuery(
     const Query& query,
     const SnapshotVersion& last_limbo_free_snapshot_version,
-    const DocumentKeySet& remote_keys) const {
+    const DocumentKeySet& remote_keys,
+    bool* has_all_matches) const {
   HARD_ASSERT(local_documents_view_ && index_manager_,
               "Initialize() not called");
 
+  // Index lookups and previous results are only complete up to the limit.
+  if (has_all_matches) {
+    *has_all_matches = !query.has_limit();
+  }
+
   const absl::optional<DocumentMap> index_result =
       PerformQueryUsingIndex(query);
   if (index_result.has_value()) {
@@ -88,9 +195,62 @@ const DocumentMap QueryEngine::GetDocumentsMatchingQuery(
   if (index_auto_creation_enabled_) {
     CreateCacheIndexes(query, context.value(), full_scan_result.size());
   }
+  if (has_all_matches) {
+    *has_all_matches = true;
+  }
   return full_scan_result;
 }
 
+model::ObjectValue QueryEngine::GetAggregatesMatchingQuery(
+    const Query& query,
+    const std::vector<AggregateField>& aggregates,
+    const SnapshotVersion& last_limbo_free_snapshot_version,
+    const DocumentKeySet& remote_keys) const {
+  const DocumentMap documents = GetDocumentsMatchingQuery(
+      query, last_limbo_free_snapshot_version, remote_keys);
+
+  std::vector<AggregateAccumulator> accumulators;
+  accumulators.reserve(aggregates.size());
+  for (const AggregateField& aggregate : aggregates) {
+    accumulators.emplace_back(aggregate);
+  }
+  auto accumulate = [&accumulators](const Document& doc) {
+    for (AggregateAccumulator& accumulator : accumulators) {
+      accumulator.Add(doc);
+    }
+  };
+
+  if (!query.has_limit()) {
+    // Every document in the result matches the query, and aggregations do not
+    // depend on order, so there is no need to sort.
+    for (const auto& entry : documents) {
+      accumulate(entry.second);
+    }
+  } else {
+    // The limit selects documents by their position in the query's order, so
+    // only a limited query has to pay for sorting its result.
+    DocumentSet sorted = ApplyQuery(query, documents);
+    size_t limit = static_cast<size_t>(query.limit());
+    size_t skip = query.limit_type() == LimitType::Last && sorted.size() > limit
+                      ? sorted.size() - limit
+                      : 0;
+    size_t position = 0;
+    for (const Document& doc : sorted) {
+      if (position >= skip + limit) break;
+      if (position++ >= skip) {
+        accumulate(doc);
+      }
+    }
+  }
+
+  model::ObjectValue result;
+  for (size_t i = 0; i < aggregates.size(); ++i) {
+    result.Set(model::FieldPath{aggregates[i].alias.StringValue()},
+               accumulators[i].Result());
+  }
+  return result;
+}
+
 void QueryEngine::CreateCacheIndexes(const core::Query& query,
                                      const QueryContext& context,
                                      size_t result_size) const {
@@ -17,6 +17,9 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_QUERY_ENGINE_H_
 #define FIRESTORE_CORE_SRC_LOCAL_QUERY_ENGINE_H_
 
+#include <vector>
+
+#include "Firestore/core/src/model/aggregate_field.h"
 #include "Firestore/core/src/model/model_fwd.h"
 
 namespace firebase {
@@ -74,9 +77,34 @@ class QueryEngine {
    */
   virtual void Initialize(LocalDocumentsView* local_documents);
 
+  /**
+   * Returns the documents in the cache that match `query`, including the
+   * effect of any pending local writes.
+   *
+   * For a query with a limit, the result may leave out documents that sort
+   * past the limit. If `has_all_matches` is given, it is set to whether the
+   * result contains every matching document instead, so that callers can
+   * hold on to the documents past the limit.
+   */
   const model::DocumentMap GetDocumentsMatchingQuery(
       const core::Query& query,
       const model::SnapshotVersion& last_limbo_free_snapshot_version,
+      const model::DocumentKeySet& remote_keys,
+      bool* has_all_matches = nullptr) const;
+
+  /**
+   * Computes the given aggregations over the documents in the cache that match
+   * `query`, including the effect of any pending local writes.
+   *
+   * The documents are found the same way as for `GetDocumentsMatchingQuery`,
+   * but are never sorted unless the query has a limit. The result has the same
+   * shape as a server aggregation result: a map from each aggregation's alias
+   * to its value.
+   */
+  model::ObjectValue GetAggregatesMatchingQuery(
+      const core::Query& query,
+      const std::vector<model::AggregateField>& aggregates,
+      const model::SnapshotVersion& last_limbo_free_snapshot_version,
       const model::DocumentKeySet& remote_keys) const;
 
   void SetIndexAutoCreationEnabled(bool is_enabled);
@@ -34,8 +34,12 @@ class QueryResult {
   QueryResult() = default;
 
   /** Creates a new QueryResult with the given values. */
-  QueryResult(model::DocumentMap documents, model::DocumentKeySet remote_keys)
-      : documents_{std::move(documents)}, remote_keys_{std::move(remote_keys)} {
+  QueryResult(model::DocumentMap documents,
+              model::DocumentKeySet remote_keys,
+              bool has_all_matches = false)
+      : documents_{std::move(documents)},
+        remote_keys_{std::move(remote_keys)},
+        has_all_matches_{has_all_matches} {
   }
 
   const model::DocumentMap& documents() const {
@@ -46,9 +50,18 @@ class QueryResult {
     return remote_keys_;
   }
 
+  /**
+   * Whether `documents()` holds every cached document that matches the query,
+   * including the ones that sort past its limit.
+   */
+  bool has_all_matches() const {
+    return has_all_matches_;
+  }
+
  private:
   model::DocumentMap documents_;
   model::DocumentKeySet remote_keys_;
+  bool has_all_matches_ = false;
 };
 
 }  // namespace local
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/sequence_number_histogram.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Firestore/core/src/util/ordered_code.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+using model::ListenSequenceNumber;
+using util::OrderedCode;
+
+constexpr size_t SequenceNumberHistogram::kMaxBuckets;
+
+void SequenceNumberHistogram::Add(ListenSequenceNumber sequence_number) {
+  ++buckets_[sequence_number / bucket_width_];
+  ++total_count_;
+  largest_ = std::max(largest_, sequence_number);
+  if (buckets_.size() > kMaxBuckets) {
+    Coarsen();
+  }
+}
+
+void SequenceNumberHistogram::Remove(ListenSequenceNumber sequence_number) {
+  // Coarsening halves bucket indexes, so a sequence number still maps to the
+  // bucket that absorbed the one it was added to.
+  auto found = buckets_.find(sequence_number / bucket_width_);
+  if (found == buckets_.end()) {
+    return;
+  }
+
+  --total_count_;
+  if (--found->second == 0) {
+    buckets_.erase(found);
+  }
+}
+
+void SequenceNumberHistogram::Coarsen() {
+  while (buckets_.size() > kMaxBuckets) {
+    std::map<int64_t, int64_t> merged;
+    for (const auto& bucket : buckets_) {
+      merged[bucket.first / 2] += bucket.second;
+    }
+    buckets_ = std::move(merged);
+    bucket_width_ *= 2;
+  }
+}
+
+ListenSequenceNumber SequenceNumberHistogram::NthSequenceNumber(
+    int64_t n, const std::vector<ListenSequenceNumber>& additional) const {
+  ListenSequenceNumber last = 0;
+  auto next_additional = additional.begin();
+
+  for (const auto& bucket : buckets_) {
+    ListenSequenceNumber lower = bucket.first * bucket_width_;
+    ListenSequenceNumber upper = lower + bucket_width_ - 1;
+
+    for (; next_additional != additional.end() && *next_additional < lower;
+         ++next_additional) {
+      last = *next_additional;
+      if (--n == 0) {
+        return last;
+      }
+    }
+
+    if (bucket.second >= n) {
+      // The sequence numbers within a bucket are unknown, so the lower bound
+      // is the only cutoff that never exceeds the exact one.
+      return lower;
+    }
+    n -= bucket.second;
+    last = std::min(upper, largest_);
+  }
+
+  for (; next_additional != additional.end(); ++next_additional) {
+    last = std::max(last, *next_additional);
+    if (--n == 0) {
+      break;
+    }
+  }
+  return last;
+}
+
+std::string SequenceNumberHistogram::Encode() const {
+  std::string result;
+  OrderedCode::WriteSignedNumIncreasing(&result, bucket_width_);
+  OrderedCode::WriteSignedNumIncreasing(&result, largest_);
+  for (const auto& bucket : buckets_) {
+    OrderedCode::WriteSignedNumIncreasing(&result, bucket.first);
+    OrderedCode::WriteSignedNumIncreasing(&result, bucket.second);
+  }
+  return result;
+}
+
+absl::optional<SequenceNumberHistogram> SequenceNumberHistogram::Decode(
+    absl::string_view encoded) {
+  SequenceNumberHistogram result;
+  if (!OrderedCode::ReadSignedNumIncreasing(&encoded, &result.bucket_width_) ||
+      result.bucket_width_ <= 0 ||
+      !OrderedCode::ReadSignedNumIncreasing(&encoded, &result.largest_)) {
+    return absl::nullopt;
+  }
+
+  while (!encoded.empty()) {
+    int64_t index = 0;
+    int64_t count = 0;
+    if (!OrderedCode::ReadSignedNumIncreasing(&encoded, &index) ||
+        !OrderedCode::ReadSignedNumIncreasing(&encoded, &count) || count <= 0) {
+      return absl::nullopt;
+    }
+    result.buckets_[index] = count;
+    result.total_count_ += count;
+  }
+
+  result.Coarsen();
+  return result;
+}
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
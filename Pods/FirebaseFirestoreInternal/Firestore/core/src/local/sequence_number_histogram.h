@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_LOCAL_SEQUENCE_NUMBER_HISTOGRAM_H_
+#define FIRESTORE_CORE_SRC_LOCAL_SEQUENCE_NUMBER_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Firestore/core/src/model/types.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+/**
+ * An approximate, bounded-size histogram of listen sequence numbers.
+ *
+ * Sequence numbers are counted in buckets of equal width. Whenever the number
+ * of buckets would exceed `kMaxBuckets`, the bucket width is doubled and
+ * neighboring buckets are merged, so the histogram stays small no matter how
+ * many sequence numbers it counts or how far apart they are.
+ *
+ * Used by the LRU garbage collector to find the sequence number cutoff for a
+ * percentile of the cache without enumerating the orphaned documents.
+ */
+class SequenceNumberHistogram {
+ public:
+  static constexpr size_t kMaxBuckets = 128;
+
+  SequenceNumberHistogram() = default;
+
+  /** Counts an occurrence of `sequence_number`. */
+  void Add(model::ListenSequenceNumber sequence_number);
+
+  /**
+   * Removes an occurrence of `sequence_number` previously counted by `Add`.
+   * Removing a sequence number whose bucket is already empty is a no-op.
+   */
+  void Remove(model::ListenSequenceNumber sequence_number);
+
+  /** The number of sequence numbers currently counted. */
+  int64_t total_count() const {
+    return total_count_;
+  }
+
+  /**
+   * Returns the approximate `n`th smallest (1-based) sequence number among
+   * the sequence numbers in this histogram together with `additional`, which
+   * must be sorted in ascending order. If the `n`th sequence number falls into
+   * a bucket, returns the bucket's lower bound, so the result never exceeds
+   * the exact `n`th sequence number.
+   *
+   * Returns the largest known sequence number if there are fewer than `n`.
+   */
+  model::ListenSequenceNumber NthSequenceNumber(
+      int64_t n,
+      const std::vector<model::ListenSequenceNumber>& additional) const;
+
+  /** Serializes the histogram for storage in the `GlobalsCache`. */
+  std::string Encode() const;
+
+  /**
+   * Deserializes a histogram written by `Encode`. Returns an empty optional if
+   * `encoded` is malformed.
+   */
+  static absl::optional<SequenceNumberHistogram> Decode(
+      absl::string_view encoded);
+
+ private:
+  /** Doubles the bucket width until there are at most `kMaxBuckets`. */
+  void Coarsen();
+
+  int64_t bucket_width_ = 1;
+  int64_t total_count_ = 0;
+
+  // The largest sequence number ever added. `Remove` leaves it unchanged, so
+  // it's an upper bound rather than the exact maximum.
+  model::ListenSequenceNumber largest_ = 0;
+
+  // Maps a bucket index (sequence_number / bucket_width_) to its count. Empty
+  // buckets are not stored.
+  std::map<int64_t, int64_t> buckets_;
+};
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_LOCAL_SEQUENCE_NUMBER_HISTOGRAM_H_
@@ -20,13 +20,16 @@
 #include <algorithm>
 #include <cctype>
 #include <initializer_list>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "Firestore/core/src/model/path_segment.h"
 #include "Firestore/core/src/util/comparison.h"
 #include "Firestore/core/src/util/hard_assert.h"
 #include "Firestore/core/src/util/hashing.h"
+#include "Firestore/core/src/util/iterator_adaptors.h"
 
 namespace firebase {
 namespace firestore {
@@ -40,6 +43,10 @@ namespace impl {
  * BasePath is reassignable and movable. Apart from those, all other mutating
  * operations return new independent instances.
  *
+ * Segments are interned (see `PathSegment`): their strings are shared with
+ * every other path that contains them, and comparing them for equality is a
+ * pointer comparison.
+ *
  * ## Subclassing Notes
  *
  * BasePath is strictly meant as a base class for concrete implementations. It
@@ -52,25 +59,26 @@ template <typename T>
 class BasePath {
  protected:
   using SegmentsT = std::vector<std::string>;
+  using StorageT = std::vector<PathSegment>;
 
  public:
-  using const_iterator = SegmentsT::const_iterator;
+  using const_iterator = util::iterator_ptr<StorageT::const_iterator>;
 
   /** Returns i-th segment of the path. */
   const std::string& operator[](const size_t i) const {
     HARD_ASSERT(i < segments_.size(), "index %s out of range", i);
-    return segments_[i];
+    return *segments_[i];
   }
 
   /** Returns the first segment of the path. */
   const std::string& first_segment() const {
     HARD_ASSERT(!empty(), "Cannot call first_segment on empty path");
-    return segments_[0];
+    return *segments_[0];
   }
   /** Returns the last segment of the path. */
   const std::string& last_segment() const {
     HARD_ASSERT(!empty(), "Cannot call last_segment on empty path");
-    return segments_[size() - 1];
+    return *segments_[size() - 1];
   }
 
   size_t size() const {
@@ -92,13 +100,10 @@ class BasePath {
    * additional segment.
    */
   T Append(const std::string& segment) const {
-    auto appended = segments_;
-    appended.push_back(segment);
-    return T{std::move(appended)};
-  }
-  T Append(std::string&& segment) const {
-    auto appended = segments_;
-    appended.push_back(std::move(segment));
+    StorageT appended;
+    appended.reserve(segments_.size() + 1);
+    appended.insert(appended.end(), segments_.begin(), segments_.end());
+    appended.emplace_back(segment);
     return T{std::move(appended)};
   }
 
@@ -107,8 +112,11 @@ class BasePath {
    * another path.
    */
   T Append(const T& path) const {
-    auto appended = segments_;
-    appended.insert(appended.end(), path.begin(), path.end());
+    StorageT appended;
+    appended.reserve(segments_.size() + path.segments_.size());
+    appended.insert(appended.end(), segments_.begin(), segments_.end());
+    appended.insert(appended.end(), path.segments_.begin(),
+                    path.segments_.end());
     return T{std::move(appended)};
   }
 
@@ -119,7 +127,7 @@ class BasePath {
   T PopFirst(const size_t n = 1) const {
     HARD_ASSERT(n <= size(), "Cannot call PopFirst(%s) on path of length %s", n,
                 size());
-    return T{begin() + n, end()};
+    return T{StorageT{segments_.begin() + n, segments_.end()}};
   }
 
   /**
@@ -128,7 +136,7 @@ class BasePath {
    */
   T PopLast() const {
     HARD_ASSERT(!empty(), "Cannot call PopLast() on empty path");
-    return T{begin(), end() - 1};
+    return T{StorageT{segments_.begin(), segments_.end() - 1}};
   }
 
   /**
@@ -137,7 +145,9 @@ class BasePath {
    * Empty path is a prefix of any path. Any path is a prefix of itself.
    */
   bool IsPrefixOf(const T& rhs) const {
-    return size() <= rhs.size() && std::equal(begin(), end(), rhs.begin());
+    return size() <= rhs.size() &&
+           std::equal(segments_.begin(), segments_.end(),
+                      rhs.segments_.begin());
   }
 
   /**
@@ -147,7 +157,8 @@ class BasePath {
    */
   bool IsImmediateParentOf(const T& potential_child) const {
     return size() + 1 == potential_child.size() &&
-           std::equal(begin(), end(), potential_child.begin());
+           std::equal(segments_.begin(), segments_.end(),
+                      potential_child.segments_.begin());
   }
 
   /**
@@ -175,23 +186,42 @@ class BasePath {
  protected:
   BasePath() = default;
   template <typename IterT>
-  BasePath(const IterT begin, const IterT end) : segments_{begin, end} {
+  BasePath(const IterT begin, const IterT end) {
+    segments_.reserve(std::distance(begin, end));
+    for (IterT it = begin; it != end; ++it) {
+      segments_.emplace_back(*it);
+    }
   }
-  BasePath(std::initializer_list<std::string> list) : segments_{list} {
+  /** Shares the segments of another path. */
+  BasePath(const const_iterator begin, const const_iterator end)
+      : segments_{begin.base(), end.base()} {
   }
-  explicit BasePath(SegmentsT&& segments) : segments_{std::move(segments)} {
+  BasePath(std::initializer_list<std::string> list)
+      : BasePath{list.begin(), list.end()} {
+  }
+  explicit BasePath(const SegmentsT& segments)
+      : BasePath{segments.begin(), segments.end()} {
+  }
+  explicit BasePath(StorageT&& segments) : segments_{std::move(segments)} {
   }
 
  private:
-  SegmentsT segments_;
+  StorageT segments_;
 
   static const size_t kNumericIdPrefixLength = 4;
   static const size_t kNumericIdSuffixLength = 2;
   static const size_t kNumericIdTotalOverhead =
       kNumericIdPrefixLength + kNumericIdSuffixLength;
 
-  static util::ComparisonResult CompareSegments(const std::string& lhs,
-                                                const std::string& rhs) {
+  static util::ComparisonResult CompareSegments(
+      const PathSegment& lhs_segment, const PathSegment& rhs_segment) {
+    // Interned segments are equal iff they are the same string.
+    if (lhs_segment == rhs_segment) {
+      return util::ComparisonResult::Same;
+    }
+
+    const std::string& lhs = *lhs_segment;
+    const std::string& rhs = *rhs_segment;
     bool isLhsNumeric = IsNumericId(lhs);
     bool isRhsNumeric = IsNumericId(rhs);
 
@@ -58,6 +58,14 @@ class FieldPath : public impl::BasePath<FieldPath>,
   explicit FieldPath(SegmentsT&& segments) : BasePath{std::move(segments)} {
   }
 
+ private:
+  friend class impl::BasePath<FieldPath>;
+
+  explicit FieldPath(StorageT&& segments) : BasePath{std::move(segments)} {
+  }
+
+ public:
+
   /**
    * Creates and returns a new path from a dot-separated field-path string,
    * where path segments are separated by a dot ".".
@@ -22,6 +22,7 @@
 #include <unordered_map>
 
 #include "Firestore/Protos/nanopb/google/firestore/v1/document.nanopb.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 
 namespace firebase {
@@ -104,8 +105,9 @@ using DocumentMap =
 using DocumentVersionMap =
     std::unordered_map<DocumentKey, SnapshotVersion, DocumentKeyHash>;
 
+// Iteration order is unspecified; callers that need key order sort the keys.
 using DocumentUpdateMap =
-    std::unordered_map<DocumentKey, MutableDocument, DocumentKeyHash>;
+    absl::flat_hash_map<DocumentKey, MutableDocument, DocumentKeyHash>;
 
 using OverlayedDocumentMap = std::unordered_map<model::DocumentKey,
                                                 model::OverlayedDocument,
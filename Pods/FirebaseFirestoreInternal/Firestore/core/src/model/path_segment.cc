@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/model/path_segment.h"
+
+#include <array>
+#include <mutex>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "Firestore/core/src/util/no_destructor.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+
+namespace firebase {
+namespace firestore {
+namespace model {
+namespace impl {
+
+using util::NoDestructor;
+
+/**
+ * The process-wide set of interned segments, keyed by their contents and split
+ * into `kShardCount` shards by hash.
+ *
+ * The pool doesn't own a reference to its entries: an entry is removed when
+ * its reference count drops to zero. To make that safe, the count only ever
+ * goes from zero to one (in `Intern`) or from one to zero (in `Release`) with
+ * the lock of the entry's shard held.
+ */
+class PathSegmentPool {
+ public:
+  using Entry = PathSegment::Entry;
+
+  static PathSegmentPool& Instance() {
+    static NoDestructor<PathSegmentPool> instance;
+    return *instance;
+  }
+
+  Entry* Intern(absl::string_view segment) {
+    size_t hash = absl::Hash<absl::string_view>{}(segment);
+    Shard& shard = ShardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto found = shard.entries.find(segment);
+    if (found != shard.entries.end()) {
+      found->second->ref_count.fetch_add(1, std::memory_order_relaxed);
+      return found->second;
+    }
+
+    auto* entry = new Entry(segment, hash);
+    shard.entries.emplace(entry->value, entry);
+    return entry;
+  }
+
+  void Release(Entry* entry) {
+    // Fast path: this isn't the last reference, so the entry stays alive.
+    int count = entry->ref_count.load(std::memory_order_relaxed);
+    while (count > 1) {
+      if (entry->ref_count.compare_exchange_weak(count, count - 1,
+                                                 std::memory_order_acq_rel)) {
+        return;
+      }
+    }
+
+    // This may be the last reference. `Intern` might still resurrect the
+    // entry until the lock is held.
+    Shard& shard = ShardFor(entry->hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (entry->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      shard.entries.erase(entry->value);
+      delete entry;
+    }
+  }
+
+  size_t size() {
+    size_t result = 0;
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      result += shard.entries.size();
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kShardCount = 16;
+
+  struct Shard {
+    std::mutex mutex;
+
+    // The keys point into the entries' own strings.
+    absl::flat_hash_map<absl::string_view, Entry*> entries;
+  };
+
+  Shard& ShardFor(size_t hash) {
+    // The low bits pick the slot within a shard's table, so use the high ones.
+    return shards_[(hash >> (sizeof(size_t) * 8 - 4)) % kShardCount];
+  }
+
+  std::array<Shard, kShardCount> shards_;
+};
+
+PathSegment::Entry::Entry(absl::string_view segment, size_t hash)
+    : hash(hash), value(segment.data(), segment.size()) {
+}
+
+PathSegment::PathSegment(absl::string_view segment)
+    : entry_(PathSegmentPool::Instance().Intern(segment)) {
+}
+
+PathSegment::PathSegment(const PathSegment& other) : entry_(other.entry_) {
+  entry_->ref_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+PathSegment::PathSegment(PathSegment&& other) noexcept : entry_(other.entry_) {
+  other.entry_ = nullptr;
+}
+
+PathSegment& PathSegment::operator=(const PathSegment& other) {
+  if (entry_ != other.entry_) {
+    other.entry_->ref_count.fetch_add(1, std::memory_order_relaxed);
+    Release();
+    entry_ = other.entry_;
+  }
+  return *this;
+}
+
+PathSegment& PathSegment::operator=(PathSegment&& other) noexcept {
+  if (this != &other) {
+    Release();
+    entry_ = other.entry_;
+    other.entry_ = nullptr;
+  }
+  return *this;
+}
+
+PathSegment::~PathSegment() {
+  Release();
+}
+
+size_t PathSegment::PoolSize() {
+  return PathSegmentPool::Instance().size();
+}
+
+void PathSegment::Release() {
+  if (entry_) {
+    PathSegmentPool::Instance().Release(entry_);
+    entry_ = nullptr;
+  }
+}
+
+}  // namespace impl
+}  // namespace model
+}  // namespace firestore
+}  // namespace firebase
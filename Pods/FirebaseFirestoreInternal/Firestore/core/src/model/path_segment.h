@@ -0,0 +1,104 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_MODEL_PATH_SEGMENT_H_
+#define FIRESTORE_CORE_SRC_MODEL_PATH_SEGMENT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace firebase {
+namespace firestore {
+namespace model {
+namespace impl {
+
+/**
+ * A handle to a path segment string interned in a process-wide pool.
+ *
+ * All live segments with the same contents share a single, reference-counted
+ * string, so collection IDs and parent document IDs that many paths have in
+ * common are stored once, and a handle is only as large as a pointer. Equal
+ * segments always refer to the same entry, so comparing segments for
+ * equality is a pointer comparison. Copying a segment only increments the
+ * reference count.
+ *
+ * The pool is split into shards by hash, each with its own lock, so threads
+ * interning different segments rarely contend. A segment is released from the
+ * pool once the last handle to it is destroyed. Handles can be created, copied
+ * and destroyed on any thread.
+ *
+ * `PathSegment` is pointer-like: dereference it to access the segment string.
+ */
+class PathSegment {
+ public:
+  using element_type = std::string;
+
+  explicit PathSegment(absl::string_view segment);
+
+  PathSegment(const PathSegment& other);
+  PathSegment(PathSegment&& other) noexcept;
+  PathSegment& operator=(const PathSegment& other);
+  PathSegment& operator=(PathSegment&& other) noexcept;
+
+  ~PathSegment();
+
+  const std::string& operator*() const {
+    return entry_->value;
+  }
+  const std::string* operator->() const {
+    return &entry_->value;
+  }
+
+  size_t Hash() const {
+    return entry_->hash;
+  }
+
+  friend bool operator==(const PathSegment& lhs, const PathSegment& rhs) {
+    return lhs.entry_ == rhs.entry_;
+  }
+  friend bool operator!=(const PathSegment& lhs, const PathSegment& rhs) {
+    return !(lhs == rhs);
+  }
+
+  /** Returns the number of distinct segments currently interned. */
+  static size_t PoolSize();
+
+ private:
+  friend class PathSegmentPool;
+
+  struct Entry {
+    Entry(absl::string_view segment, size_t hash);
+
+    std::atomic<int> ref_count{1};
+    const size_t hash;
+    const std::string value;
+  };
+
+  void Release();
+
+  // Null only in moved-from segments.
+  Entry* entry_;
+};
+
+}  // namespace impl
+}  // namespace model
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_MODEL_PATH_SEGMENT_H_
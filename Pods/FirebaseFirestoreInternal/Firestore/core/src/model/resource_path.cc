@@ -45,9 +45,11 @@ ResourcePath ResourcePath::FromStringView(absl::string_view path) {
 
   // SkipEmpty because we may still have an empty segment at the beginning or
   // end if they had a leading or trailing slash (which we allow).
-  std::vector<std::string> segments =
+  // The segments are interned straight from the views, without allocating
+  // intermediate strings.
+  std::vector<absl::string_view> segments =
       absl::StrSplit(path, '/', absl::SkipEmpty());
-  return ResourcePath{std::move(segments)};
+  return ResourcePath{segments.begin(), segments.end()};
 }
 
 std::string ResourcePath::CanonicalString() const {
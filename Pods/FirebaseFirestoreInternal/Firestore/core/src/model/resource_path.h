@@ -49,6 +49,14 @@ class ResourcePath : public impl::BasePath<ResourcePath>,
   }
   explicit ResourcePath(SegmentsT&& segments) : BasePath{std::move(segments)} {
   }
+
+ private:
+  friend class impl::BasePath<ResourcePath>;
+
+  explicit ResourcePath(StorageT&& segments) : BasePath{std::move(segments)} {
+  }
+
+ public:
   /**
    * Creates and returns a new path from the given resource-path string, where
    * the path segments are separated by a slash "/".
@@ -17,6 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_NANOPB_MESSAGE_H_
 #define FIRESTORE_CORE_SRC_NANOPB_MESSAGE_H_
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -275,6 +276,18 @@ Message<T> Message<T>::TryParse(Reader* reader) {
   return result;
 }
 
+/**
+ * Returns the exact number of bytes that serializing `message` produces.
+ *
+ * Sizing walks the whole message, so only size messages up front where it
+ * saves more than a pass over the message, e.g. where the output would
+ * otherwise take an allocation per write.
+ */
+template <typename T>
+size_t EncodedSize(const Message<T>& message) {
+  return EncodedSize(message.fields(), message.get());
+}
+
 /**
  * Serializes the given `message` into a `ByteString`.
  *
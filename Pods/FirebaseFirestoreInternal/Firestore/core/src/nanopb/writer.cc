@@ -39,12 +39,24 @@ bool AppendToBytesArray(pb_ostream_t* stream,
 
 }  // namespace
 
+size_t EncodedSize(const pb_field_t* fields, const void* src_struct) {
+  size_t size = 0;
+  if (!pb_get_encoded_size(&size, fields, src_struct)) {
+    HARD_FAIL("Unable to compute the encoded size of a message");
+  }
+  return size;
+}
+
 void Writer::Write(const pb_field_t fields[], const void* src_struct) {
   if (!pb_encode(&stream_, fields, src_struct)) {
     HARD_FAIL(PB_GET_ERROR(&stream_));
   }
 }
 
+BufferWriter::BufferWriter(uint8_t* buffer, size_t size) {
+  stream_ = pb_ostream_from_buffer(buffer, size);
+}
+
 ByteStringWriter::ByteStringWriter() {
   stream_.callback = AppendToBytesArray;
   stream_.state = this;
@@ -20,6 +20,7 @@
 #include <pb.h>
 #include <pb_encode.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -31,6 +32,13 @@ namespace firebase {
 namespace firestore {
 namespace nanopb {
 
+/**
+ * Returns the exact number of bytes that encoding `src_struct` produces, so
+ * that the encoded message can be written into a single allocation of the
+ * right size. All errors are considered fatal.
+ */
+size_t EncodedSize(const pb_field_t* fields, const void* src_struct);
+
 /**
  * Docs TODO(rsgowman). But currently, this just wraps the underlying Nanopb
  * `pb_ostream_t`. All errors are considered fatal.
@@ -53,6 +61,23 @@ class Writer {
   pb_ostream_t stream_{};
 };
 
+/**
+ * A `Writer` that writes into a caller-provided buffer of fixed size.
+ *
+ * This is equivalent to the Nanopb function `pb_ostream_from_buffer()`.
+ * Writing more than `size` bytes is a fatal error; use `EncodedSize()` to size
+ * the buffer beforehand.
+ */
+class BufferWriter : public Writer {
+ public:
+  BufferWriter(uint8_t* buffer, size_t size);
+
+  /** Returns the number of bytes written so far. */
+  size_t size() const {
+    return stream_.bytes_written;
+  }
+};
+
 /**
  * A `Writer` that writes into a vector of bytes.
  *
@@ -351,7 +351,8 @@ void Datastore::ResumeRpcWithCredentials(const OnCredentials& on_credentials) {
             return;
           }
           on_credentials(auth_token, app_check_token);
-        });
+        },
+        "Datastore::ResumeRpcWithCredentials");
   };
 
   auth_credentials_->GetToken(
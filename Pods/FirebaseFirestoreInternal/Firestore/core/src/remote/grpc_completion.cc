@@ -90,11 +90,13 @@ void GrpcCompletion::Complete(bool ok) {
   // operation run. If this weren't a retain that ordering would have the
   // callback use after free.
   auto shared_this = grpc_ownership_;
-  worker_queue_->Enqueue([shared_this, ok] {
-    if (shared_this->callback_) {
-      shared_this->callback_(ok, shared_this);
-    }
-  });
+  worker_queue_->Enqueue(
+      [shared_this, ok] {
+        if (shared_this->callback_) {
+          shared_this->callback_(ok, shared_this);
+        }
+      },
+      "GrpcCompletion");
 
   // Having called Complete, gRPC has released its ownership interest in this
   // object. Once the queued operation completes the `GrpcCompletion` will be
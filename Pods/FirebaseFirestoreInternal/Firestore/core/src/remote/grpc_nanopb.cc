@@ -63,30 +63,6 @@ void ByteBufferReader::Read(const pb_field_t* fields, void* dest_struct) {
   }
 }
 
-namespace {
-
-bool AppendToGrpcBuffer(pb_ostream_t* stream,
-                        const pb_byte_t* buf,
-                        size_t count) {
-  auto buffer = static_cast<std::vector<grpc::Slice>*>(stream->state);
-  buffer->emplace_back(buf, count);
-  return true;
-}
-
-}  // namespace
-
-ByteBufferWriter::ByteBufferWriter() {
-  stream_.callback = AppendToGrpcBuffer;
-  stream_.state = &buffer_;
-  stream_.max_size = SIZE_MAX;
-}
-
-grpc::ByteBuffer ByteBufferWriter::Release() {
-  grpc::ByteBuffer result{buffer_.data(), buffer_.size()};
-  buffer_.clear();
-  return result;
-}
-
 }  // namespace remote
 }  // namespace firestore
 }  // namespace firebase
@@ -20,6 +20,8 @@
 #include <pb.h>
 #include <pb_decode.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "Firestore/core/src/nanopb/byte_string.h"
@@ -49,27 +51,20 @@ class ByteBufferReader : public nanopb::Reader {
   pb_istream_t stream_{};
 };
 
-/** A `Writer` that writes into a `grpc::ByteBuffer`. */
-class ByteBufferWriter : public nanopb::Writer {
- public:
-  ByteBufferWriter();
-
-  grpc::ByteBuffer Release();
-
- private:
-  std::vector<grpc::Slice> buffer_;
-};
-
 /**
  * Serializes the given `message` into a `grpc::ByteBuffer`.
  *
+ * The message is encoded into a single slice of exactly the right size.
+ *
  * The lifetime of the return value is entirely independent of the `message`.
  */
 template <typename T>
 grpc::ByteBuffer MakeByteBuffer(const nanopb::Message<T>& message) {
-  ByteBufferWriter writer;
+  size_t size = nanopb::EncodedSize(message);
+  grpc::Slice slice{size};
+  nanopb::BufferWriter writer{const_cast<uint8_t*>(slice.begin()), size};
   writer.Write(message.fields(), message.get());
-  return writer.Release();
+  return grpc::ByteBuffer{&slice, 1};
 }
 
 }  // namespace remote
@@ -16,8 +16,10 @@
 
 #include "Firestore/core/src/remote/remote_event.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/util/log.h"
@@ -40,6 +42,19 @@ using model::TargetId;
 using nanopb::ByteString;
 using util::TestingHooks;
 
+namespace {
+
+/**
+ * Sorts `keys` and builds the set in a single pass, which is much cheaper than
+ * inserting keys one at a time for the large initial snapshots of a query.
+ */
+DocumentKeySet ToDocumentKeySet(std::vector<DocumentKey>&& keys) {
+  std::sort(keys.begin(), keys.end());
+  return DocumentKeySet::FromSorted(keys.begin(), keys.end());
+}
+
+}  // namespace
+
 // TargetChange
 
 bool operator==(const TargetChange& lhs, const TargetChange& rhs) {
@@ -60,9 +75,9 @@ void TargetState::UpdateResumeToken(ByteString resume_token) {
 }
 
 TargetChange TargetState::ToTargetChange() const {
-  DocumentKeySet added_documents;
-  DocumentKeySet modified_documents;
-  DocumentKeySet removed_documents;
+  std::vector<DocumentKey> added_documents;
+  std::vector<DocumentKey> modified_documents;
+  std::vector<DocumentKey> removed_documents;
 
   for (const auto& entry : document_changes_) {
     const DocumentKey& document_key = entry.first;
@@ -70,22 +85,23 @@ TargetChange TargetState::ToTargetChange() const {
 
     switch (change_type) {
       case DocumentViewChange::Type::Added:
-        added_documents = added_documents.insert(document_key);
+        added_documents.push_back(document_key);
         break;
       case DocumentViewChange::Type::Modified:
-        modified_documents = modified_documents.insert(document_key);
+        modified_documents.push_back(document_key);
         break;
       case DocumentViewChange::Type::Removed:
-        removed_documents = removed_documents.insert(document_key);
+        removed_documents.push_back(document_key);
         break;
       default:
         HARD_FAIL("Encountered invalid change type: %s", change_type);
     }
   }
 
-  return TargetChange{resume_token(), current(), std::move(added_documents),
-                      std::move(modified_documents),
-                      std::move(removed_documents)};
+  return TargetChange{resume_token(), current(),
+                      ToDocumentKeySet(std::move(added_documents)),
+                      ToDocumentKeySet(std::move(modified_documents)),
+                      ToDocumentKeySet(std::move(removed_documents))};
 }
 
 void TargetState::ClearPendingChanges() {
@@ -360,6 +376,7 @@ int WatchChangeAggregator::FilterRemovedDocuments(
 RemoteEvent WatchChangeAggregator::CreateRemoteEvent(
     const SnapshotVersion& snapshot_version) {
   std::unordered_map<TargetId, TargetChange> target_changes;
+  target_changes.reserve(target_states_.size());
 
   for (auto& entry : target_states_) {
     TargetId target_id = entry.first;
@@ -391,7 +408,7 @@ RemoteEvent WatchChangeAggregator::CreateRemoteEvent(
     }
   }
 
-  DocumentKeySet resolved_limbo_documents;
+  std::vector<DocumentKey> resolved_limbo_documents;
 
   // We extract the set of limbo-only document updates as the GC logic
   // special-cases documents that do not appear in the target cache.
@@ -411,14 +428,14 @@ RemoteEvent WatchChangeAggregator::CreateRemoteEvent(
     }
 
     if (is_only_limbo_target) {
-      resolved_limbo_documents = resolved_limbo_documents.insert(entry.first);
+      resolved_limbo_documents.push_back(entry.first);
     }
   }
 
-  RemoteEvent remote_event{snapshot_version, std::move(target_changes),
-                           std::move(pending_target_resets_),
-                           std::move(pending_document_updates_),
-                           std::move(resolved_limbo_documents)};
+  RemoteEvent remote_event{
+      snapshot_version, std::move(target_changes),
+      std::move(pending_target_resets_), std::move(pending_document_updates_),
+      ToDocumentKeySet(std::move(resolved_limbo_documents))};
 
   // Re-initialize the current state to ensure that we do not modify the
   // generated `RemoteEvent`.
@@ -444,7 +461,7 @@ void WatchChangeAggregator::AddDocumentToTarget(
   target_state.AddDocumentChange(document.key(), change_type);
 
   pending_document_updates_[document.key()] = document;
-  pending_document_target_mappings_[document.key()].insert(target_id);
+  AddTargetMapping(document.key(), target_id);
 }
 
 void WatchChangeAggregator::RemoveDocumentFromTarget(
@@ -463,13 +480,22 @@ void WatchChangeAggregator::RemoveDocumentFromTarget(
     // snapshot, so we can just ignore the change.
     target_state.RemoveDocumentChange(key);
   }
-  pending_document_target_mappings_[key].insert(target_id);
+  AddTargetMapping(key, target_id);
 
   if (updated_document) {
     pending_document_updates_[key] = *updated_document;
   }
 }
 
+void WatchChangeAggregator::AddTargetMapping(const DocumentKey& key,
+                                             TargetId target_id) {
+  auto& target_ids = pending_document_target_mappings_[key];
+  if (std::find(target_ids.begin(), target_ids.end(), target_id) ==
+      target_ids.end()) {
+    target_ids.push_back(target_id);
+  }
+}
+
 void WatchChangeAggregator::RemoveTarget(TargetId target_id) {
   target_states_.erase(target_id);
 }
@@ -519,6 +545,8 @@ void WatchChangeAggregator::ResetTarget(TargetId target_id) {
   // these documents.
   DocumentKeySet existing_keys =
       target_metadata_provider_->GetRemoteKeysForTarget(target_id);
+  pending_document_target_mappings_.reserve(
+      pending_document_target_mappings_.size() + existing_keys.size());
 
   for (const DocumentKey& key : existing_keys) {
     RemoveDocumentFromTarget(target_id, key, absl::nullopt);
@@ -17,9 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_REMOTE_REMOTE_EVENT_H_
 #define FIRESTORE_CORE_SRC_REMOTE_REMOTE_EVENT_H_
 
-#include <set>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -31,6 +29,8 @@
 #include "Firestore/core/src/model/types.h"
 #include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/remote/watch_change.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 
 namespace firebase {
 namespace firestore {
@@ -223,9 +223,9 @@ class TargetState {
    * These changes are continuously updated as we receive document updates and
    * always reflect the current set of changes against the last issued snapshot.
    */
-  std::unordered_map<model::DocumentKey,
-                     core::DocumentViewChange::Type,
-                     model::DocumentKeyHash>
+  absl::flat_hash_map<model::DocumentKey,
+                      core::DocumentViewChange::Type,
+                      model::DocumentKeyHash>
       document_changes_;
 
   nanopb::ByteString resume_token_;
@@ -376,6 +376,10 @@ class WatchChangeAggregator {
       const model::DocumentKey& key,
       const absl::optional<model::MutableDocument>& updated_document);
 
+  /** Records that `key` was changed in the given target. */
+  void AddTargetMapping(const model::DocumentKey& key,
+                        model::TargetId target_id);
+
   /**
    * Returns the current count of documents in the target. This includes both
    * the number of documents that the LocalStore considers to be part of the
@@ -445,10 +449,13 @@ class WatchChangeAggregator {
   /** Keeps track of the documents to update since the last raised snapshot. */
   model::DocumentUpdateMap pending_document_updates_;
 
-  /** A mapping of document keys to their set of target IDs. */
-  std::unordered_map<model::DocumentKey,
-                     std::set<model::TargetId>,
-                     model::DocumentKeyHash>
+  /**
+   * A mapping of document keys to their set of target IDs. Almost all
+   * documents belong to a single target, so the IDs are kept inline.
+   */
+  absl::flat_hash_map<model::DocumentKey,
+                      absl::InlinedVector<model::TargetId, 2>,
+                      model::DocumentKeyHash>
       pending_document_target_mappings_;
 
   /**
@@ -56,12 +56,26 @@ using model::SnapshotVersion;
 using model::TargetId;
 using nanopb::ByteString;
 using nanopb::MakeArray;
+using nanopb::MakeMessage;
 using nanopb::Message;
 using nanopb::Reader;
 using remote::ByteBufferReader;
 using remote::Serializer;
 using util::StatusOr;
 
+namespace {
+
+size_t VarintSize(size_t value) {
+  size_t result = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++result;
+  }
+  return result;
+}
+
+}  // namespace
+
 // WatchStreamSerializer
 
 WatchStreamSerializer::WatchStreamSerializer(Serializer serializer)
@@ -166,6 +180,23 @@ WriteStreamSerializer::EncodeEmptyMutationsList(
   return EncodeWriteMutationsRequest({}, last_stream_token);
 }
 
+size_t WriteStreamSerializer::CalculateEncodedSize(
+    const std::vector<Mutation>& mutations) const {
+  size_t result = 0;
+  for (const Mutation& mutation : mutations) {
+    auto write = MakeMessage(serializer_.EncodeMutation(mutation));
+    size_t write_size = 0;
+    if (!pb_get_encoded_size(&write_size, write.fields(), write.get())) {
+      HARD_FAIL("Failed to calculate the encoded size of %s",
+                mutation.ToString());
+    }
+    // Each element of the repeated `writes` field is prefixed by its tag and
+    // a varint-encoded length.
+    result += write_size + 1 + VarintSize(write_size);
+  }
+  return result;
+}
+
 Message<google_firestore_v1_WriteResponse> WriteStreamSerializer::ParseResponse(
     Reader* reader) const {
   return Message<google_firestore_v1_WriteResponse>::TryParse(reader);
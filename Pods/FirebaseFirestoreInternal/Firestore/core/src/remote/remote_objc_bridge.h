@@ -103,6 +103,13 @@ class WriteStreamSerializer {
   nanopb::Message<google_firestore_v1_WriteRequest> EncodeEmptyMutationsList(
       const nanopb::ByteString& last_stream_token) const;
 
+  /**
+   * Returns the number of bytes the given mutations will occupy once encoded
+   * as the `writes` of a write request.
+   */
+  size_t CalculateEncodedSize(
+      const std::vector<model::Mutation>& mutations) const;
+
   nanopb::Message<google_firestore_v1_WriteResponse> ParseResponse(
       nanopb::Reader* reader) const;
   model::SnapshotVersion DecodeCommitVersion(
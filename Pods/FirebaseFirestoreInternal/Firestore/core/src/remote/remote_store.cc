@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/remote/remote_store.h"
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -25,6 +27,7 @@
 #include "Firestore/core/src/model/mutation_batch.h"
 #include "Firestore/core/src/model/mutation_batch_result.h"
 #include "Firestore/core/src/nanopb/nanopb_util.h"
+#include "Firestore/core/src/remote/write_coalescing.h"
 #include "Firestore/core/src/util/error_apple.h"
 #include "Firestore/core/src/util/hard_assert.h"
 #include "Firestore/core/src/util/log.h"
@@ -53,11 +56,31 @@ using nanopb::ByteString;
 using util::AsyncQueue;
 using util::Status;
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
 /**
- * The maximum number of pending writes to allow.
+ * The number of pending writes to allow while the round-trip time of the write
+ * stream is unknown or at most `kReferenceWriteRtt`.
  * TODO(b/35853402): Negotiate this value with the backend.
  */
-constexpr int kMaxPendingWrites = 10;
+constexpr size_t kMinPendingWrites = 10;
+
+/**
+ * The maximum number of pending writes to allow however slow the write stream
+ * is.
+ */
+constexpr size_t kMaxPendingWrites = 100;
+
+/**
+ * The round-trip time at which `kMinPendingWrites` keep the write stream busy.
+ * Slower streams get a proportionally deeper pipeline.
+ */
+constexpr milliseconds kReferenceWriteRtt{100};
+
+}  // namespace
 
 RemoteStore::RemoteStore(
     LocalStore* local_store,
@@ -68,7 +91,8 @@ RemoteStore::RemoteStore(
     : local_store_{local_store},
       datastore_{std::move(datastore)},
       online_state_tracker_{worker_queue, std::move(online_state_handler)},
-      connectivity_monitor_{NOT_NULL(connectivity_monitor)} {
+      connectivity_monitor_{NOT_NULL(connectivity_monitor)},
+      max_pending_writes_{kMinPendingWrites} {
   datastore_->Start();
 
   // Create streams (but note they're not started yet)
@@ -134,6 +158,8 @@ void RemoteStore::DisableNetworkInternal() {
               write_pipeline_.size());
     write_pipeline_.clear();
   }
+  ResetWriteRequests();
+  uncoalesced_batch_id_ = kBatchIdUnknown;
 
   CleanUpWatchStreamState();
 }
@@ -393,9 +419,9 @@ void RemoteStore::RunAggregateQuery(
 // Write Stream
 
 void RemoteStore::FillWritePipeline() {
-  BatchId last_batch_id_retrieved = write_pipeline_.empty()
-                                        ? kBatchIdUnknown
-                                        : write_pipeline_.back().batch_id();
+  BatchId last_batch_id_retrieved =
+      write_pipeline_.empty() ? kBatchIdUnknown
+                              : write_pipeline_.back().batch.batch_id();
   while (CanAddToWritePipeline()) {
     absl::optional<MutationBatch> batch =
         local_store_->GetNextMutationBatch(last_batch_id_retrieved);
@@ -405,30 +431,78 @@ void RemoteStore::FillWritePipeline() {
       }
       break;
     }
-    AddToWritePipeline(*batch);
     last_batch_id_retrieved = batch->batch_id();
+    write_pipeline_.push_back(PendingWrite{std::move(*batch), absl::nullopt});
   }
 
+  // Send everything fetched above at once so that consecutive batches can be
+  // coalesced.
+  SendPendingWrites();
+
   if (ShouldStartWriteStream()) {
     StartWriteStream();
   }
 }
 
 bool RemoteStore::CanAddToWritePipeline() const {
-  return CanUseNetwork() && write_pipeline_.size() < kMaxPendingWrites;
+  return CanUseNetwork() && write_pipeline_.size() < max_pending_writes_;
 }
 
-void RemoteStore::AddToWritePipeline(const MutationBatch& batch) {
-  HARD_ASSERT(CanAddToWritePipeline(),
-              "AddToWritePipeline called when pipeline is full");
+void RemoteStore::SendPendingWrites() {
+  if (!write_stream_->IsOpen() || !write_stream_->handshake_complete()) {
+    return;
+  }
 
-  write_pipeline_.push_back(batch);
+  while (sent_batch_count_ < write_pipeline_.size()) {
+    PendingWrite* unsent = &write_pipeline_[sent_batch_count_];
+    size_t batch_count = 1;
+    if (unsent->batch.batch_id() > uncoalesced_batch_id_) {
+      batch_count = CountCoalescedBatches(
+          write_pipeline_.size() - sent_batch_count_,
+          [&](size_t i) { return unsent[i].batch.mutations().size(); },
+          [&](size_t i) {
+            PendingWrite& write = unsent[i];
+            if (!write.encoded_size) {
+              write.encoded_size =
+                  write_stream_->CalculateEncodedSize(write.batch.mutations());
+            }
+            return *write.encoded_size;
+          });
+    }
 
-  if (write_stream_->IsOpen() && write_stream_->handshake_complete()) {
-    write_stream_->WriteMutations(batch.mutations());
+    std::vector<model::Mutation> mutations = unsent->batch.mutations();
+    for (size_t i = 1; i < batch_count; ++i) {
+      const std::vector<model::Mutation>& next = unsent[i].batch.mutations();
+      mutations.insert(mutations.end(), next.begin(), next.end());
+    }
+
+    write_stream_->WriteMutations(mutations);
+    write_requests_.push_back(WriteRequest{batch_count, Clock::now()});
+    sent_batch_count_ += batch_count;
   }
 }
 
+void RemoteStore::ResetWriteRequests() {
+  write_requests_.clear();
+  sent_batch_count_ = 0;
+}
+
+void RemoteStore::RecordWriteRoundTrip(Clock::time_point sent_at) {
+  auto rtt = std::chrono::duration_cast<milliseconds>(Clock::now() - sent_at);
+  if (smoothed_write_rtt_ == milliseconds::zero()) {
+    smoothed_write_rtt_ = rtt;
+  } else {
+    // Same smoothing factor as TCP's SRTT (RFC 6298).
+    smoothed_write_rtt_ = (smoothed_write_rtt_ * 7 + rtt) / 8;
+  }
+
+  size_t depth = kMinPendingWrites *
+                 static_cast<size_t>(smoothed_write_rtt_.count()) /
+                 static_cast<size_t>(kReferenceWriteRtt.count());
+  max_pending_writes_ =
+      std::min(std::max(depth, kMinPendingWrites), kMaxPendingWrites);
+}
+
 bool RemoteStore::ShouldStartWriteStream() const {
   return CanUseNetwork() && !write_stream_->IsStarted() &&
          !write_pipeline_.empty();
@@ -448,28 +522,55 @@ void RemoteStore::OnWriteStreamHandshakeComplete() {
   // Record the stream token.
   local_store_->SetLastStreamToken(write_stream_->last_stream_token());
 
-  // Send the write pipeline now that the stream is established.
-  for (const MutationBatch& write : write_pipeline_) {
-    write_stream_->WriteMutations(write.mutations());
-  }
+  // Send the write pipeline now that the stream is established. Requests
+  // written to a previous stream were never acknowledged, so resend all of
+  // them.
+  ResetWriteRequests();
+  SendPendingWrites();
 }
 
 void RemoteStore::OnWriteStreamMutationResult(
     SnapshotVersion commit_version,
     std::vector<MutationResult> mutation_results) {
-  // This is a response to a write containing mutations and should be correlated
-  // to the first write in our write pipeline.
-  HARD_ASSERT(!write_pipeline_.empty(), "Got result for empty write pipeline");
-
-  MutationBatch batch = write_pipeline_.front();
-  write_pipeline_.erase(write_pipeline_.begin());
-
-  MutationBatchResult batch_result(std::move(batch), commit_version,
-                                   std::move(mutation_results),
-                                   write_stream_->last_stream_token());
-  sync_engine_->HandleSuccessfulWrite(std::move(batch_result));
+  // This is a response to a write request containing mutations and should be
+  // correlated to the first request we sent, which in turn carries the first
+  // batches in our write pipeline.
+  HARD_ASSERT(!write_requests_.empty(), "Got result for empty write pipeline");
+
+  WriteRequest request = write_requests_.front();
+  write_requests_.pop_front();
+  RecordWriteRoundTrip(request.sent_at);
+
+  HARD_ASSERT(request.batch_count <= write_pipeline_.size(),
+              "Write request covers more batches than the write pipeline has");
+  std::vector<MutationBatch> batches;
+  batches.reserve(request.batch_count);
+  for (size_t i = 0; i < request.batch_count; ++i) {
+    batches.push_back(std::move(write_pipeline_[i].batch));
+  }
+  write_pipeline_.erase(write_pipeline_.begin(),
+                        write_pipeline_.begin() + request.batch_count);
+  sent_batch_count_ -= request.batch_count;
+
+  // Split the results of the request back into the results of each batch.
+  auto results_begin = mutation_results.begin();
+  for (MutationBatch& batch : batches) {
+    size_t mutation_count = batch.mutations().size();
+    HARD_ASSERT(static_cast<size_t>(mutation_results.end() - results_begin) >=
+                    mutation_count,
+                "Got fewer mutation results than mutations in the request");
+    std::vector<MutationResult> batch_results(
+        std::make_move_iterator(results_begin),
+        std::make_move_iterator(results_begin + mutation_count));
+    results_begin += mutation_count;
+
+    MutationBatchResult batch_result(std::move(batch), commit_version,
+                                     std::move(batch_results),
+                                     write_stream_->last_stream_token());
+    sync_engine_->HandleSuccessfulWrite(std::move(batch_result));
+  }
 
-  // It's possible that with the completion of this mutation another slot has
+  // It's possible that with the completion of these mutations more slots have
   // freed up.
   FillWritePipeline();
 }
@@ -535,15 +636,30 @@ void RemoteStore::HandleWriteError(const Status& status) {
     return;
   }
 
-  // If this was a permanent error, the request itself was the problem so it's
-  // not going to succeed if we resend it.
-  MutationBatch batch = write_pipeline_.front();
-  write_pipeline_.erase(write_pipeline_.begin());
-
   // In this case it's also unlikely that the server itself is melting
   // down--this was just a bad request so inhibit backoff on the next restart.
   write_stream_->InhibitBackoff();
 
+  // The backend rejects a request as a whole, so if the request carried
+  // several batches there is no telling which of them was at fault. Resend
+  // them one per request; the offending batch will then be rejected alone.
+  if (!write_requests_.empty() && write_requests_.front().batch_count > 1) {
+    uncoalesced_batch_id_ =
+        write_pipeline_[write_requests_.front().batch_count - 1]
+            .batch.batch_id();
+    LOG_DEBUG(
+        "RemoteStore %x coalesced write request rejected; resending batches "
+        "up to %s one at a time",
+        this, uncoalesced_batch_id_);
+    return;
+  }
+
+  // If this was a permanent error, the request itself was the problem so it's
+  // not going to succeed if we resend it.
+  MutationBatch batch = std::move(write_pipeline_.front().batch);
+  write_pipeline_.erase(write_pipeline_.begin());
+  ResetWriteRequests();
+
   sync_engine_->HandleRejectedWrite(batch.batch_id(), status);
 
   // It's possible that with the completion of this mutation another slot has
@@ -17,6 +17,8 @@
 #ifndef FIRESTORE_CORE_SRC_REMOTE_REMOTE_STORE_H_
 #define FIRESTORE_CORE_SRC_REMOTE_REMOTE_STORE_H_
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +36,7 @@
 #include "Firestore/core/src/remote/write_stream.h"
 #include "Firestore/core/src/util/async_queue.h"
 #include "Firestore/core/src/util/status_fwd.h"
+#include "absl/types/optional.h"
 
 namespace firebase {
 namespace firestore {
@@ -182,12 +185,6 @@ class RemoteStore : public TargetMetadataProvider,
    */
   void FillWritePipeline();
 
-  /**
-   * Queues additional writes to be sent to the write stream, sending them
-   * immediately if the write stream is established.
-   */
-  void AddToWritePipeline(const model::MutationBatch& batch);
-
   /** Returns a new transaction backed by this remote store. */
   // TODO(c++14): return a plain value when it becomes possible to move
   // `Transaction` into lambdas.
@@ -238,6 +235,27 @@ class RemoteStore : public TargetMetadataProvider,
    */
   bool CanAddToWritePipeline() const;
 
+  /**
+   * Sends every batch in the write pipeline that hasn't been written to the
+   * stream yet, provided the stream is ready to accept mutations.
+   *
+   * Consecutive batches are coalesced into a single request for as long as the
+   * request stays within `kMaxWriteRequestBytes` and `kMaxWritesPerRequest`
+   * (see `CountCoalescedBatches`). The backend applies the writes of a request
+   * atomically, so batches that were part of a rejected coalesced request are
+   * retried one per request (see `HandleWriteError`).
+   */
+  void SendPendingWrites();
+
+  /**
+   * Updates the smoothed write round-trip time with the response to a request
+   * sent at `sent_at`, and scales the depth of the write pipeline with it.
+   */
+  void RecordWriteRoundTrip(std::chrono::steady_clock::time_point sent_at);
+
+  /** Forgets all requests that were written to the write stream. */
+  void ResetWriteRequests();
+
   void StartWriteStream();
 
   /**
@@ -310,9 +328,53 @@ class RemoteStore : public TargetMetadataProvider,
    *
    * Write responses from the backend are linked to their originating request
    * purely based on order, and so we can just remove writes from the front of
-   * the `write_pipeline_` as we receive responses.
+   * the `write_pipeline_` as we receive responses. Since a single request may
+   * carry several batches, `write_requests_` records how many batches from the
+   * front of the pipeline each response acknowledges.
    */
-  std::vector<model::MutationBatch> write_pipeline_;
+  struct PendingWrite {
+    model::MutationBatch batch;
+
+    /**
+     * The number of bytes the batch adds to a write request. Measured the first
+     * time the batch is considered for coalescing and kept from then on, since
+     * measuring means encoding every mutation of the batch.
+     */
+    absl::optional<size_t> encoded_size;
+  };
+  std::vector<PendingWrite> write_pipeline_;
+
+  /** A request sent on the current write stream and not yet acknowledged. */
+  struct WriteRequest {
+    /** The number of consecutive pipeline batches carried by the request. */
+    size_t batch_count = 0;
+    std::chrono::steady_clock::time_point sent_at;
+  };
+
+  /**
+   * The requests written to the current write stream in the order they were
+   * sent. Together they cover the first `sent_batch_count_` batches of
+   * `write_pipeline_`.
+   */
+  std::deque<WriteRequest> write_requests_;
+  size_t sent_batch_count_ = 0;
+
+  /**
+   * Batches with IDs up to and including this one are sent one per request.
+   * Set when a coalesced request is permanently rejected so that the offending
+   * batch can be identified and rejected on its own.
+   */
+  model::BatchId uncoalesced_batch_id_ = model::kBatchIdUnknown;
+
+  /**
+   * The maximum number of batches allowed in `write_pipeline_`, scaled between
+   * `kMinPendingWrites` and `kMaxPendingWrites` by the observed round-trip
+   * time.
+   */
+  size_t max_pending_writes_;
+
+  /** Exponentially smoothed round-trip time of write requests. */
+  std::chrono::milliseconds smoothed_write_rtt_{0};
 };
 
 }  // namespace remote
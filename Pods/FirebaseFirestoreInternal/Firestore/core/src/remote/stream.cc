@@ -152,7 +152,8 @@ void Stream::RequestCredentials() {
             return;
           }
           strong_this->ResumeStartWithCredentials(auth_token, app_check_token);
-        });
+        },
+        "Stream::RequestCredentials");
   };
 
   auth_credentials_provider_->GetToken(
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/remote/write_coalescing.h"
+
+namespace firebase {
+namespace firestore {
+namespace remote {
+
+size_t CountCoalescedBatches(
+    size_t batch_count,
+    const std::function<size_t(size_t)>& write_count,
+    const std::function<size_t(size_t)>& encoded_size) {
+  if (batch_count <= 1) return batch_count;
+
+  size_t request_writes = write_count(0);
+  size_t request_bytes = encoded_size(0);
+  size_t result = 1;
+  for (; result < batch_count; ++result) {
+    size_t next_writes = write_count(result);
+    size_t next_bytes = encoded_size(result);
+    if (request_bytes + next_bytes > kMaxWriteRequestBytes ||
+        request_writes + next_writes > kMaxWritesPerRequest) {
+      break;
+    }
+    request_writes += next_writes;
+    request_bytes += next_bytes;
+  }
+  return result;
+}
+
+}  // namespace remote
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_REMOTE_WRITE_COALESCING_H_
+#define FIRESTORE_CORE_SRC_REMOTE_WRITE_COALESCING_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace firebase {
+namespace firestore {
+namespace remote {
+
+/** The byte budget for coalescing several mutation batches into a request. */
+constexpr size_t kMaxWriteRequestBytes = 1024 * 1024;
+
+/** The maximum number of writes in a coalesced request. */
+constexpr size_t kMaxWritesPerRequest = 500;
+
+/**
+ * Returns how many of `batch_count` consecutive mutation batches to send in a
+ * single write request: as many as fit within `kMaxWriteRequestBytes` and
+ * `kMaxWritesPerRequest`, and always at least one.
+ *
+ * `write_count(i)` returns the number of writes in batch `i`, and
+ * `encoded_size(i)` the number of bytes the batch adds to a request. Sizes are
+ * only requested when there is more than one batch to choose from, so a lone
+ * batch is never measured.
+ */
+size_t CountCoalescedBatches(size_t batch_count,
+                             const std::function<size_t(size_t)>& write_count,
+                             const std::function<size_t(size_t)>& encoded_size);
+
+}  // namespace remote
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_REMOTE_WRITE_COALESCING_H_
@@ -94,6 +94,11 @@ void WriteStream::WriteMutations(const std::vector<Mutation>& mutations) {
   Write(MakeByteBuffer(request));
 }
 
+size_t WriteStream::CalculateEncodedSize(
+    const std::vector<Mutation>& mutations) const {
+  return write_serializer_.CalculateEncodedSize(mutations);
+}
+
 std::unique_ptr<GrpcStream> WriteStream::CreateGrpcStream(
     GrpcConnection* grpc_connection,
     const AuthToken& auth_token,
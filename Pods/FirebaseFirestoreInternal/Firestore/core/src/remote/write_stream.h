@@ -129,6 +129,14 @@ class WriteStream : public Stream {
   /** Sends a group of mutations to the Firestore backend to apply. */
   virtual void WriteMutations(const std::vector<model::Mutation>& mutations);
 
+  /**
+   * Returns the number of bytes the given mutations would add to a request
+   * sent by `WriteMutations`. Used to decide how many mutation batches can be
+   * coalesced into a single request.
+   */
+  virtual size_t CalculateEncodedSize(
+      const std::vector<model::Mutation>& mutations) const;
+
  protected:
   // For tests only
   void SetHandshakeComplete(bool value = true) {
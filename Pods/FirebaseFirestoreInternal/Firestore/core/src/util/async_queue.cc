@@ -16,6 +16,7 @@
 
 #include "Firestore/core/src/util/async_queue.h"
 
+#include <memory>
 #include <utility>
 
 #include "Firestore/core/src/util/hard_assert.h"
@@ -26,6 +27,72 @@
 namespace firebase {
 namespace firestore {
 namespace util {
+namespace {
+
+const char* LabelOrDefault(const char* label, const char* default_label) {
+  return label != nullptr ? label : default_label;
+}
+
+/**
+ * Counts an immediate operation towards the queue depth for as long as it is
+ * on the queue. The executor destroys operations that are still queued when it
+ * is disposed, so an operation that is destroyed without having been recorded
+ * is reported as dropped.
+ */
+class QueuedOperation {
+ public:
+  explicit QueuedOperation(std::shared_ptr<AsyncQueueStats> stats)
+      : stats_(std::move(stats)) {
+    stats_->OperationEnqueued();
+  }
+
+  ~QueuedOperation() {
+    if (!recorded_) {
+      stats_->OperationDropped();
+    }
+  }
+
+  void Record(const char* label,
+              AsyncQueueStats::Clock::time_point runnable_at,
+              AsyncQueueStats::Clock::time_point started_at) {
+    stats_->RecordOperation(label, runnable_at, started_at,
+                            AsyncQueueStats::Clock::now(),
+                            /*immediate=*/true);
+    recorded_ = true;
+  }
+
+ private:
+  std::shared_ptr<AsyncQueueStats> stats_;
+  bool recorded_ = false;
+};
+
+}  // namespace
+
+const char* TimerIdName(TimerId timer_id) {
+  switch (timer_id) {
+    case TimerId::All:
+      return "All";
+    case TimerId::ListenStreamIdle:
+      return "ListenStreamIdle";
+    case TimerId::ListenStreamConnectionBackoff:
+      return "ListenStreamConnectionBackoff";
+    case TimerId::WriteStreamIdle:
+      return "WriteStreamIdle";
+    case TimerId::WriteStreamConnectionBackoff:
+      return "WriteStreamConnectionBackoff";
+    case TimerId::HealthCheckTimeout:
+      return "HealthCheckTimeout";
+    case TimerId::OnlineStateTimeout:
+      return "OnlineStateTimeout";
+    case TimerId::GarbageCollectionDelay:
+      return "GarbageCollectionDelay";
+    case TimerId::RetryTransaction:
+      return "RetryTransaction";
+    case TimerId::IndexBackfillDelay:
+      return "IndexBackfillDelay";
+  }
+  UNREACHABLE();
+}
 
 std::shared_ptr<AsyncQueue> AsyncQueue::Create(
     std::unique_ptr<Executor> executor) {
@@ -90,16 +157,19 @@ void AsyncQueue::ExecuteBlocking(const Operation& operation) {
   is_operation_in_progress_ = false;
 }
 
-bool AsyncQueue::Enqueue(const Operation& operation) {
+bool AsyncQueue::Enqueue(const Operation& operation, const char* label) {
   VerifySequentialOrder();
-  return EnqueueRelaxed(operation);
+  return EnqueueRelaxed(operation, LabelOrDefault(label, "Enqueue"));
 }
 
-bool AsyncQueue::EnqueueEvenWhileRestricted(const Operation& operation) {
+bool AsyncQueue::EnqueueEvenWhileRestricted(const Operation& operation,
+                                            const char* label) {
   std::lock_guard<std::mutex> lock(mutex_);
   if (mode_ == Mode::kDisposed) return false;
 
-  executor_->Execute(Wrap(operation));
+  executor_->Execute(
+      Wrap(operation, LabelOrDefault(label, "EnqueueEvenWhileRestricted"),
+           /*immediate=*/true));
   return true;
 }
 
@@ -108,11 +178,13 @@ bool AsyncQueue::is_running() const {
   return mode_ == Mode::kRunning;
 }
 
-bool AsyncQueue::EnqueueRelaxed(const Operation& operation) {
+bool AsyncQueue::EnqueueRelaxed(const Operation& operation,
+                                const char* label) {
   std::lock_guard<std::mutex> lock(mutex_);
   if (mode_ != Mode::kRunning) return false;
 
-  executor_->Execute(Wrap(operation));
+  executor_->Execute(Wrap(operation, LabelOrDefault(label, "EnqueueRelaxed"),
+                          /*immediate=*/true));
   return true;
 }
 
@@ -132,16 +204,60 @@ DelayedOperation AsyncQueue::EnqueueAfterDelay(Milliseconds delay,
   }
 
   auto tag = static_cast<Executor::Tag>(timer_id);
-  return executor_->Schedule(delay, tag, Wrap(operation));
+  return executor_->Schedule(
+      delay, tag,
+      Wrap(operation, TimerIdName(timer_id), /*immediate=*/false, delay));
 }
 
-AsyncQueue::Operation AsyncQueue::Wrap(const Operation& operation) {
+AsyncQueue::Operation AsyncQueue::Wrap(const Operation& operation,
+                                       const char* label,
+                                       bool immediate,
+                                       Milliseconds delay) {
   // Decorator pattern: wrap `operation` into a call to `ExecuteBlocking` to
   // ensure that it doesn't spawn any nested operations.
 
   // The Executor guarantees that this operation will either execute before
   // `Dispose` completes or not at all.
-  return [this, operation] { this->ExecuteBlocking(operation); };
+  if (!stats_) {
+    return [this, operation] { this->ExecuteBlocking(operation); };
+  }
+
+  // Capture the stats rather than reading `stats_` when the operation runs so
+  // that the enqueue and completion are always reported to the same instance.
+  std::shared_ptr<AsyncQueueStats> stats = stats_;
+  auto runnable_at = AsyncQueueStats::Clock::now() + delay;
+  if (immediate) {
+    // The executor may copy the operation, so share the bookkeeping between
+    // the copies.
+    auto queued = std::make_shared<QueuedOperation>(std::move(stats));
+    return [this, operation, queued, label, runnable_at] {
+      auto started_at = AsyncQueueStats::Clock::now();
+      this->ExecuteBlocking(operation);
+      queued->Record(label, runnable_at, started_at);
+    };
+  }
+  return [this, operation, stats, label, runnable_at] {
+    auto started_at = AsyncQueueStats::Clock::now();
+    this->ExecuteBlocking(operation);
+    stats->RecordOperation(label, runnable_at, started_at,
+                           AsyncQueueStats::Clock::now(), /*immediate=*/false);
+  };
+}
+
+void AsyncQueue::EnableInstrumentation(
+    std::chrono::microseconds slow_threshold) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = std::make_shared<AsyncQueueStats>(slow_threshold);
+}
+
+void AsyncQueue::DisableInstrumentation() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.reset();
+}
+
+std::shared_ptr<AsyncQueueStats> AsyncQueue::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
 }
 
 void AsyncQueue::VerifySequentialOrder() const {
@@ -157,7 +273,13 @@ void AsyncQueue::VerifySequentialOrder() const {
 
 void AsyncQueue::EnqueueBlocking(const Operation& operation) {
   VerifySequentialOrder();
-  executor_->ExecuteBlocking(Wrap(operation));
+
+  Operation wrapped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wrapped = Wrap(operation, "EnqueueBlocking", /*immediate=*/true);
+  }
+  executor_->ExecuteBlocking(std::move(wrapped));
 }
 
 bool AsyncQueue::IsScheduled(const TimerId timer_id) const {
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <vector>
 
+#include "Firestore/core/src/util/async_queue_stats.h"
 #include "Firestore/core/src/util/executor.h"
 
 namespace firebase {
@@ -76,6 +77,10 @@ enum class TimerId {
   IndexBackfillDelay
 };
 
+// Returns a stable, human-readable name for the given `timer_id`, suitable for
+// labeling instrumentation and log output.
+const char* TimerIdName(TimerId timer_id);
+
 // A serial queue that executes given operations asynchronously, one at a time.
 // Operations may be scheduled to be executed as soon as possible or in the
 // future. Operations scheduled for the same time are FIFO-ordered.
@@ -149,10 +154,13 @@ class AsyncQueue : public std::enable_shared_from_this<AsyncQueue> {
   // After the shutdown process has initiated (`is_running()` is false), calling
   // `Enqueue` is a no-op.
   //
+  // `label` identifies the call site when instrumentation is enabled; it must
+  // be a string with static storage duration.
+  //
   // @return true if the operation was successfully enqueued or false if the
   //     operation was not enqueued because the `AsyncQueue` has already entered
   //     restricted mode or been disposed.
-  bool Enqueue(const Operation& operation);
+  bool Enqueue(const Operation& operation, const char* label = nullptr);
 
   // Like `Enqueue`, but it will proceed scheduling the requested operation
   // regardless of whether the queue is in restricted mode or not.
@@ -160,10 +168,11 @@ class AsyncQueue : public std::enable_shared_from_this<AsyncQueue> {
   // @return true if the operation was successfully enqueued or false if the
   //     operation was not enqueued because the `AsyncQueue` has already been
   //     disposed.
-  bool EnqueueEvenWhileRestricted(const Operation& operation);
+  bool EnqueueEvenWhileRestricted(const Operation& operation,
+                                  const char* label = nullptr);
 
   // Like `Enqueue`, but without applying any prerequisite checks.
-  bool EnqueueRelaxed(const Operation& operation);
+  bool EnqueueRelaxed(const Operation& operation, const char* label = nullptr);
 
   // Returns true if the queue is still in the main kRunning mode (i.e. not
   // restricted or disposed).
@@ -200,6 +209,25 @@ class AsyncQueue : public std::enable_shared_from_this<AsyncQueue> {
   // queue.
   void ExecuteBlocking(const Operation& operation);
 
+  // Instrumentation
+
+  // Starts collecting per-operation wait and run times, queue depth and a trace
+  // of operations whose wait or run time is at least `slow_threshold`.
+  // Immediate operations are labeled by the `label` passed when enqueueing
+  // them and delayed operations by their `TimerId`.
+  //
+  // Instrumentation is off by default and costs nothing while off. Enabling it
+  // again discards the previously collected stats.
+  void EnableInstrumentation(std::chrono::microseconds slow_threshold);
+
+  // Stops collecting stats. Operations already on the queue still report to
+  // the stats that were active when they were enqueued.
+  void DisableInstrumentation();
+
+  // Returns the stats being collected, or nullptr if instrumentation is not
+  // enabled.
+  std::shared_ptr<AsyncQueueStats> stats() const;
+
   // Returns the underlying platform-dependent executor.
   Executor* executor() {
     return executor_.get();
@@ -231,7 +259,15 @@ class AsyncQueue : public std::enable_shared_from_this<AsyncQueue> {
  private:
   explicit AsyncQueue(std::unique_ptr<Executor> executor);
 
-  Operation Wrap(const Operation& operation);
+  // Wraps `operation` for execution on the queue. If instrumentation is
+  // enabled, the wrapper also reports to `stats_`, treating the operation as
+  // runnable once `delay` has elapsed.
+  //
+  // Precondition: `mutex_` is held.
+  Operation Wrap(const Operation& operation,
+                 const char* label,
+                 bool immediate,
+                 Milliseconds delay = Milliseconds(0));
 
   // Asserts that the current invocation happens asynchronously on the queue.
   void VerifyIsCurrentExecutor() const;
@@ -244,6 +280,8 @@ class AsyncQueue : public std::enable_shared_from_this<AsyncQueue> {
   Mode mode_ = Mode::kRunning;
 
   std::vector<TimerId> timer_ids_to_skip_;
+
+  std::shared_ptr<AsyncQueueStats> stats_;
 };
 
 }  // namespace util
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/util/async_queue_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "Firestore/core/src/util/log.h"
+#include "absl/strings/str_cat.h"
+
+namespace firebase {
+namespace firestore {
+namespace util {
+namespace {
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+int BucketFor(microseconds latency) {
+  uint64_t value = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+  int bucket = 0;
+  while (value != 0 && bucket < LatencyHistogram::kBucketCount - 1) {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+microseconds BucketUpperBound(int bucket) {
+  return microseconds(int64_t{1} << bucket);
+}
+
+void AppendHistogram(std::string* out,
+                     absl::string_view name,
+                     const LatencyHistogram& histogram) {
+  absl::StrAppend(out, "    ", name, ": p50<=", histogram.Percentile(50).count(),
+                  "us p99<=", histogram.Percentile(99).count(),
+                  "us max=", histogram.max().count(),
+                  "us total=", histogram.total().count(), "us\n");
+}
+
+}  // namespace
+
+// MARK: - LatencyHistogram
+
+void LatencyHistogram::Record(microseconds latency) {
+  buckets_[BucketFor(latency)]++;
+  count_++;
+  total_ += latency;
+  max_ = std::max(max_, latency);
+}
+
+microseconds LatencyHistogram::Percentile(double percentile) const {
+  if (count_ == 0) return microseconds(0);
+
+  auto rank = static_cast<int64_t>(
+      std::ceil(static_cast<double>(count_) * percentile / 100.0));
+  rank = std::min(std::max<int64_t>(rank, 1), count_);
+
+  int64_t seen = 0;
+  for (int i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      // Never report more than the largest sample actually seen.
+      return std::min(BucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+// MARK: - AsyncQueueStats
+
+AsyncQueueStats::AsyncQueueStats(microseconds slow_threshold,
+                                 size_t max_slow_operations)
+    : slow_threshold_(slow_threshold),
+      max_slow_operations_(max_slow_operations) {
+}
+
+void AsyncQueueStats::OperationEnqueued() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_depth_++;
+  max_queue_depth_ = std::max(max_queue_depth_, queue_depth_);
+}
+
+void AsyncQueueStats::OperationDropped() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_depth_ = std::max<int64_t>(queue_depth_ - 1, 0);
+}
+
+void AsyncQueueStats::RecordOperation(const char* label,
+                                      Clock::time_point runnable_at,
+                                      Clock::time_point started_at,
+                                      Clock::time_point finished_at,
+                                      bool immediate) {
+  // Delayed operations that were run early (e.g. by tests) have a due time in
+  // the future, which counts as no wait.
+  auto wait_time =
+      std::max(duration_cast<microseconds>(started_at - runnable_at),
+               microseconds(0));
+  auto run_time = duration_cast<microseconds>(finished_at - started_at);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (immediate) {
+    queue_depth_ = std::max<int64_t>(queue_depth_ - 1, 0);
+  }
+
+  auto found = task_stats_.find(label);
+  if (found == task_stats_.end()) {
+    found = task_stats_.emplace(label, AsyncQueueTaskStats{}).first;
+  }
+  found->second.wait_time.Record(wait_time);
+  found->second.run_time.Record(run_time);
+
+  if (wait_time < slow_threshold_ && run_time < slow_threshold_) return;
+
+  LOG_DEBUG("Slow AsyncQueue operation %s: waited %sus, ran %sus", label,
+            wait_time.count(), run_time.count());
+
+  if (max_slow_operations_ == 0) return;
+  if (slow_operations_.size() == max_slow_operations_) {
+    slow_operations_.pop_front();
+  }
+  slow_operations_.push_back(
+      SlowOperation{label, started_at, wait_time, run_time, queue_depth_});
+}
+
+AsyncQueueStats::TaskStatsMap AsyncQueueStats::GetTaskStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return task_stats_;
+}
+
+std::vector<SlowOperation> AsyncQueueStats::GetSlowOperations() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {slow_operations_.begin(), slow_operations_.end()};
+}
+
+int64_t AsyncQueueStats::queue_depth() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_depth_;
+}
+
+int64_t AsyncQueueStats::max_queue_depth() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_queue_depth_;
+}
+
+std::string AsyncQueueStats::ToString() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::string result =
+      absl::StrCat("AsyncQueueStats(queue_depth=", queue_depth_,
+                   ", max_queue_depth=", max_queue_depth_, ")\n");
+  for (const auto& entry : task_stats_) {
+    absl::StrAppend(&result, "  ", entry.first,
+                    " (count=", entry.second.run_time.count(), ")\n");
+    AppendHistogram(&result, "wait", entry.second.wait_time);
+    AppendHistogram(&result, "run", entry.second.run_time);
+  }
+
+  if (!slow_operations_.empty()) {
+    absl::StrAppend(&result, "Slow operations (threshold ",
+                    slow_threshold_.count(), "us), oldest first:\n");
+    Clock::time_point first = slow_operations_.front().started_at;
+    for (const SlowOperation& op : slow_operations_) {
+      auto offset = duration_cast<microseconds>(op.started_at - first);
+      absl::StrAppend(&result, "  +", offset.count(), "us ", op.label,
+                      ": waited ", op.wait_time.count(), "us, ran ",
+                      op.run_time.count(), "us, ", op.queue_depth,
+                      " queued behind\n");
+    }
+  }
+  return result;
+}
+
+void AsyncQueueStats::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  task_stats_.clear();
+  slow_operations_.clear();
+  max_queue_depth_ = queue_depth_;
+}
+
+}  // namespace util
+}  // namespace firestore
+}  // namespace firebase
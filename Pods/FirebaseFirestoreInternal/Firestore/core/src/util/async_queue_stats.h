@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIRESTORE_CORE_SRC_UTIL_ASYNC_QUEUE_STATS_H_
+#define FIRESTORE_CORE_SRC_UTIL_ASYNC_QUEUE_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace firebase {
+namespace firestore {
+namespace util {
+
+/**
+ * A fixed-size latency histogram with power-of-two microsecond buckets.
+ *
+ * Bucket `i` counts samples in `[2^(i-1), 2^i)` microseconds (bucket 0 holds
+ * samples under one microsecond), so the histogram spans sub-microsecond
+ * operations up to stalls of over half an hour without allocating.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kBucketCount = 32;
+
+  void Record(std::chrono::microseconds latency);
+
+  int64_t count() const {
+    return count_;
+  }
+
+  std::chrono::microseconds total() const {
+    return total_;
+  }
+
+  std::chrono::microseconds max() const {
+    return max_;
+  }
+
+  const std::array<int64_t, kBucketCount>& buckets() const {
+    return buckets_;
+  }
+
+  /**
+   * Returns an upper bound for the given percentile (in the range [0, 100]),
+   * accurate to within the bucket that contains it.
+   */
+  std::chrono::microseconds Percentile(double percentile) const;
+
+ private:
+  std::array<int64_t, kBucketCount> buckets_{};
+  int64_t count_ = 0;
+  std::chrono::microseconds total_{0};
+  std::chrono::microseconds max_{0};
+};
+
+/**
+ * Latency distributions for all operations that share a label: the time each
+ * operation waited between becoming runnable and starting, and the time it
+ * spent running.
+ */
+struct AsyncQueueTaskStats {
+  LatencyHistogram wait_time;
+  LatencyHistogram run_time;
+};
+
+/**
+ * A record of a single operation whose wait or run time exceeded the slow
+ * operation threshold.
+ */
+struct SlowOperation {
+  std::string label;
+  std::chrono::steady_clock::time_point started_at;
+  std::chrono::microseconds wait_time{0};
+  std::chrono::microseconds run_time{0};
+
+  // The number of immediate operations that were queued behind this one when
+  // it started.
+  int64_t queue_depth = 0;
+};
+
+/**
+ * Opt-in instrumentation for an `AsyncQueue`. Collects per-label wait and run
+ * time histograms, tracks the number of immediate operations waiting to run,
+ * and keeps a bounded trace of the most recent slow operations.
+ *
+ * Recording happens on the queue while reads may happen from any thread, so
+ * all accessors are thread-safe.
+ */
+class AsyncQueueStats {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using TaskStatsMap = std::map<std::string, AsyncQueueTaskStats, std::less<>>;
+
+  /**
+   * Creates stats that trace operations whose wait or run time is at least
+   * `slow_threshold`, keeping at most `max_slow_operations` of them.
+   */
+  explicit AsyncQueueStats(std::chrono::microseconds slow_threshold,
+                           size_t max_slow_operations = 64);
+
+  /** Notes that an immediate operation has been put on the queue. */
+  void OperationEnqueued();
+
+  /**
+   * Notes that an immediate operation counted by `OperationEnqueued` was
+   * discarded without running, for example because the queue was disposed.
+   */
+  void OperationDropped();
+
+  /**
+   * Records a completed operation.
+   *
+   * @param label Identifies the call site or timer that enqueued the
+   *     operation.
+   * @param runnable_at The time the operation became eligible to run: the
+   *     enqueue time for immediate operations or the due time for delayed
+   *     ones.
+   * @param immediate Whether the operation was counted by `OperationEnqueued`.
+   */
+  void RecordOperation(const char* label,
+                       Clock::time_point runnable_at,
+                       Clock::time_point started_at,
+                       Clock::time_point finished_at,
+                       bool immediate);
+
+  /** Returns a copy of the histograms collected so far, keyed by label. */
+  TaskStatsMap GetTaskStats() const;
+
+  /** Returns the most recent slow operations, oldest first. */
+  std::vector<SlowOperation> GetSlowOperations() const;
+
+  /** The number of immediate operations currently waiting to run. */
+  int64_t queue_depth() const;
+
+  /** The largest value `queue_depth` has reached. */
+  int64_t max_queue_depth() const;
+
+  /**
+   * Returns a human-readable summary of the histograms followed by a trace of
+   * the recorded slow operations.
+   */
+  std::string ToString() const;
+
+  /** Discards all data collected so far, except the current queue depth. */
+  void Reset();
+
+ private:
+  const std::chrono::microseconds slow_threshold_;
+  const size_t max_slow_operations_;
+
+  mutable std::mutex mutex_;
+  TaskStatsMap task_stats_;
+  std::deque<SlowOperation> slow_operations_;
+  int64_t queue_depth_ = 0;
+  int64_t max_queue_depth_ = 0;
+};
+
+}  // namespace util
+}  // namespace firestore
+}  // namespace firebase
+
+#endif  // FIRESTORE_CORE_SRC_UTIL_ASYNC_QUEUE_STATS_H_
@@ -26,8 +26,15 @@
 #include "absl/base/internal/endian.h"
 #include "absl/base/internal/unaligned_access.h"
 #include "absl/base/port.h"
+#include "absl/numeric/bits.h"
 #include "absl/strings/internal/resize_uninitialized.h"
 
+#if defined(ABSL_INTERNAL_HAVE_SSE2)
+#include <emmintrin.h>
+#elif defined(ABSL_INTERNAL_HAVE_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #if !defined(ABSL_IS_LITTLE_ENDIAN) && !defined(ABSL_IS_BIG_ENDIAN)
 #error \
     "Unsupported byte order: Either ABSL_IS_BIG_ENDIAN or " \
@@ -271,6 +278,40 @@ inline const char* SkipToNextSpecialByte(const char* start, const char* limit) {
   static_assert(kEscape1 == 0, "bit fiddling needs readjusting");
   static_assert((kEscape2 & 0xff) == 255, "bit fiddling needs readjusting");
   const char* p = start;
+
+  // Where available, check 16 bytes at a time with vector compares. Strings
+  // rarely contain special bytes, so this usually scans the whole string. The
+  // word-at-a-time loop below handles the remainder.
+#if defined(ABSL_INTERNAL_HAVE_SSE2)
+  const __m128i zeros = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi8(static_cast<char>(0xff));
+  while (p + 16 <= limit) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i special =
+        _mm_or_si128(_mm_cmpeq_epi8(v, zeros), _mm_cmpeq_epi8(v, ones));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask != 0) {
+      return p + absl::countr_zero(mask);
+    }
+    p += 16;
+  }
+#elif defined(ABSL_INTERNAL_HAVE_ARM_NEON)
+  const uint8x16_t one = vdupq_n_u8(1);
+  while (p + 16 <= limit) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    // (x + 1) <= 1 only holds for x = 0x00 and x = 0xff.
+    uint8x16_t special = vcleq_u8(vaddq_u8(v, one), one);
+    // Narrow each byte of the comparison result to a nibble, giving a 64-bit
+    // mask in which the first special byte has the lowest set bit.
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+    if (mask != 0) {
+      return p + absl::countr_zero(mask) / 4;
+    }
+    p += 16;
+  }
+#endif
+
   while (p + 8 <= limit) {
     // Find out if any of the next 8 bytes are either 0 or 255 (our
     // two characters that require special handling).  We do this using
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/core/view.h"
+
+#include <string>
+#include <vector>
+
+#include "Firestore/core/include/firebase/firestore/timestamp.h"
+#include "Firestore/core/src/core/query.h"
+#include "Firestore/core/src/local/query_result.h"
+#include "Firestore/core/src/model/document.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/model/document_set.h"
+#include "Firestore/core/src/model/mutable_document.h"
+#include "Firestore/core/src/model/object_value.h"
+#include "Firestore/core/src/model/resource_path.h"
+#include "Firestore/core/src/model/snapshot_version.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace core {
+namespace {
+
+using local::QueryResult;
+using model::Document;
+using model::DocumentKey;
+using model::DocumentKeySet;
+using model::DocumentMap;
+using model::DocumentSet;
+using model::MutableDocument;
+using model::ObjectValue;
+using model::ResourcePath;
+using model::SnapshotVersion;
+using testing::ElementsAre;
+
+DocumentKey Key(const std::string& id) {
+  return DocumentKey::FromSegments({"rooms", id});
+}
+
+Document Doc(const std::string& id) {
+  return MutableDocument::FoundDocument(
+      Key(id), SnapshotVersion(Timestamp(1, 0)), ObjectValue{});
+}
+
+Document DeletedDoc(const std::string& id) {
+  return MutableDocument::NoDocument(Key(id),
+                                     SnapshotVersion(Timestamp(2, 0)));
+}
+
+DocumentMap Docs(const std::vector<Document>& docs) {
+  DocumentMap result;
+  for (const Document& doc : docs) {
+    result = result.insert(doc->key(), doc);
+  }
+  return result;
+}
+
+std::vector<std::string> Ids(const DocumentSet& docs) {
+  std::vector<std::string> result;
+  for (const Document& doc : docs) {
+    result.push_back(doc->key().path().last_segment());
+  }
+  return result;
+}
+
+Query LimitQuery() {
+  return Query(ResourcePath{"rooms"}).WithLimitToFirst(2);
+}
+
+TEST(ViewTest, SeedsBufferFromCompleteQueryResult) {
+  View view(LimitQuery(), DocumentKeySet{});
+  ViewDocumentChanges changes = view.ComputeDocumentChanges(
+      QueryResult(Docs({Doc("a"), Doc("b"), Doc("c"), Doc("d")}),
+                  DocumentKeySet{}, /* has_all_matches= */ true));
+
+  EXPECT_FALSE(changes.needs_refill());
+  EXPECT_THAT(Ids(changes.document_set()), ElementsAre("a", "b"));
+  EXPECT_THAT(Ids(changes.overflow_documents()), ElementsAre("c", "d"));
+}
+
+TEST(ViewTest, DoesNotBufferIncompleteQueryResult) {
+  View view(LimitQuery(), DocumentKeySet{});
+  ViewDocumentChanges changes = view.ComputeDocumentChanges(
+      QueryResult(Docs({Doc("a"), Doc("b"), Doc("c")}), DocumentKeySet{},
+                  /* has_all_matches= */ false));
+
+  EXPECT_THAT(Ids(changes.document_set()), ElementsAre("a", "b"));
+  EXPECT_TRUE(changes.overflow_documents().empty());
+}
+
+TEST(ViewTest, ServesDeleteFromFullWindowWithoutRefill) {
+  View view(LimitQuery(), DocumentKeySet{});
+  view.ApplyChanges(view.ComputeDocumentChanges(
+      QueryResult(Docs({Doc("a"), Doc("b"), Doc("c"), Doc("d")}),
+                  DocumentKeySet{}, /* has_all_matches= */ true)));
+
+  ViewDocumentChanges changes =
+      view.ComputeDocumentChanges(Docs({DeletedDoc("a")}));
+
+  EXPECT_FALSE(changes.needs_refill());
+  EXPECT_THAT(Ids(changes.document_set()), ElementsAre("b", "c"));
+  EXPECT_THAT(Ids(changes.overflow_documents()), ElementsAre("d"));
+}
+
+TEST(ViewTest, TopsUpBufferOnRefill) {
+  View view(LimitQuery(), DocumentKeySet{});
+  view.ApplyChanges(view.ComputeDocumentChanges(
+      QueryResult(Docs({Doc("a"), Doc("b"), Doc("c")}), DocumentKeySet{},
+                  /* has_all_matches= */ false)));
+
+  // Without a buffer, the delete has to go back to the local cache.
+  ViewDocumentChanges changes =
+      view.ComputeDocumentChanges(Docs({DeletedDoc("a")}));
+  ASSERT_TRUE(changes.needs_refill());
+
+  changes = view.ComputeDocumentChanges(
+      QueryResult(Docs({Doc("b"), Doc("c"), Doc("d"), Doc("e")}),
+                  DocumentKeySet{}, /* has_all_matches= */ true),
+      changes);
+  EXPECT_FALSE(changes.needs_refill());
+  EXPECT_THAT(Ids(changes.document_set()), ElementsAre("b", "c"));
+  EXPECT_THAT(Ids(changes.overflow_documents()), ElementsAre("d", "e"));
+  view.ApplyChanges(changes);
+
+  // The refilled buffer serves the next delete.
+  changes = view.ComputeDocumentChanges(Docs({DeletedDoc("b")}));
+  EXPECT_FALSE(changes.needs_refill());
+  EXPECT_THAT(Ids(changes.document_set()), ElementsAre("c", "d"));
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace firestore
+}  // namespace firebase
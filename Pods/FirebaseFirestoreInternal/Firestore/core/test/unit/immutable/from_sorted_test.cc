@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Firestore/core/src/immutable/llrb_node.h"
+#include "Firestore/core/src/immutable/sorted_map.h"
+#include "Firestore/core/src/immutable/sorted_set.h"
+#include "Firestore/core/src/immutable/tree_sorted_map.h"
+#include "Firestore/core/src/util/comparison.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace immutable {
+namespace {
+
+using IntMap = SortedMap<int, int>;
+using IntSet = SortedSet<int>;
+using IntTreeMap = impl::TreeSortedMap<int, int, util::Comparator<int>>;
+using IntNode = impl::LlrbNode<int, int>;
+
+std::vector<int> Sequence(int size) {
+  std::vector<int> result;
+  for (int i = 0; i < size; ++i) {
+    result.push_back(i * 2);
+  }
+  return result;
+}
+
+IntMap MapFromSorted(const std::vector<int>& keys) {
+  return IntMap::FromSorted(keys.size(), [&keys](size_t i) {
+    return std::make_pair(keys[i], keys[i] + 1);
+  });
+}
+
+IntTreeMap TreeFromSorted(const std::vector<int>& keys) {
+  return IntTreeMap::FromSorted(
+      keys.size(),
+      [&keys](size_t i) { return std::make_pair(keys[i], keys[i] + 1); },
+      util::Comparator<int>());
+}
+
+/**
+ * Checks the left-leaning red-black invariants below `node` and returns its
+ * black height.
+ */
+int CheckInvariants(const IntNode& node) {
+  if (node.empty()) return 1;
+
+  EXPECT_FALSE(node.right().red()) << "red right link at " << node.key();
+  if (node.red()) {
+    EXPECT_FALSE(node.left().red()) << "two red links at " << node.key();
+  }
+  if (!node.left().empty()) {
+    EXPECT_LT(node.left().key(), node.key());
+  }
+  if (!node.right().empty()) {
+    EXPECT_GT(node.right().key(), node.key());
+  }
+
+  int left_height = CheckInvariants(node.left());
+  int right_height = CheckInvariants(node.right());
+  EXPECT_EQ(left_height, right_height) << "unbalanced at " << node.key();
+  return left_height + (node.red() ? 0 : 1);
+}
+
+TEST(FromSortedTest, BuildsValidTrees) {
+  for (int size = 0; size <= 300; ++size) {
+    SCOPED_TRACE(size);
+    IntTreeMap map = TreeFromSorted(Sequence(size));
+    EXPECT_EQ(map.size(), static_cast<size_t>(size));
+    EXPECT_FALSE(map.root().red());
+    CheckInvariants(map.root());
+  }
+}
+
+// Sizes on either side of powers of two change the shape of the tree most.
+TEST(FromSortedTest, BuildsValidTreesAroundPowersOfTwo) {
+  for (int power = 9; power <= 14; ++power) {
+    for (int delta : {-2, -1, 0, 1}) {
+      int size = (1 << power) + delta;
+      SCOPED_TRACE(size);
+      IntTreeMap map = TreeFromSorted(Sequence(size));
+      EXPECT_EQ(map.size(), static_cast<size_t>(size));
+      CheckInvariants(map.root());
+    }
+  }
+}
+
+TEST(FromSortedTest, MatchesInsertion) {
+  // Covers both the array and the tree representation.
+  for (int size : {0, 1, 2, 24, 25, 26, 100, 1000}) {
+    SCOPED_TRACE(size);
+    std::vector<int> keys = Sequence(size);
+    IntMap built = MapFromSorted(keys);
+
+    IntMap inserted;
+    for (int key : keys) {
+      inserted = inserted.insert(key, key + 1);
+    }
+    EXPECT_EQ(built.size(), inserted.size());
+    EXPECT_TRUE(std::equal(built.begin(), built.end(), inserted.begin(),
+                           inserted.end()));
+
+    for (int key : keys) {
+      auto found = built.find(key);
+      ASSERT_NE(found, built.end());
+      EXPECT_EQ(found->second, key + 1);
+      // Odd keys fall between the entries.
+      EXPECT_EQ(built.find(key + 1), built.end());
+    }
+
+    // The result is an ordinary map that can be modified further.
+    IntMap modified = built.insert(-1, 0).erase(0);
+    EXPECT_EQ(modified.size(), built.size() + (size == 0 ? 1 : 0));
+    EXPECT_EQ(modified.begin()->first, -1);
+  }
+}
+
+TEST(FromSortedTest, BuildsSets) {
+  for (int size : {0, 1, 25, 26, 500}) {
+    SCOPED_TRACE(size);
+    std::vector<int> keys = Sequence(size);
+    IntSet set = IntSet::FromSorted(keys.begin(), keys.end());
+    EXPECT_EQ(set.size(), keys.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), keys.begin(), keys.end()));
+  }
+}
+
+TEST(FromSortedTest, RejectsUnsortedInput) {
+  for (int size : {3, 25, 26, 500}) {
+    SCOPED_TRACE(size);
+    std::vector<int> keys = Sequence(size);
+    std::swap(keys[1], keys[2]);
+    EXPECT_ANY_THROW(MapFromSorted(keys));
+
+    keys = Sequence(size);
+    std::swap(keys.front(), keys.back());
+    EXPECT_ANY_THROW(IntSet::FromSorted(keys.begin(), keys.end()));
+  }
+}
+
+TEST(FromSortedTest, RejectsDuplicateInput) {
+  for (int size : {2, 25, 26, 500}) {
+    SCOPED_TRACE(size);
+    std::vector<int> keys = Sequence(size);
+    keys[size / 2] = keys[size / 2 - 1];
+    EXPECT_ANY_THROW(MapFromSorted(keys));
+    EXPECT_ANY_THROW(IntSet::FromSorted(keys.begin(), keys.end()));
+  }
+}
+
+}  // namespace
+}  // namespace immutable
+}  // namespace firestore
+}  // namespace firebase
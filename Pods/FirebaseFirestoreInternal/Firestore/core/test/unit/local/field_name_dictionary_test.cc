@@ -0,0 +1,346 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/field_name_dictionary.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Firestore/Protos/nanopb/firestore/local/maybe_document.nanopb.h"
+#include "Firestore/core/src/credentials/user.h"
+#include "Firestore/core/src/local/leveldb_field_name_dictionary.h"
+#include "Firestore/core/src/local/leveldb_key.h"
+#include "Firestore/core/src/local/leveldb_migrations.h"
+#include "Firestore/core/src/local/leveldb_persistence.h"
+#include "Firestore/core/src/local/leveldb_remote_document_cache.h"
+#include "Firestore/core/src/local/local_serializer.h"
+#include "Firestore/core/src/model/database_id.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/model/field_path.h"
+#include "Firestore/core/src/model/mutable_document.h"
+#include "Firestore/core/src/model/object_value.h"
+#include "Firestore/core/src/model/snapshot_version.h"
+#include "Firestore/core/src/model/value_util.h"
+#include "Firestore/core/src/nanopb/message.h"
+#include "Firestore/core/src/nanopb/nanopb_util.h"
+#include "Firestore/core/src/nanopb/reader.h"
+#include "Firestore/core/src/nanopb/writer.h"
+#include "Firestore/core/src/remote/serializer.h"
+#include "Firestore/core/src/util/filesystem.h"
+#include "Firestore/core/src/util/path.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+namespace {
+
+using credentials::User;
+using model::DatabaseId;
+using model::DocumentKey;
+using model::FieldPath;
+using model::MutableDocument;
+using model::ObjectValue;
+using model::SnapshotVersion;
+using nanopb::Message;
+using nanopb::StringReader;
+using nanopb::StringWriter;
+using util::Filesystem;
+using util::Path;
+
+/** A dictionary that only lives in memory. */
+class InMemoryFieldNameDictionary : public FieldNameDictionary {
+ public:
+  int32_t GetOrAssignId(absl::string_view field_name) override {
+    auto found = ids_.find(std::string(field_name));
+    if (found != ids_.end()) {
+      return found->second;
+    }
+    auto id = static_cast<int32_t>(field_names_.size());
+    field_names_.push_back(std::make_unique<std::string>(field_name));
+    ids_.emplace(std::string(field_name), id);
+    return id;
+  }
+
+  const std::string* FindFieldName(int32_t id) const override {
+    if (id < 0 || id >= static_cast<int32_t>(field_names_.size())) {
+      return nullptr;
+    }
+    return field_names_[id].get();
+  }
+
+  size_t size() const {
+    return field_names_.size();
+  }
+
+ private:
+  std::vector<std::unique_ptr<std::string>> field_names_;
+  std::map<std::string, int32_t> ids_;
+};
+
+LocalSerializer MakeSerializer() {
+  return LocalSerializer{remote::Serializer{DatabaseId{"p"}}};
+}
+
+Message<google_firestore_v1_Value> StringValue(const std::string& value) {
+  Message<google_firestore_v1_Value> result;
+  result->which_value_type = google_firestore_v1_Value_string_value_tag;
+  result->string_value = nanopb::MakeBytesArray(value);
+  return result;
+}
+
+/** Returns an array holding two maps with overlapping field names. */
+Message<google_firestore_v1_Value> ArrayOfMaps() {
+  ObjectValue first;
+  first.Set(FieldPath::FromDotSeparatedString("label"), StringValue("one"));
+  first.Set(FieldPath::FromDotSeparatedString("a_rather_long_field_name"),
+            StringValue("1"));
+  ObjectValue second;
+  second.Set(FieldPath::FromDotSeparatedString("label"), StringValue("two"));
+
+  Message<google_firestore_v1_Value> result;
+  result->which_value_type = google_firestore_v1_Value_array_value_tag;
+  result->array_value.values_count = 2;
+  result->array_value.values =
+      nanopb::MakeArray<google_firestore_v1_Value>(2);
+  result->array_value.values[0] = *model::DeepClone(first.Get()).release();
+  result->array_value.values[1] = *model::DeepClone(second.Get()).release();
+  return result;
+}
+
+MutableDocument Doc(const std::string& path) {
+  ObjectValue data;
+  data.Set(FieldPath::FromDotSeparatedString("name"), StringValue(path));
+  data.Set(FieldPath::FromDotSeparatedString("nested.inner.value"),
+           StringValue("deep"));
+  data.Set(FieldPath::FromDotSeparatedString("items"), ArrayOfMaps());
+  return MutableDocument::FoundDocument(DocumentKey::FromPathString(path),
+                                        SnapshotVersion::None(),
+                                        std::move(data));
+}
+
+std::string Serialize(const Message<firestore_client_MaybeDocument>& message) {
+  StringWriter writer;
+  writer.Write(firestore_client_MaybeDocument_fields, message.get());
+  return writer.Release();
+}
+
+TEST(FieldNameDictionaryTest, SerializerRoundTripsNestedFieldNames) {
+  LocalSerializer serializer = MakeSerializer();
+  InMemoryFieldNameDictionary dictionary;
+  MutableDocument document = Doc("coll/doc");
+
+  std::string encoded =
+      Serialize(serializer.EncodeMaybeDocument(document, &dictionary));
+  // name, nested, inner, value, items, label and a_rather_long_field_name.
+  EXPECT_EQ(dictionary.size(), 7u);
+  EXPECT_FALSE(absl::StrContains(encoded, "a_rather_long_field_name"));
+
+  StringReader reader{encoded};
+  auto message = Message<firestore_client_MaybeDocument>::TryParse(&reader);
+  MutableDocument decoded =
+      serializer.DecodeMaybeDocument(&reader, *message, dictionary);
+  ASSERT_TRUE(reader.ok()) << reader.status().ToString();
+  EXPECT_EQ(decoded, document);
+
+  // Encoding again reuses the assigned IDs.
+  serializer.EncodeMaybeDocument(Doc("coll/other"), &dictionary);
+  EXPECT_EQ(dictionary.size(), 7u);
+}
+
+TEST(FieldNameDictionaryTest, SerializerFailsOnUnknownId) {
+  LocalSerializer serializer = MakeSerializer();
+  InMemoryFieldNameDictionary dictionary;
+  std::string encoded =
+      Serialize(serializer.EncodeMaybeDocument(Doc("coll/doc"), &dictionary));
+
+  InMemoryFieldNameDictionary empty;
+  StringReader reader{encoded};
+  auto message = Message<firestore_client_MaybeDocument>::TryParse(&reader);
+  serializer.DecodeMaybeDocument(&reader, *message, empty);
+  EXPECT_FALSE(reader.ok());
+}
+
+class LevelDbFieldNameDictionaryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = Filesystem::Default()->TempDir().AppendUtf8(
+        "leveldb_field_name_dictionary_test");
+    Filesystem::Default()->RecursivelyRemove(dir_);
+    Open(true);
+  }
+
+  void TearDown() override {
+    Close();
+    Filesystem::Default()->RecursivelyRemove(dir_);
+  }
+
+  void Open(bool field_name_dictionary_enabled) {
+    auto created =
+        LevelDbPersistence::Create(dir_, MakeSerializer(), LruParams::Default());
+    ASSERT_TRUE(created.ok()) << created.status().ToString();
+    persistence_ = std::move(created).ValueOrDie();
+    persistence_->SetFieldNameDictionaryEnabled(field_name_dictionary_enabled);
+    cache()->SetIndexManager(
+        persistence_->GetIndexManager(User::Unauthenticated()));
+  }
+
+  void Close() {
+    if (persistence_) {
+      persistence_->Shutdown();
+      persistence_.reset();
+    }
+  }
+
+  LevelDbRemoteDocumentCache* cache() {
+    return persistence_->remote_document_cache();
+  }
+
+  void Add(const MutableDocument& document) {
+    persistence_->Run("Add document", [&] {
+      cache()->Add(document, SnapshotVersion::None());
+    });
+  }
+
+  void ExpectStored(const MutableDocument& document) {
+    persistence_->Run("Get document", [&] {
+      EXPECT_EQ(cache()->Get(document.key()), document);
+    });
+  }
+
+  /** Whether the stored form of the document uses the dictionary. */
+  bool IsEncoded(const DocumentKey& key) {
+    std::string value;
+    persistence_->Run("Read document", [&] {
+      EXPECT_TRUE(persistence_->current_transaction()
+                      ->Get(LevelDbRemoteDocumentKey::Key(key), &value)
+                      .ok());
+    });
+    return absl::StartsWith(value, kFieldNameDictionaryPrefix);
+  }
+
+  bool HasFieldNames() {
+    bool found = false;
+    persistence_->Run("Read field names", [&] {
+      std::string prefix = LevelDbFieldNameKey::KeyPrefix();
+      auto it = persistence_->current_transaction()->NewIterator();
+      it->Seek(prefix);
+      found = it->Valid() && absl::StartsWith(it->key(), prefix);
+    });
+    return found;
+  }
+
+  Path dir_;
+  std::unique_ptr<LevelDbPersistence> persistence_;
+};
+
+TEST_F(LevelDbFieldNameDictionaryTest, RoundTripsAcrossRestarts) {
+  MutableDocument document = Doc("coll/doc");
+  Add(document);
+  ExpectStored(document);
+  EXPECT_TRUE(IsEncoded(document.key()));
+
+  Close();
+  Open(true);
+  ExpectStored(document);
+
+  // The assigned IDs were persisted and are shared by the collection group.
+  persistence_->Run("Read dictionary", [&] {
+    LevelDbFieldNameDictionary dictionary(persistence_.get(), "coll");
+    const std::string* name = dictionary.FindFieldName(0);
+    ASSERT_NE(name, nullptr);
+    EXPECT_EQ(dictionary.GetOrAssignId(*name), 0);
+    EXPECT_NE(dictionary.FindFieldName(6), nullptr);
+    EXPECT_EQ(dictionary.FindFieldName(7), nullptr);
+  });
+
+  // Documents in subcollections of the same collection group share the IDs.
+  MutableDocument nested = Doc("other/doc/coll/doc");
+  Add(nested);
+  ExpectStored(nested);
+  persistence_->Run("Read dictionary", [&] {
+    LevelDbFieldNameDictionary dictionary(persistence_.get(), "coll");
+    EXPECT_EQ(dictionary.FindFieldName(7), nullptr);
+  });
+}
+
+TEST_F(LevelDbFieldNameDictionaryTest, StoresEmptyDocumentsPlainly) {
+  auto empty = MutableDocument::FoundDocument(
+      DocumentKey::FromPathString("coll/empty"), SnapshotVersion::None(),
+      ObjectValue{});
+  auto missing = MutableDocument::NoDocument(
+      DocumentKey::FromPathString("coll/missing"), SnapshotVersion::None());
+  Add(empty);
+  Add(missing);
+
+  EXPECT_FALSE(IsEncoded(empty.key()));
+  EXPECT_FALSE(IsEncoded(missing.key()));
+  EXPECT_FALSE(HasFieldNames());
+  ExpectStored(empty);
+  ExpectStored(missing);
+}
+
+TEST_F(LevelDbFieldNameDictionaryTest, DisablingRewritesDocuments) {
+  std::vector<MutableDocument> documents;
+  for (int i = 0; i < 1200; ++i) {
+    documents.push_back(Doc(absl::StrCat(i % 2 ? "a" : "b", "/doc", i)));
+  }
+  // Store some documents plainly too.
+  persistence_->SetFieldNameDictionaryEnabled(false);
+  Add(documents[0]);
+  persistence_->SetFieldNameDictionaryEnabled(true);
+  for (size_t i = 1; i < documents.size(); ++i) {
+    Add(documents[i]);
+  }
+  EXPECT_TRUE(HasFieldNames());
+
+  Close();
+  Open(false);
+  EXPECT_FALSE(HasFieldNames());
+  for (const MutableDocument& document : documents) {
+    EXPECT_FALSE(IsEncoded(document.key()));
+    ExpectStored(document);
+  }
+}
+
+TEST_F(LevelDbFieldNameDictionaryTest, DowngradeRewritesDocuments) {
+  MutableDocument document = Doc("coll/doc");
+  Add(document);
+  EXPECT_TRUE(IsEncoded(document.key()));
+
+  LevelDbMigrations::RunMigrations(persistence_->ptr(), 8, MakeSerializer());
+  EXPECT_EQ(LevelDbMigrations::ReadSchemaVersion(persistence_->ptr()), 8);
+  EXPECT_FALSE(IsEncoded(document.key()));
+  EXPECT_FALSE(HasFieldNames());
+
+  // Upgrading again leaves plain documents alone.
+  Close();
+  Open(true);
+  EXPECT_EQ(LevelDbMigrations::ReadSchemaVersion(persistence_->ptr()),
+            kSchemaVersion);
+  EXPECT_FALSE(IsEncoded(document.key()));
+  ExpectStored(document);
+}
+
+}  // namespace
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
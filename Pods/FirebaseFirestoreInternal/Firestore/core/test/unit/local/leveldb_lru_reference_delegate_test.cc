@@ -0,0 +1,259 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/leveldb_lru_reference_delegate.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Firestore/core/src/core/query.h"
+#include "Firestore/core/src/local/leveldb_key.h"
+#include "Firestore/core/src/local/leveldb_persistence.h"
+#include "Firestore/core/src/local/leveldb_target_cache.h"
+#include "Firestore/core/src/local/local_serializer.h"
+#include "Firestore/core/src/local/reference_set.h"
+#include "Firestore/core/src/local/target_data.h"
+#include "Firestore/core/src/model/database_id.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/model/document_key_set.h"
+#include "Firestore/core/src/remote/serializer.h"
+#include "Firestore/core/src/util/filesystem.h"
+#include "Firestore/core/src/util/path.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+namespace {
+
+using core::Query;
+using model::DatabaseId;
+using model::DocumentKey;
+using model::DocumentKeySet;
+using model::ListenSequenceNumber;
+using model::ResourcePath;
+using model::TargetId;
+using util::Filesystem;
+using util::Path;
+
+DocumentKey Key(int index) {
+  return DocumentKey::FromSegments({"docs", absl::StrCat("doc", index)});
+}
+
+DocumentKeySet Keys(int begin, int end) {
+  DocumentKeySet keys;
+  for (int i = begin; i < end; ++i) {
+    keys = keys.insert(Key(i));
+  }
+  return keys;
+}
+
+class LevelDbLruReferenceDelegateTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = Filesystem::Default()->TempDir().AppendUtf8(
+        "leveldb_lru_reference_delegate_test");
+    Filesystem::Default()->RecursivelyRemove(dir_);
+    Open();
+  }
+
+  void TearDown() override {
+    Close();
+    Filesystem::Default()->RecursivelyRemove(dir_);
+  }
+
+  void Open() {
+    LocalSerializer serializer{remote::Serializer{DatabaseId{"p"}}};
+    auto created = LevelDbPersistence::Create(dir_, std::move(serializer),
+                                              LruParams::Default());
+    ASSERT_TRUE(created.ok()) << created.status().ToString();
+    persistence_ = std::move(created).ValueOrDie();
+    delegate()->AddInMemoryPins(&pins_);
+  }
+
+  void Close() {
+    if (persistence_) {
+      persistence_->Shutdown();
+      persistence_.reset();
+    }
+  }
+
+  LevelDbLruReferenceDelegate* delegate() {
+    return persistence_->reference_delegate();
+  }
+
+  LevelDbTargetCache* target_cache() {
+    return persistence_->target_cache();
+  }
+
+  TargetData AddTarget(TargetId target_id, const DocumentKeySet& keys) {
+    TargetData target_data;
+    persistence_->Run("Add target", [&] {
+      target_data = TargetData(
+          Query(ResourcePath{absl::StrCat("coll", target_id)}).ToTarget(),
+          target_id, persistence_->current_sequence_number(),
+          QueryPurpose::Listen);
+      target_cache()->AddTarget(target_data);
+      target_cache()->AddMatchingKeys(keys, target_id);
+    });
+    return target_data;
+  }
+
+  void RemoveMatchingKeys(const DocumentKeySet& keys, TargetId target_id) {
+    persistence_->Run("Remove matching keys", [&] {
+      target_cache()->RemoveMatchingKeys(keys, target_id);
+    });
+  }
+
+  bool BuildHistogramSlice() {
+    return persistence_->Run("Build histogram", [&] {
+      // A deadline in the past builds the histogram one document at a time.
+      return delegate()->BuildOrphanedDocumentHistogramUntil(
+          LruDeadline::min());
+    });
+  }
+
+  /**
+   * Checks that the histogram counts exactly the orphaned documents and their
+   * sequence numbers.
+   */
+  void ExpectHistogramMatchesOrphanedDocuments() {
+    persistence_->Run("Check histogram", [&] {
+      std::vector<ListenSequenceNumber> orphaned;
+      delegate()->EnumerateOrphanedDocuments(
+          [&](const DocumentKey&, ListenSequenceNumber sequence_number) {
+            orphaned.push_back(sequence_number);
+          });
+      std::sort(orphaned.begin(), orphaned.end());
+
+      const SequenceNumberHistogram* histogram =
+          delegate()->GetOrphanedDocumentHistogram();
+      ASSERT_NE(histogram, nullptr);
+      ASSERT_EQ(histogram->total_count(),
+                static_cast<int64_t>(orphaned.size()));
+      // Few distinct sequence numbers fit in buckets of width one, so the
+      // histogram is exact.
+      for (size_t n = 1; n <= orphaned.size(); ++n) {
+        EXPECT_EQ(histogram->NthSequenceNumber(static_cast<int64_t>(n), {}),
+                  orphaned[n - 1])
+            << "n = " << n;
+      }
+    });
+  }
+
+  Path dir_;
+  ReferenceSet pins_;
+  std::unique_ptr<LevelDbPersistence> persistence_;
+};
+
+TEST_F(LevelDbLruReferenceDelegateTest, UpdatesHistogramIncrementally) {
+  while (!BuildHistogramSlice()) {
+  }
+  ExpectHistogramMatchesOrphanedDocuments();
+
+  TargetData first = AddTarget(1, Keys(0, 6));
+  AddTarget(2, Keys(4, 8));
+  ExpectHistogramMatchesOrphanedDocuments();
+
+  // Documents 0 and 1 lose their only target, document 4 still has one.
+  RemoveMatchingKeys(Keys(0, 2), 1);
+  RemoveMatchingKeys(Keys(4, 5), 1);
+  ExpectHistogramMatchesOrphanedDocuments();
+
+  // A new use of an orphaned document moves it to a newer sequence number.
+  persistence_->Run("Update limbo document",
+                    [&] { delegate()->UpdateLimboDocument(Key(0)); });
+  ExpectHistogramMatchesOrphanedDocuments();
+
+  // Removing a target orphans the documents that only it referenced.
+  persistence_->Run("Remove target",
+                    [&] { target_cache()->RemoveTarget(first); });
+  ExpectHistogramMatchesOrphanedDocuments();
+
+  // Documents that join a target again are no longer orphaned.
+  AddTarget(3, Keys(0, 3));
+  ExpectHistogramMatchesOrphanedDocuments();
+
+  persistence_->Run("Remove orphaned documents", [&] {
+    delegate()->RemoveOrphanedDocuments(
+        persistence_->current_sequence_number());
+  });
+  ExpectHistogramMatchesOrphanedDocuments();
+}
+
+TEST_F(LevelDbLruReferenceDelegateTest, PersistsHistogram) {
+  while (!BuildHistogramSlice()) {
+  }
+  AddTarget(1, Keys(0, 10));
+  RemoveMatchingKeys(Keys(0, 4), 1);
+  RemoveMatchingKeys(Keys(6, 7), 1);
+
+  Close();
+  Open();
+  persistence_->Run("Check loaded", [&] {
+    const SequenceNumberHistogram* histogram =
+        delegate()->GetOrphanedDocumentHistogram();
+    ASSERT_NE(histogram, nullptr);
+    EXPECT_EQ(histogram->total_count(), 5);
+  });
+  ExpectHistogramMatchesOrphanedDocuments();
+}
+
+TEST_F(LevelDbLruReferenceDelegateTest, BuildsHistogramInSlices) {
+  AddTarget(1, Keys(0, 10));
+  RemoveMatchingKeys(Keys(0, 10), 1);
+
+  // Forget the histogram, as in caches that predate it.
+  persistence_->Run("Drop histogram", [&] {
+    persistence_->current_transaction()->Delete(
+        LevelDbGlobalKey::Key("sequence_number_histogram"));
+  });
+  Close();
+  Open();
+
+  int slices = 0;
+  while (!BuildHistogramSlice()) {
+    persistence_->Run("Check incomplete", [&] {
+      EXPECT_EQ(delegate()->GetOrphanedDocumentHistogram(), nullptr);
+    });
+
+    // Change documents on both sides of the slice boundary while the
+    // histogram is being built.
+    ++slices;
+    if (slices == 3) {
+      AddTarget(2, Keys(0, 1));
+      AddTarget(3, Keys(9, 10));
+    } else if (slices == 6) {
+      RemoveMatchingKeys(Keys(0, 1), 2);
+      persistence_->Run("Update limbo documents", [&] {
+        delegate()->UpdateLimboDocument(Key(1));
+        delegate()->UpdateLimboDocument(Key(8));
+      });
+    }
+  }
+
+  EXPECT_GE(slices, 9);
+  ExpectHistogramMatchesOrphanedDocuments();
+}
+
+}  // namespace
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
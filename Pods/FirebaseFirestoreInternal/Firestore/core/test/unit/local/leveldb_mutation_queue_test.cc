@@ -0,0 +1,275 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/leveldb_mutation_queue.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Firestore/core/include/firebase/firestore/timestamp.h"
+#include "Firestore/core/src/core/query.h"
+#include "Firestore/core/src/credentials/user.h"
+#include "Firestore/core/src/local/leveldb_key.h"
+#include "Firestore/core/src/local/leveldb_migrations.h"
+#include "Firestore/core/src/local/leveldb_persistence.h"
+#include "Firestore/core/src/local/local_serializer.h"
+#include "Firestore/core/src/model/database_id.h"
+#include "Firestore/core/src/model/delete_mutation.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/model/document_key_set.h"
+#include "Firestore/core/src/model/mutation_batch.h"
+#include "Firestore/core/src/model/precondition.h"
+#include "Firestore/core/src/model/resource_path.h"
+#include "Firestore/core/src/remote/serializer.h"
+#include "Firestore/core/src/util/filesystem.h"
+#include "Firestore/core/src/util/path.h"
+#include "absl/strings/match.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+
+using core::Query;
+using credentials::User;
+using model::BatchId;
+using model::DatabaseId;
+using model::DeleteMutation;
+using model::DocumentKey;
+using model::DocumentKeySet;
+using model::Mutation;
+using model::MutationBatch;
+using model::Precondition;
+using model::ResourcePath;
+using util::Filesystem;
+using util::Path;
+
+namespace {
+
+LocalSerializer MakeSerializer() {
+  return LocalSerializer{remote::Serializer{DatabaseId{"p"}}};
+}
+
+std::vector<BatchId> BatchIds(const std::vector<MutationBatch>& batches) {
+  std::vector<BatchId> result;
+  for (const MutationBatch& batch : batches) {
+    result.push_back(batch.batch_id());
+  }
+  return result;
+}
+
+}  // namespace
+
+class LevelDbMutationQueueTest : public testing::Test {
+ protected:
+  using IndexRow = std::tuple<std::string, std::string, BatchId>;
+
+  void SetUp() override {
+    dir_ = Filesystem::Default()->TempDir().AppendUtf8(
+        "leveldb_mutation_queue_test");
+    Filesystem::Default()->RecursivelyRemove(dir_);
+    auto created =
+        LevelDbPersistence::Create(dir_, MakeSerializer(), LruParams::Default());
+    ASSERT_TRUE(created.ok()) << created.status().ToString();
+    persistence_ = std::move(created).ValueOrDie();
+
+    index_manager_ = persistence_->GetIndexManager(User::Unauthenticated());
+    queue_ = persistence_->GetMutationQueue(User::Unauthenticated(),
+                                            index_manager_);
+    persistence_->Run("Start", [&] {
+      index_manager_->Start();
+      queue_->Start();
+    });
+  }
+
+  void TearDown() override {
+    persistence_->Shutdown();
+    persistence_.reset();
+    Filesystem::Default()->RecursivelyRemove(dir_);
+  }
+
+  /** Adds a batch deleting the documents at the given paths. */
+  MutationBatch AddBatch(const std::vector<std::string>& paths) {
+    std::vector<Mutation> mutations;
+    for (const std::string& path : paths) {
+      mutations.push_back(DeleteMutation(DocumentKey::FromPathString(path),
+                                         Precondition::None()));
+    }
+    absl::optional<MutationBatch> batch;
+    persistence_->Run("Add batch", [&] {
+      batch = queue_->AddMutationBatch(Timestamp::Now(), {},
+                                       std::move(mutations));
+    });
+    return *batch;
+  }
+
+  std::vector<BatchId> BatchesAffectingCollection(const std::string& path) {
+    return persistence_->Run("Query batches", [&] {
+      return BatchIds(queue_->AllMutationBatchesAffectingQuery(
+          Query(ResourcePath::FromString(path))));
+    });
+  }
+
+  std::set<BatchId> CachedBatchIds() const {
+    std::set<BatchId> result;
+    for (const auto& entry : queue_->batches_) {
+      result.insert(entry.first);
+    }
+    return result;
+  }
+
+  /** Returns the rows of the collection_mutation index. */
+  std::set<IndexRow> CollectionMutationRows() {
+    std::set<IndexRow> rows;
+    persistence_->Run("Read index", [&] {
+      std::string prefix = LevelDbCollectionMutationKey::KeyPrefix();
+      auto it = persistence_->current_transaction()->NewIterator();
+      LevelDbCollectionMutationKey row_key;
+      for (it->Seek(prefix); it->Valid() && absl::StartsWith(it->key(), prefix);
+           it->Next()) {
+        EXPECT_TRUE(row_key.Decode(it->key()));
+        rows.emplace(row_key.user_id(),
+                     row_key.collection_path().CanonicalString(),
+                     row_key.batch_id());
+      }
+    });
+    return rows;
+  }
+
+  size_t max_cached_batches() const {
+    return LevelDbMutationQueue::kMaxCachedBatches;
+  }
+
+  Path dir_;
+  std::unique_ptr<LevelDbPersistence> persistence_;
+  IndexManager* index_manager_ = nullptr;
+  LevelDbMutationQueue* queue_ = nullptr;
+};
+
+TEST_F(LevelDbMutationQueueTest, FindsBatchesByCollection) {
+  BatchId direct = AddBatch({"rooms/a", "rooms/b"}).batch_id();
+  BatchId nested = AddBatch({"rooms/a/messages/m"}).batch_id();
+  BatchId sibling = AddBatch({"roomsX/a"}).batch_id();
+  BatchId mixed = AddBatch({"users/u", "rooms/c"}).batch_id();
+
+  // Batches are listed once, in order, and only for documents directly within
+  // the collection.
+  EXPECT_EQ(BatchesAffectingCollection("rooms"),
+            (std::vector<BatchId>{direct, mixed}));
+  EXPECT_EQ(BatchesAffectingCollection("rooms/a/messages"),
+            std::vector<BatchId>{nested});
+  EXPECT_EQ(BatchesAffectingCollection("roomsX"),
+            std::vector<BatchId>{sibling});
+  EXPECT_EQ(BatchesAffectingCollection("users"), std::vector<BatchId>{mixed});
+  EXPECT_TRUE(BatchesAffectingCollection("rooms/b/messages").empty());
+
+  persistence_->Run("Lookup by key", [&] {
+    EXPECT_EQ(BatchIds(queue_->AllMutationBatchesAffectingDocumentKey(
+                  DocumentKey::FromPathString("rooms/a"))),
+              std::vector<BatchId>{direct});
+    DocumentKeySet keys{DocumentKey::FromPathString("rooms/c"),
+                        DocumentKey::FromPathString("rooms/b"),
+                        DocumentKey::FromPathString("rooms/a/messages/m")};
+    EXPECT_EQ(BatchIds(queue_->AllMutationBatchesAffectingDocumentKeys(keys)),
+              (std::vector<BatchId>{direct, nested, mixed}));
+  });
+
+  // Removing a batch removes its rows from the index.
+  persistence_->Run("Remove batch", [&] {
+    queue_->RemoveMutationBatch(*queue_->LookupMutationBatch(direct));
+  });
+  EXPECT_EQ(BatchesAffectingCollection("rooms"), std::vector<BatchId>{mixed});
+}
+
+TEST_F(LevelDbMutationQueueTest, MigrationRebuildsCollectionIndex) {
+  AddBatch({"rooms/a", "rooms/b"});
+  AddBatch({"rooms/a/messages/m", "users/u"});
+  BatchId removed = AddBatch({"rooms/c"}).batch_id();
+  std::set<IndexRow> expected = CollectionMutationRows();
+  ASSERT_EQ(expected.size(), 4u);
+
+  // Simulate a client that predates the index: it leaves a row behind for a
+  // batch it removes and doesn't index the batches it adds.
+  persistence_->Run("Remove batch", [&] {
+    queue_->RemoveMutationBatch(*queue_->LookupMutationBatch(removed));
+  });
+  expected.erase(IndexRow{"", "rooms", removed});
+  BatchId added = AddBatch({"users/v"}).batch_id();
+  persistence_->Run("Corrupt index", [&] {
+    auto* transaction = persistence_->current_transaction();
+    transaction->Put(LevelDbCollectionMutationKey::Key(
+                         "", ResourcePath::FromString("rooms"), removed),
+                     std::string());
+    transaction->Delete(LevelDbCollectionMutationKey::Key(
+        "", ResourcePath::FromString("users"), added));
+  });
+  expected.emplace("", "users", added);
+  ASSERT_NE(CollectionMutationRows(), expected);
+
+  LevelDbMigrations::RunMigrations(persistence_->ptr(), 8, MakeSerializer());
+  LevelDbMigrations::RunMigrations(persistence_->ptr(), MakeSerializer());
+  EXPECT_EQ(CollectionMutationRows(), expected);
+}
+
+TEST_F(LevelDbMutationQueueTest, BoundsParsedBatchCache) {
+  size_t count = max_cached_batches() + 50;
+  std::vector<MutationBatch> batches;
+  for (size_t i = 0; i < count; ++i) {
+    batches.push_back(AddBatch({"coll/doc" + std::to_string(i)}));
+  }
+
+  // The cache holds the oldest batches.
+  std::set<BatchId> cached = CachedBatchIds();
+  ASSERT_EQ(cached.size(), max_cached_batches());
+  EXPECT_EQ(*cached.begin(), batches.front().batch_id());
+  EXPECT_EQ(*cached.rbegin(), batches[max_cached_batches() - 1].batch_id());
+
+  // Batches outside the cache are still read correctly.
+  persistence_->Run("Read batches", [&] {
+    for (const MutationBatch& batch : batches) {
+      auto found = queue_->LookupMutationBatch(batch.batch_id());
+      ASSERT_TRUE(found.has_value());
+      EXPECT_EQ(*found, batch);
+    }
+    EXPECT_EQ(queue_->AllMutationBatches(), batches);
+  });
+  EXPECT_EQ(CachedBatchIds().size(), max_cached_batches());
+
+  // Acknowledging batches from the front makes room for the next ones.
+  persistence_->Run("Remove batches", [&] {
+    for (size_t i = 0; i < 10; ++i) {
+      queue_->RemoveMutationBatch(batches[i]);
+    }
+  });
+  EXPECT_EQ(CachedBatchIds().size(), max_cached_batches() - 10);
+  persistence_->Run("Read batches", [&] {
+    EXPECT_EQ(queue_->AllMutationBatches(),
+              std::vector<MutationBatch>(batches.begin() + 10, batches.end()));
+  });
+  cached = CachedBatchIds();
+  ASSERT_EQ(cached.size(), max_cached_batches());
+  EXPECT_EQ(*cached.begin(), batches[10].batch_id());
+  EXPECT_EQ(*cached.rbegin(), batches[max_cached_batches() + 9].batch_id());
+}
+
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/leveldb_write_buffer.h"
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+namespace {
+
+using Entry = LevelDbWriteBuffer::Entry;
+
+/**
+ * The model the buffer is checked against: each key maps to its value, or to
+ * nullopt if it was deleted.
+ */
+using Model = std::map<std::string, absl::optional<std::string>>;
+
+class LevelDbWriteBufferTest : public testing::Test {
+ protected:
+  void Reset() {
+    buffer_ = absl::make_unique<LevelDbWriteBuffer>();
+    model_.clear();
+  }
+
+  void Put(const std::string& key, const std::string& value) {
+    buffer_->Put(key, value);
+    model_[key] = value;
+  }
+
+  void Delete(const std::string& key) {
+    buffer_->Delete(key);
+    model_[key] = absl::nullopt;
+  }
+
+  void ExpectEntryMatches(const Entry& entry,
+                          const Model::value_type& expected) {
+    EXPECT_EQ(entry.key, expected.first);
+    EXPECT_EQ(entry.deleted, !expected.second.has_value());
+    if (expected.second) {
+      EXPECT_EQ(entry.value, *expected.second);
+    }
+  }
+
+  void ExpectFindMatches(const std::string& key) {
+    const Entry* entry = buffer_->Find(key);
+    auto expected = model_.find(key);
+    if (expected == model_.end()) {
+      EXPECT_EQ(entry, nullptr) << key;
+    } else {
+      ASSERT_NE(entry, nullptr) << key;
+      ExpectEntryMatches(*entry, *expected);
+    }
+  }
+
+  /** Seeks to `key` and compares up to `steps` entries with the model. */
+  void ExpectSeekMatches(const std::string& key, int steps) {
+    LevelDbWriteBuffer::Cursor cursor(buffer_.get());
+    cursor.Seek(key);
+    auto expected = model_.lower_bound(key);
+    for (int i = 0; i < steps && expected != model_.end(); ++i, ++expected) {
+      ASSERT_TRUE(cursor.Valid()) << "seek " << key << ", step " << i;
+      ExpectEntryMatches(cursor.entry(), *expected);
+      cursor.Next();
+    }
+    if (expected == model_.end()) {
+      EXPECT_FALSE(cursor.Valid());
+    }
+  }
+
+  void ExpectScanMatches() {
+    LevelDbWriteBuffer::Cursor cursor(buffer_.get());
+    cursor.SeekToFirst();
+    for (const auto& expected : model_) {
+      ASSERT_TRUE(cursor.Valid()) << expected.first;
+      ExpectEntryMatches(cursor.entry(), expected);
+      cursor.Next();
+    }
+    EXPECT_FALSE(cursor.Valid());
+
+    size_t value_bytes = 0;
+    for (const auto& expected : model_) {
+      if (expected.second) value_bytes += expected.second->size();
+    }
+    EXPECT_EQ(buffer_->size(), model_.size());
+    EXPECT_EQ(buffer_->value_bytes(), value_bytes);
+  }
+
+  std::unique_ptr<LevelDbWriteBuffer> buffer_ =
+      absl::make_unique<LevelDbWriteBuffer>();
+  Model model_;
+};
+
+std::string KeyOf(int index) {
+  // Pad so that numeric and lexicographic order agree.
+  std::string digits = std::to_string(index);
+  return absl::StrCat("key", std::string(6 - digits.size(), '0'), digits);
+}
+
+TEST_F(LevelDbWriteBufferTest, EmptyBuffer) {
+  EXPECT_EQ(buffer_->Find("a"), nullptr);
+  ExpectScanMatches();
+  ExpectSeekMatches("a", 1);
+}
+
+TEST_F(LevelDbWriteBufferTest, OverwritesAndDeletes) {
+  Put("b", "1");
+  Put("a", "22");
+  Put("b", "333");
+  Delete("a");
+  Delete("c");
+  Put("", "empty key");
+  Put("d", "");
+
+  for (const char* key : {"", "a", "b", "c", "d", "e"}) {
+    ExpectFindMatches(key);
+  }
+  ExpectScanMatches();
+}
+
+TEST_F(LevelDbWriteBufferTest, PutUninitializedIsReadBack) {
+  char* data = buffer_->PutUninitialized("key", 5);
+  std::memcpy(data, "value", 5);
+  model_["key"] = std::string("value");
+  ExpectFindMatches("key");
+  ExpectScanMatches();
+}
+
+// Reads after every write, so that each sort only sees a single new entry and
+// the recent run grows one entry at a time: it crosses `kMinRecentRunSize`
+// and, once the main run is large, the square root of the main run, over and
+// over again.
+TEST_F(LevelDbWriteBufferTest, InterleavedWritesAndReadsCrossRunBoundaries) {
+  const int count = 3000;
+  for (int i = 0; i < count; ++i) {
+    // Alternate between keys before and after everything written so far,
+    // and keys in between, so that merges happen at both ends and in the
+    // middle of the runs.
+    int index;
+    switch (i % 3) {
+      case 0:
+        index = 3 * count - i;
+        break;
+      case 1:
+        index = 3 * count + i;
+        break;
+      default:
+        index = 2 * count + (i * 7919) % count;
+        break;
+    }
+    Put(KeyOf(index), std::to_string(i));
+    ExpectSeekMatches(KeyOf(index), 3);
+    if (i % 97 == 0) {
+      ExpectScanMatches();
+    }
+  }
+  ExpectScanMatches();
+}
+
+// Batches of writes of varying size between reads, so that new entries are
+// sorted and merged into the recent run in bulk, and the recent run is
+// sometimes folded into the main run by a single large batch.
+TEST_F(LevelDbWriteBufferTest, BatchedWritesCrossRunBoundaries) {
+  std::mt19937 rng(31);
+  int next = 0;
+  for (int batch : {1, 63, 1, 64, 2, 200, 5, 1000, 3, 40, 40, 40, 500, 1}) {
+    for (int i = 0; i < batch; ++i) {
+      Put(KeyOf(static_cast<int>(rng() % 100000)), std::to_string(next++));
+    }
+    ExpectScanMatches();
+  }
+}
+
+TEST_F(LevelDbWriteBufferTest, RandomOperationsMatchModel) {
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    SCOPED_TRACE(absl::StrCat("seed ", seed));
+    Reset();
+
+    std::mt19937 rng(seed);
+    // Few enough keys that overwrites and deletes of existing keys are
+    // common, enough that the runs grow past their size thresholds.
+    const int key_space = 2000;
+    auto random_key = [&] {
+      return KeyOf(static_cast<int>(rng() % key_space));
+    };
+    auto random_value = [&] {
+      // Mostly small values, some empty and some larger than an arena block
+      // can share.
+      size_t size;
+      switch (rng() % 10) {
+        case 0:
+          size = 0;
+          break;
+        case 1:
+          size = 2048 + rng() % 8192;
+          break;
+        default:
+          size = rng() % 64;
+          break;
+      }
+      return std::string(size, static_cast<char>('a' + rng() % 26));
+    };
+
+    for (int op = 0; op < 20000; ++op) {
+      uint32_t choice = rng() % 100;
+      if (choice < 50) {
+        Put(random_key(), random_value());
+      } else if (choice < 65) {
+        Delete(random_key());
+      } else if (choice < 85) {
+        ExpectFindMatches(random_key());
+      } else if (choice < 99) {
+        ExpectSeekMatches(random_key(), static_cast<int>(rng() % 8));
+      } else {
+        ExpectScanMatches();
+      }
+      if (HasFatalFailure()) return;
+    }
+    ExpectScanMatches();
+  }
+}
+
+}  // namespace
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,526 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks for the hot paths of LocalStore, driven against both the memory
+// and the LevelDB persistence with synthetic collections.
+//
+// Every benchmark takes the persistence kind as its first argument (0 for
+// memory, 1 for LevelDB), followed by the collection size and the number of
+// fields per document. Besides the time per iteration, each benchmark reports
+// throughput (`items_per_second`) and the p50/p99 latency of a single
+// iteration in microseconds. On glibc, the heap growth of each benchmark is
+// measured in a separate run and reported as `net_heap_growth` in the JSON
+// output (`--benchmark_format=json`).
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Firestore/core/include/firebase/firestore/timestamp.h"
+#include "Firestore/core/src/core/field_filter.h"
+#include "Firestore/core/src/core/order_by.h"
+#include "Firestore/core/src/core/query.h"
+#include "Firestore/core/src/credentials/user.h"
+#include "Firestore/core/src/local/leveldb_persistence.h"
+#include "Firestore/core/src/local/local_serializer.h"
+#include "Firestore/core/src/local/local_store.h"
+#include "Firestore/core/src/local/local_write_result.h"
+#include "Firestore/core/src/local/lru_garbage_collector.h"
+#include "Firestore/core/src/local/memory_persistence.h"
+#include "Firestore/core/src/local/query_engine.h"
+#include "Firestore/core/src/local/query_result.h"
+#include "Firestore/core/src/local/target_data.h"
+#include "Firestore/core/src/model/database_id.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/model/field_path.h"
+#include "Firestore/core/src/model/mutable_document.h"
+#include "Firestore/core/src/model/mutation.h"
+#include "Firestore/core/src/model/object_value.h"
+#include "Firestore/core/src/model/precondition.h"
+#include "Firestore/core/src/model/set_mutation.h"
+#include "Firestore/core/src/model/snapshot_version.h"
+#include "Firestore/core/src/nanopb/message.h"
+#include "Firestore/core/src/nanopb/nanopb_util.h"
+#include "Firestore/core/src/remote/remote_event.h"
+#include "Firestore/core/src/remote/serializer.h"
+#include "Firestore/core/src/util/filesystem.h"
+#include "Firestore/core/src/util/hard_assert.h"
+#include "Firestore/core/src/util/path.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace firebase {
+namespace firestore {
+namespace local {
+namespace {
+
+using core::FieldFilter;
+using core::Query;
+using credentials::User;
+using model::DatabaseId;
+using model::DocumentKey;
+using model::DocumentKeySet;
+using model::DocumentUpdateMap;
+using model::FieldPath;
+using model::MutableDocument;
+using model::Mutation;
+using model::ObjectValue;
+using model::Precondition;
+using model::ResourcePath;
+using model::SetMutation;
+using model::SnapshotVersion;
+using model::TargetId;
+using nanopb::ByteString;
+using nanopb::Message;
+using remote::RemoteEvent;
+using remote::TargetChange;
+using util::Filesystem;
+using util::Path;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* kCollection = "items";
+
+enum class PersistenceKind { kMemory = 0, kLevelDb = 1 };
+
+/** The shapes of the queries run by `BM_ExecuteQuery`. */
+enum class QueryShape {
+  /** All documents of the collection. */
+  kCollection = 0,
+  /** An equality filter that matches a tenth of the collection. */
+  kEquality = 1,
+  /**
+   * A range filter over the second half of the collection, with an order by
+   * and a limit of 10.
+   */
+  kRangeWithLimit = 2,
+};
+
+Message<google_firestore_v1_Value> IntegerValue(int64_t value) {
+  Message<google_firestore_v1_Value> result;
+  result->which_value_type = google_firestore_v1_Value_integer_value_tag;
+  result->integer_value = value;
+  return result;
+}
+
+Message<google_firestore_v1_Value> StringValue(const std::string& value) {
+  Message<google_firestore_v1_Value> result;
+  result->which_value_type = google_firestore_v1_Value_string_value_tag;
+  result->string_value = nanopb::MakeBytesArray(value);
+  return result;
+}
+
+/**
+ * Returns a document with `field_count` string fields, plus a `score` field
+ * that's unique within the collection and a `bucket` field that splits the
+ * collection into ten equal parts.
+ */
+ObjectValue DocumentData(int index, int field_count) {
+  ObjectValue data;
+  data.Set(FieldPath::FromDotSeparatedString("score"), IntegerValue(index));
+  data.Set(FieldPath::FromDotSeparatedString("bucket"),
+           IntegerValue(index % 10));
+  for (int i = 0; i < field_count; ++i) {
+    data.Set(FieldPath::FromDotSeparatedString(absl::StrCat("field", i)),
+             StringValue(absl::StrCat("value-", index, "-", i)));
+  }
+  return data;
+}
+
+DocumentKey KeyForIndex(int index) {
+  return DocumentKey::FromSegments({kCollection, absl::StrCat("doc", index)});
+}
+
+Query CollectionQuery() {
+  return Query(ResourcePath{kCollection});
+}
+
+Query QueryWithShape(QueryShape shape, int document_count) {
+  switch (shape) {
+    case QueryShape::kCollection:
+      return CollectionQuery();
+    case QueryShape::kEquality:
+      return CollectionQuery().AddingFilter(
+          FieldFilter::Create(FieldPath::FromDotSeparatedString("bucket"),
+                              FieldFilter::Operator::Equal, IntegerValue(3)));
+    case QueryShape::kRangeWithLimit:
+      return CollectionQuery()
+          .AddingFilter(FieldFilter::Create(
+              FieldPath::FromDotSeparatedString("score"),
+              FieldFilter::Operator::GreaterThanOrEqual,
+              IntegerValue(document_count / 2)))
+          .AddingOrderBy(core::OrderBy(
+              FieldPath::FromDotSeparatedString("score"),
+              core::Direction::Ascending))
+          .WithLimitToFirst(10);
+  }
+  UNREACHABLE();
+}
+
+/**
+ * Owns a persistence of the requested kind and a started LocalStore on top of
+ * it. LevelDB data lives in a fresh temporary directory that is removed
+ * afterwards.
+ */
+class BenchmarkStore {
+ public:
+  explicit BenchmarkStore(PersistenceKind kind) {
+    if (kind == PersistenceKind::kMemory) {
+      persistence_ = MemoryPersistence::WithEagerGarbageCollector();
+    } else {
+      static int instance_count = 0;
+      dir_ = Filesystem::Default()->TempDir().AppendUtf8(
+          absl::StrCat("local_store_benchmark_", ++instance_count));
+      Filesystem::Default()->RecursivelyRemove(dir_);
+      LocalSerializer serializer{
+          remote::Serializer{DatabaseId{"benchmark-project"}}};
+      auto created = LevelDbPersistence::Create(
+          dir_, std::move(serializer), LruParams::Disabled());
+      HARD_ASSERT(created.ok(), "Failed to create LevelDB: %s",
+                  created.status().ToString());
+      persistence_ = std::move(created).ValueOrDie();
+    }
+
+    local_store_ = absl::make_unique<LocalStore>(
+        persistence_.get(), &query_engine_, User::Unauthenticated());
+    local_store_->Start();
+  }
+
+  ~BenchmarkStore() {
+    local_store_.reset();
+    persistence_->Shutdown();
+    if (!dir_.empty()) {
+      Filesystem::Default()->RecursivelyRemove(dir_);
+    }
+  }
+
+  LocalStore* local_store() {
+    return local_store_.get();
+  }
+
+  /** Listens to the whole collection and returns the target ID. */
+  TargetId ListenToCollection() {
+    if (!collection_target_id_) {
+      collection_target_id_ =
+          local_store_->AllocateTarget(CollectionQuery().ToTarget())
+              .target_id();
+    }
+    return collection_target_id_;
+  }
+
+  /**
+   * Applies a remote event that adds or updates the documents with indexes in
+   * [begin, end) to the collection target.
+   */
+  void ApplyDocuments(int begin, int end, int field_count) {
+    TargetId target_id = ListenToCollection();
+    SnapshotVersion version{Timestamp(++snapshot_seconds_, 0)};
+
+    DocumentUpdateMap updates;
+    DocumentKeySet keys;
+    for (int i = begin; i < end; ++i) {
+      DocumentKey key = KeyForIndex(i);
+      updates.emplace(key, MutableDocument::FoundDocument(
+                               key, version, DocumentData(i, field_count)));
+      keys = keys.insert(key);
+    }
+
+    RemoteEvent::TargetChangeMap target_changes;
+    target_changes[target_id] =
+        TargetChange{ByteString{"resume-token"}, /* current= */ true,
+                     std::move(keys), DocumentKeySet{}, DocumentKeySet{}};
+    local_store_->ApplyRemoteEvent(RemoteEvent{
+        version, std::move(target_changes), RemoteEvent::TargetMismatchMap{},
+        std::move(updates), DocumentKeySet{}});
+  }
+
+ private:
+  std::unique_ptr<Persistence> persistence_;
+  QueryEngine query_engine_;
+  std::unique_ptr<LocalStore> local_store_;
+  Path dir_;
+  TargetId collection_target_id_ = 0;
+  int64_t snapshot_seconds_ = 0;
+};
+
+/**
+ * Times single iterations of a benchmark, and reports the latency percentiles
+ * once the benchmark finishes.
+ */
+class IterationRecorder {
+ public:
+  explicit IterationRecorder(benchmark::State& state) : state_(state) {
+  }
+
+  void Start() {
+    start_ = Clock::now();
+  }
+
+  void Stop() {
+    Clock::time_point end = Clock::now();
+    latencies_.push_back(
+        std::chrono::duration<double, std::micro>(end - start_).count());
+  }
+
+  void Report(int64_t items_per_iteration) {
+    state_.SetItemsProcessed(state_.iterations() * items_per_iteration);
+    if (latencies_.empty()) {
+      return;
+    }
+
+    std::sort(latencies_.begin(), latencies_.end());
+    state_.counters["p50_us"] = Percentile(0.50);
+    state_.counters["p99_us"] = Percentile(0.99);
+  }
+
+ private:
+  double Percentile(double percentile) const {
+    size_t index = static_cast<size_t>(percentile * (latencies_.size() - 1));
+    return latencies_[index];
+  }
+
+  benchmark::State& state_;
+  Clock::time_point start_;
+  std::vector<double> latencies_;
+};
+
+#if defined(__GLIBC__)
+
+/**
+ * Measures how much the heap grows while a benchmark runs, from the allocator's
+ * own statistics. The benchmark library only calls it for an extra run after
+ * the timed ones, so it costs the timed runs nothing and leaves the global
+ * allocator alone.
+ */
+class HeapUsageManager : public benchmark::MemoryManager {
+ public:
+  void Start() override {
+    in_use_at_start_ = InUse();
+  }
+
+  void Stop(Result& result) override {
+    result.net_heap_growth = InUse() - in_use_at_start_;
+    result.max_bytes_used = std::max<int64_t>(result.net_heap_growth, 0);
+  }
+
+  void Stop(Result* result) override {
+    Stop(*result);
+  }
+
+ private:
+  static int64_t InUse() {
+    return static_cast<int64_t>(mallinfo2().uordblks);
+  }
+
+  int64_t in_use_at_start_ = 0;
+};
+
+#endif  // defined(__GLIBC__)
+
+PersistenceKind KindArg(const benchmark::State& state) {
+  return static_cast<PersistenceKind>(state.range(0));
+}
+
+/**
+ * Args: persistence kind, collection size, fields per document, query shape.
+ */
+void BM_ExecuteQuery(benchmark::State& state) {
+  int document_count = static_cast<int>(state.range(1));
+  int field_count = static_cast<int>(state.range(2));
+  Query query =
+      QueryWithShape(static_cast<QueryShape>(state.range(3)), document_count);
+
+  BenchmarkStore store(KindArg(state));
+  store.ApplyDocuments(0, document_count, field_count);
+
+  IterationRecorder recorder(state);
+  size_t result_size = 0;
+  for (auto _ : state) {
+    recorder.Start();
+    QueryResult result = store.local_store()->ExecuteQuery(
+        query, /* use_previous_results= */ false);
+    recorder.Stop();
+    result_size = result.documents().size();
+    benchmark::DoNotOptimize(result);
+  }
+  recorder.Report(static_cast<int64_t>(result_size));
+}
+
+/**
+ * Args: persistence kind, collection size, fields per document, documents per
+ * remote event. Each iteration updates the next slice of the collection.
+ */
+void BM_ApplyRemoteEvent(benchmark::State& state) {
+  int document_count = static_cast<int>(state.range(1));
+  int field_count = static_cast<int>(state.range(2));
+  int event_size = static_cast<int>(state.range(3));
+
+  BenchmarkStore store(KindArg(state));
+  store.ApplyDocuments(0, document_count, field_count);
+
+  IterationRecorder recorder(state);
+  int begin = 0;
+  for (auto _ : state) {
+    int end = std::min(begin + event_size, document_count);
+    recorder.Start();
+    store.ApplyDocuments(begin, end, field_count);
+    recorder.Stop();
+    begin = end == document_count ? 0 : end;
+  }
+  recorder.Report(event_size);
+}
+
+std::vector<Mutation> SetMutations(int begin, int end, int field_count) {
+  std::vector<Mutation> mutations;
+  for (int i = begin; i < end; ++i) {
+    mutations.push_back(SetMutation(
+        KeyForIndex(i), DocumentData(i, field_count), Precondition::None()));
+  }
+  return mutations;
+}
+
+/**
+ * Args: persistence kind, collection size, fields per document, mutations per
+ * batch. Each iteration writes a batch to the next slice of the collection.
+ */
+void BM_WriteLocally(benchmark::State& state) {
+  int document_count = static_cast<int>(state.range(1));
+  int field_count = static_cast<int>(state.range(2));
+  int batch_size = static_cast<int>(state.range(3));
+
+  BenchmarkStore store(KindArg(state));
+  store.ApplyDocuments(0, document_count, field_count);
+
+  IterationRecorder recorder(state);
+  int begin = 0;
+  for (auto _ : state) {
+    int end = std::min(begin + batch_size, document_count);
+    state.PauseTiming();
+    std::vector<Mutation> mutations = SetMutations(begin, end, field_count);
+    state.ResumeTiming();
+
+    recorder.Start();
+    LocalWriteResult result =
+        store.local_store()->WriteLocally(std::move(mutations));
+    recorder.Stop();
+    benchmark::DoNotOptimize(result);
+    begin = end == document_count ? 0 : end;
+  }
+  recorder.Report(batch_size);
+}
+
+/**
+ * Args: persistence kind, collection size, fields per document, mutations per
+ * batch. Each iteration rejects the oldest of three pending batches that write
+ * the same documents, which recalculates their overlays in
+ * `LocalDocumentsView` from the two that remain.
+ */
+void BM_OverlayRecalculation(benchmark::State& state) {
+  int document_count = static_cast<int>(state.range(1));
+  int field_count = static_cast<int>(state.range(2));
+  int batch_size = std::min(static_cast<int>(state.range(3)), document_count);
+
+  BenchmarkStore store(KindArg(state));
+  store.ApplyDocuments(0, document_count, field_count);
+  LocalStore* local_store = store.local_store();
+
+  // Batches can only be rejected in the order they were written.
+  std::deque<model::BatchId> pending_batches;
+  auto write_batch = [&] {
+    pending_batches.push_back(
+        local_store->WriteLocally(SetMutations(0, batch_size, field_count))
+            .batch_id());
+  };
+  write_batch();
+  write_batch();
+
+  IterationRecorder recorder(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    write_batch();
+    state.ResumeTiming();
+
+    recorder.Start();
+    model::DocumentMap changes =
+        local_store->RejectBatch(pending_batches.front());
+    recorder.Stop();
+    pending_batches.pop_front();
+    benchmark::DoNotOptimize(changes);
+  }
+  recorder.Report(batch_size);
+}
+
+void QueryArgs(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"leveldb", "docs", "fields", "shape"});
+  for (int kind : {0, 1}) {
+    for (int documents : {100, 1000, 10000}) {
+      for (int shape : {0, 1, 2}) {
+        benchmark->Args({kind, documents, 10, shape});
+      }
+    }
+    benchmark->Args({kind, 1000, 100, 0});
+  }
+}
+
+void WriteArgs(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"leveldb", "docs", "fields", "batch"});
+  for (int kind : {0, 1}) {
+    for (int batch : {1, 10, 100}) {
+      benchmark->Args({kind, 1000, 10, batch});
+    }
+    benchmark->Args({kind, 1000, 100, 10});
+  }
+}
+
+BENCHMARK(BM_ExecuteQuery)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ApplyRemoteEvent)
+    ->Apply(WriteArgs)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_WriteLocally)->Apply(WriteArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_OverlayRecalculation)
+    ->Apply(WriteArgs)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
+
+int main(int argc, char** argv) {
+#if defined(__GLIBC__)
+  firebase::firestore::local::HeapUsageManager heap_usage;
+  benchmark::RegisterMemoryManager(&heap_usage);
+#endif
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+#if defined(__GLIBC__)
+  benchmark::RegisterMemoryManager(nullptr);
+#endif
+  return 0;
+}
@@ -0,0 +1,295 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Firestore/core/src/local/lru_garbage_collector.h"
+#include "Firestore/core/src/local/sequence_number_histogram.h"
+#include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/util/statusor.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+namespace {
+
+using model::DocumentKey;
+using model::ListenSequenceNumber;
+using util::StatusOr;
+
+/**
+ * An LruDelegate over in-memory orphaned documents and targets whose sliced
+ * enumerations stop after `slice_size` documents.
+ */
+class FakeLruDelegate : public LruDelegate {
+ public:
+  explicit FakeLruDelegate(LruParams params) : gc_(this, params) {
+  }
+
+  void AddOrphanedDocument(const std::string& path,
+                           ListenSequenceNumber sequence_number) {
+    documents_[DocumentKey::FromPathString(path)] = sequence_number;
+  }
+
+  void AddTarget(ListenSequenceNumber sequence_number) {
+    targets_.push_back(sequence_number);
+  }
+
+  size_t document_count() const {
+    return documents_.size();
+  }
+
+  size_t slice_size = 3;
+
+  // MARK: ReferenceDelegate methods
+
+  ListenSequenceNumber current_sequence_number() const override {
+    return 0;
+  }
+  void AddInMemoryPins(ReferenceSet*) override {
+  }
+  void AddReference(const DocumentKey&) override {
+  }
+  void RemoveReference(const DocumentKey&) override {
+  }
+  void RemoveMutationReference(const DocumentKey&) override {
+  }
+  void RemoveTarget(const TargetData&) override {
+  }
+  void UpdateLimboDocument(const DocumentKey&) override {
+  }
+  void OnTransactionStarted(absl::string_view) override {
+  }
+  void OnTransactionCommitted() override {
+  }
+
+  // MARK: LruDelegate methods
+
+  LruGarbageCollector* garbage_collector() override {
+    return &gc_;
+  }
+
+  StatusOr<int64_t> CalculateByteSize() override {
+    return static_cast<int64_t>(documents_.size());
+  }
+
+  size_t GetSequenceNumberCount() override {
+    return targets_.size() + documents_.size();
+  }
+
+  void EnumerateTargetSequenceNumbers(
+      const SequenceNumberCallback& callback) override {
+    for (ListenSequenceNumber sequence_number : targets_) {
+      callback(sequence_number);
+    }
+  }
+
+  void EnumerateOrphanedDocuments(
+      const OrphanedDocumentCallback& callback) override {
+    for (const auto& document : documents_) {
+      callback(document.first, document.second);
+    }
+  }
+
+  void EnumerateOrphanedDocumentsUntil(absl::optional<DocumentKey>* resume_key,
+                                       const OrphanedDocumentCallback& callback,
+                                       LruDeadline) override {
+    auto it = Resume(*resume_key);
+    for (size_t i = 0; i < slice_size && it != documents_.end(); ++i, ++it) {
+      callback(it->first, it->second);
+    }
+    SetResumeKey(it, resume_key);
+  }
+
+  int RemoveOrphanedDocuments(ListenSequenceNumber upper_bound) override {
+    absl::optional<DocumentKey> resume_key;
+    int removed = 0;
+    do {
+      removed += RemoveOrphanedDocumentsUntil(upper_bound, &resume_key,
+                                              LruDeadline::max());
+    } while (resume_key);
+    return removed;
+  }
+
+  int RemoveOrphanedDocumentsUntil(ListenSequenceNumber upper_bound,
+                                   absl::optional<DocumentKey>* resume_key,
+                                   LruDeadline) override {
+    int removed = 0;
+    auto it = Resume(*resume_key);
+    for (size_t i = 0; i < slice_size && it != documents_.end(); ++i) {
+      if (it->second <= upper_bound) {
+        it = documents_.erase(it);
+        ++removed;
+      } else {
+        ++it;
+      }
+    }
+    SetResumeKey(it, resume_key);
+    return removed;
+  }
+
+  int RemoveTargets(ListenSequenceNumber upper_bound,
+                    const LiveQueryMap&) override {
+    auto removed = std::remove_if(
+        targets_.begin(), targets_.end(),
+        [&](ListenSequenceNumber target) { return target <= upper_bound; });
+    int count = static_cast<int>(targets_.end() - removed);
+    targets_.erase(removed, targets_.end());
+    return count;
+  }
+
+ private:
+  using DocumentMap = std::map<DocumentKey, ListenSequenceNumber>;
+
+  DocumentMap::iterator Resume(const absl::optional<DocumentKey>& key) {
+    return key ? documents_.lower_bound(*key) : documents_.begin();
+  }
+
+  void SetResumeKey(DocumentMap::iterator it,
+                    absl::optional<DocumentKey>* resume_key) {
+    if (it == documents_.end()) {
+      resume_key->reset();
+    } else {
+      *resume_key = it->first;
+    }
+  }
+
+  LruGarbageCollector gc_;
+  DocumentMap documents_;
+  std::vector<ListenSequenceNumber> targets_;
+};
+
+LruParams TestParams() {
+  LruParams params = LruParams::Default();
+  params.min_bytes_threshold = 0;
+  params.percentile_to_collect = 50;
+  return params;
+}
+
+void Populate(FakeLruDelegate* delegate) {
+  for (int i = 0; i < 20; ++i) {
+    delegate->AddOrphanedDocument("docs/" + std::to_string(100 + i),
+                                  (i * 7) % 20 + 10);
+  }
+  delegate->AddTarget(5);
+  delegate->AddTarget(18);
+  delegate->AddTarget(40);
+}
+
+TEST(LruGarbageCollectorSliceTest, CollectsLikeEnumeration) {
+  FakeLruDelegate enumerated(TestParams());
+  Populate(&enumerated);
+  LruResults expected = enumerated.garbage_collector()->Collect({});
+
+  FakeLruDelegate sliced(TestParams());
+  Populate(&sliced);
+  LruGarbageCollector* gc = sliced.garbage_collector();
+  LruResults results = gc->CollectSlice({}, std::chrono::milliseconds(0));
+  int slices = 1;
+  while (gc->collection_in_progress()) {
+    EXPECT_FALSE(results.did_run);
+    results = gc->CollectSlice({}, std::chrono::milliseconds(0));
+    ++slices;
+  }
+
+  // 20 documents counted and then examined 3 per slice.
+  EXPECT_EQ(slices, 14);
+  EXPECT_TRUE(results.did_run);
+  EXPECT_EQ(results.sequence_numbers_collected,
+            expected.sequence_numbers_collected);
+  EXPECT_EQ(results.targets_removed, expected.targets_removed);
+  EXPECT_EQ(results.documents_removed, expected.documents_removed);
+  EXPECT_EQ(sliced.document_count(), enumerated.document_count());
+}
+
+/** A FakeLruDelegate that keeps a histogram of its orphaned documents. */
+class FakeLruDelegateWithHistogram : public FakeLruDelegate {
+ public:
+  using FakeLruDelegate::FakeLruDelegate;
+
+  void BuildHistogram() {
+    histogram_ = SequenceNumberHistogram();
+    EnumerateOrphanedDocuments(
+        [this](const DocumentKey&, ListenSequenceNumber sequence_number) {
+          histogram_.Add(sequence_number);
+        });
+  }
+
+  const SequenceNumberHistogram* GetOrphanedDocumentHistogram() override {
+    return &histogram_;
+  }
+
+ private:
+  SequenceNumberHistogram histogram_;
+};
+
+TEST(LruGarbageCollectorSliceTest, SkipsCountingWithDelegateHistogram) {
+  FakeLruDelegate enumerated(TestParams());
+  Populate(&enumerated);
+  LruResults expected = enumerated.garbage_collector()->Collect({});
+
+  FakeLruDelegateWithHistogram delegate(TestParams());
+  Populate(&delegate);
+  delegate.BuildHistogram();
+  LruGarbageCollector* gc = delegate.garbage_collector();
+  LruResults results = gc->CollectSlice({}, std::chrono::milliseconds(0));
+  int slices = 1;
+  while (gc->collection_in_progress()) {
+    results = gc->CollectSlice({}, std::chrono::milliseconds(0));
+    ++slices;
+  }
+
+  // The first slice only removes the targets. Then the 20 documents are
+  // examined 3 per slice, without being counted first.
+  EXPECT_EQ(slices, 8);
+  EXPECT_TRUE(results.did_run);
+  EXPECT_EQ(results.sequence_numbers_collected,
+            expected.sequence_numbers_collected);
+  EXPECT_EQ(results.targets_removed, expected.targets_removed);
+  EXPECT_EQ(results.documents_removed, expected.documents_removed);
+}
+
+TEST(LruGarbageCollectorSliceTest, CutoffMatchesEnumeration) {
+  FakeLruDelegate delegate(TestParams());
+  Populate(&delegate);
+  LruGarbageCollector* gc = delegate.garbage_collector();
+
+  int query_count = gc->QueryCountForPercentile(50);
+  ListenSequenceNumber cutoff = gc->SequenceNumberForQueryCount(query_count);
+
+  delegate.slice_size = 100;
+  LruResults results = gc->CollectSlice({}, std::chrono::milliseconds(1000));
+  ASSERT_TRUE(results.did_run);
+  EXPECT_EQ(results.sequence_numbers_collected, query_count);
+
+  // Everything up to the cutoff is gone, everything after it is left.
+  FakeLruDelegate remaining(TestParams());
+  Populate(&remaining);
+  int expected_removed = remaining.RemoveOrphanedDocuments(cutoff) +
+                         remaining.RemoveTargets(cutoff, {});
+  EXPECT_EQ(results.documents_removed + results.targets_removed,
+            expected_removed);
+}
+
+}  // namespace
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/local/sequence_number_histogram.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace local {
+namespace {
+
+using model::ListenSequenceNumber;
+
+/**
+ * The cutoff the garbage collector computes by enumerating every sequence
+ * number: the `n`th smallest one.
+ */
+ListenSequenceNumber ExactNthSequenceNumber(
+    int64_t n,
+    std::vector<ListenSequenceNumber> documents,
+    const std::vector<ListenSequenceNumber>& targets) {
+  documents.insert(documents.end(), targets.begin(), targets.end());
+  std::sort(documents.begin(), documents.end());
+  return documents[n - 1];
+}
+
+SequenceNumberHistogram HistogramOf(
+    const std::vector<ListenSequenceNumber>& sequence_numbers) {
+  SequenceNumberHistogram histogram;
+  for (ListenSequenceNumber sequence_number : sequence_numbers) {
+    histogram.Add(sequence_number);
+  }
+  return histogram;
+}
+
+TEST(SequenceNumberHistogramTest, CountsSequenceNumbers) {
+  SequenceNumberHistogram histogram = HistogramOf({5, 1, 5, 9});
+  EXPECT_EQ(histogram.total_count(), 4);
+}
+
+TEST(SequenceNumberHistogramTest, RemovesSequenceNumbers) {
+  SequenceNumberHistogram histogram = HistogramOf({5, 1, 5, 9});
+  histogram.Remove(5);
+  histogram.Remove(9);
+  EXPECT_EQ(histogram.total_count(), 2);
+  EXPECT_EQ(histogram.NthSequenceNumber(1, {}), 1);
+  EXPECT_EQ(histogram.NthSequenceNumber(2, {}), 5);
+
+  // Sequence numbers that aren't counted are ignored.
+  histogram.Remove(100);
+  EXPECT_EQ(histogram.total_count(), 2);
+}
+
+TEST(SequenceNumberHistogramTest, RemovesSequenceNumbersAfterCoarsening) {
+  std::vector<ListenSequenceNumber> documents;
+  for (ListenSequenceNumber i = 0; i < 1000; ++i) {
+    documents.push_back(i * 3);
+  }
+  SequenceNumberHistogram histogram = HistogramOf(documents);
+
+  // Remove every other sequence number, including ones that were added before
+  // the buckets were merged.
+  std::vector<ListenSequenceNumber> remaining;
+  for (size_t i = 0; i < documents.size(); ++i) {
+    if (i % 2 == 0) {
+      histogram.Remove(documents[i]);
+    } else {
+      remaining.push_back(documents[i]);
+    }
+  }
+
+  EXPECT_EQ(histogram.total_count(), static_cast<int64_t>(remaining.size()));
+  for (int64_t n = 1; n <= static_cast<int64_t>(remaining.size()); n += 37) {
+    EXPECT_LE(histogram.NthSequenceNumber(n, {}),
+              ExactNthSequenceNumber(n, remaining, {}))
+        << "n = " << n;
+  }
+}
+
+TEST(SequenceNumberHistogramTest, RoundTripsThroughEncoding) {
+  std::mt19937_64 random(7);
+  std::uniform_int_distribution<ListenSequenceNumber> sequence_number(1,
+                                                                      100000);
+  std::vector<ListenSequenceNumber> documents;
+  for (int i = 0; i < 1000; ++i) {
+    documents.push_back(sequence_number(random));
+  }
+  SequenceNumberHistogram histogram = HistogramOf(documents);
+
+  absl::optional<SequenceNumberHistogram> decoded =
+      SequenceNumberHistogram::Decode(histogram.Encode());
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->total_count(), histogram.total_count());
+  EXPECT_EQ(decoded->Encode(), histogram.Encode());
+  for (int64_t n : {1, 10, 500, 1000, 2000}) {
+    EXPECT_EQ(decoded->NthSequenceNumber(n, {}),
+              histogram.NthSequenceNumber(n, {}))
+        << "n = " << n;
+  }
+}
+
+TEST(SequenceNumberHistogramTest, RejectsMalformedEncoding) {
+  EXPECT_FALSE(SequenceNumberHistogram::Decode("").has_value());
+
+  std::string encoded = HistogramOf({1, 2, 3}).Encode();
+  EXPECT_FALSE(SequenceNumberHistogram::Decode(
+                   absl::string_view(encoded).substr(0, encoded.size() - 1))
+                   .has_value());
+}
+
+TEST(SequenceNumberHistogramTest, IsExactWithFewDistinctSequenceNumbers) {
+  std::vector<ListenSequenceNumber> documents = {7, 3, 3, 12, 40, 8, 3};
+  std::vector<ListenSequenceNumber> targets = {2, 9, 41};
+  SequenceNumberHistogram histogram = HistogramOf(documents);
+
+  for (int64_t n = 1; n <= 10; ++n) {
+    EXPECT_EQ(histogram.NthSequenceNumber(n, targets),
+              ExactNthSequenceNumber(n, documents, targets))
+        << "n = " << n;
+  }
+}
+
+TEST(SequenceNumberHistogramTest, ReturnsLargestWhenThereAreFewerThanN) {
+  SequenceNumberHistogram histogram = HistogramOf({1, 2});
+  EXPECT_EQ(histogram.NthSequenceNumber(10, {3}), 3);
+}
+
+TEST(SequenceNumberHistogramTest, NeverExceedsExactCutoff) {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<ListenSequenceNumber> sequence_number(1,
+                                                                      100000);
+
+  for (int round = 0; round < 20; ++round) {
+    std::vector<ListenSequenceNumber> documents;
+    for (int i = 0; i < 5000; ++i) {
+      documents.push_back(sequence_number(random));
+    }
+    std::vector<ListenSequenceNumber> targets;
+    for (int i = 0; i < 50; ++i) {
+      targets.push_back(sequence_number(random));
+    }
+    std::sort(targets.begin(), targets.end());
+
+    SequenceNumberHistogram histogram = HistogramOf(documents);
+    int64_t total = static_cast<int64_t>(documents.size() + targets.size());
+    for (int64_t n : {int64_t{1}, total / 100, total / 10, total / 2, total}) {
+      if (n == 0) {
+        continue;
+      }
+      ListenSequenceNumber exact =
+          ExactNthSequenceNumber(n, documents, targets);
+      ListenSequenceNumber approximate =
+          histogram.NthSequenceNumber(n, targets);
+      EXPECT_LE(approximate, exact) << "n = " << n;
+      // The cutoff is at most one bucket below the exact one. With 128
+      // buckets spanning 100000 sequence numbers, a bucket is 1024 wide.
+      EXPECT_GE(approximate, exact - 1024) << "n = " << n;
+    }
+  }
+}
+
+TEST(SequenceNumberHistogramTest, NeverExceedsExactCutoffWithSkew) {
+  // Most documents were last used recently, a few long ago.
+  std::vector<ListenSequenceNumber> documents;
+  for (ListenSequenceNumber i = 0; i < 100; ++i) {
+    documents.push_back(i);
+  }
+  for (ListenSequenceNumber i = 0; i < 10000; ++i) {
+    documents.push_back(1000000 + i);
+  }
+  SequenceNumberHistogram histogram = HistogramOf(documents);
+
+  for (int64_t n = 1; n <= static_cast<int64_t>(documents.size()); n += 97) {
+    EXPECT_LE(histogram.NthSequenceNumber(n, {}),
+              ExactNthSequenceNumber(n, documents, {}))
+        << "n = " << n;
+  }
+}
+
+}  // namespace
+}  // namespace local
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/model/path_segment.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "Firestore/core/src/model/resource_path.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace model {
+namespace impl {
+namespace {
+
+const char* kAutoId = "AbCdEfGhIjKlMnOpQrSt";
+const char* kUserId = "user_0123456789abcdefghijklm";
+
+TEST(PathSegmentTest, InternsSegments) {
+  size_t pool_size = PathSegment::PoolSize();
+  {
+    PathSegment first(kUserId);
+    PathSegment second(kUserId);
+    PathSegment short_segment(kAutoId);
+
+    EXPECT_EQ(*first, kUserId);
+    EXPECT_EQ(&*first, &*second);
+    EXPECT_EQ(*short_segment, kAutoId);
+    EXPECT_EQ(PathSegment::PoolSize(), pool_size + 2);
+  }
+  EXPECT_EQ(PathSegment::PoolSize(), pool_size);
+}
+
+TEST(PathSegmentTest, InternsEmptyAndBinarySegments) {
+  std::string binary(9, 'x');
+  binary[0] = '\0';
+  PathSegment segment(binary);
+  PathSegment empty("");
+
+  EXPECT_EQ(*segment, binary);
+  EXPECT_EQ(*empty, "");
+  EXPECT_NE(segment, PathSegment("x"));
+  EXPECT_NE(segment, empty);
+}
+
+TEST(PathSegmentTest, ComparesByIdentity) {
+  PathSegment user(kUserId);
+  EXPECT_EQ(user, PathSegment(kUserId));
+  EXPECT_EQ(&*user, &*PathSegment(kUserId));
+  EXPECT_EQ(PathSegment(kAutoId), PathSegment(kAutoId));
+  EXPECT_NE(PathSegment(kAutoId), PathSegment(kUserId));
+  EXPECT_EQ(PathSegment(kUserId).Hash(), PathSegment(kUserId).Hash());
+  EXPECT_EQ(PathSegment(kAutoId).Hash(), PathSegment(kAutoId).Hash());
+}
+
+TEST(PathSegmentTest, CopiesAndMovesKeepEntriesAlive) {
+  size_t pool_size = PathSegment::PoolSize();
+  PathSegment copy("x");
+  {
+    PathSegment original(kUserId);
+    copy = original;
+    PathSegment moved(std::move(original));
+    EXPECT_EQ(*moved, kUserId);
+  }
+  // "x" was released when `copy` was reassigned.
+  EXPECT_EQ(*copy, kUserId);
+  EXPECT_EQ(PathSegment::PoolSize(), pool_size + 1);
+
+  copy = PathSegment("y");
+  EXPECT_EQ(*copy, "y");
+  EXPECT_EQ(PathSegment::PoolSize(), pool_size + 1);
+}
+
+TEST(PathSegmentTest, InternsConcurrently) {
+  size_t pool_size = PathSegment::PoolSize();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 10000; ++i) {
+        PathSegment segment(std::string(kUserId) + std::to_string(i % 50));
+        PathSegment copy = segment;
+        ASSERT_EQ(*copy, std::string(kUserId) + std::to_string(i % 50));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(PathSegment::PoolSize(), pool_size);
+}
+
+TEST(PathSegmentTest, ResourcePathsShareSegments) {
+  ResourcePath path = ResourcePath::FromString(std::string("users/") +
+                                               kUserId + "/posts/" + kAutoId);
+  ResourcePath parent = ResourcePath{"users", kUserId, "posts"};
+
+  EXPECT_EQ(path.PopLast(), parent);
+  EXPECT_EQ(&path[1], &parent[1]);
+  EXPECT_TRUE(parent.IsPrefixOf(path));
+  EXPECT_EQ(path[1], kUserId);
+  EXPECT_EQ(path.last_segment(), kAutoId);
+  EXPECT_EQ(path.CanonicalString(),
+            std::string("users/") + kUserId + "/posts/" + kAutoId);
+  EXPECT_EQ(path.Hash(),
+            ResourcePath::FromString(path.CanonicalString()).Hash());
+}
+
+}  // namespace
+}  // namespace impl
+}  // namespace model
+}  // namespace firestore
+}  // namespace firebase
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/remote/write_coalescing.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace remote {
+namespace {
+
+struct Batch {
+  size_t writes;
+  size_t bytes;
+};
+
+class WriteCoalescingTest : public testing::Test {
+ protected:
+  size_t Count(const std::vector<Batch>& batches) {
+    return CountCoalescedBatches(
+        batches.size(), [&](size_t i) { return batches[i].writes; },
+        [&](size_t i) {
+          measured_.push_back(i);
+          return batches[i].bytes;
+        });
+  }
+
+  std::vector<size_t> measured_;
+};
+
+TEST_F(WriteCoalescingTest, NoBatches) {
+  EXPECT_EQ(Count({}), 0u);
+}
+
+TEST_F(WriteCoalescingTest, LoneBatchIsNotMeasured) {
+  EXPECT_EQ(Count({{1, 100}}), 1u);
+  EXPECT_TRUE(measured_.empty());
+}
+
+TEST_F(WriteCoalescingTest, CoalescesBatchesThatFit) {
+  EXPECT_EQ(Count({{1, 100}, {2, 200}, {3, 300}}), 3u);
+  EXPECT_EQ(measured_, (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST_F(WriteCoalescingTest, FillsByteBudgetExactly) {
+  EXPECT_EQ(Count({{1, kMaxWriteRequestBytes / 2},
+                   {1, kMaxWriteRequestBytes / 2},
+                   {1, 1}}),
+            2u);
+}
+
+TEST_F(WriteCoalescingTest, SplitsAtByteBudget) {
+  EXPECT_EQ(Count({{1, kMaxWriteRequestBytes / 2},
+                   {1, kMaxWriteRequestBytes / 2 + 1},
+                   {1, 1}}),
+            1u);
+  // Batches after the first one that doesn't fit are not measured.
+  EXPECT_EQ(measured_, (std::vector<size_t>{0, 1}));
+}
+
+TEST_F(WriteCoalescingTest, FillsWriteLimitExactly) {
+  EXPECT_EQ(Count({{kMaxWritesPerRequest - 1, 10}, {1, 10}, {1, 10}}), 2u);
+}
+
+TEST_F(WriteCoalescingTest, SplitsAtWriteLimit) {
+  EXPECT_EQ(Count({{kMaxWritesPerRequest / 2, 10},
+                   {kMaxWritesPerRequest / 2, 10},
+                   {1, 10}}),
+            2u);
+  EXPECT_EQ(Count({{kMaxWritesPerRequest, 10}, {1, 10}}), 1u);
+}
+
+TEST_F(WriteCoalescingTest, OversizedBatchIsSentAlone) {
+  EXPECT_EQ(Count({{kMaxWritesPerRequest + 1, 10}, {1, 10}}), 1u);
+  EXPECT_EQ(Count({{1, kMaxWriteRequestBytes + 1}, {1, 10}}), 1u);
+}
+
+TEST_F(WriteCoalescingTest, SplitsLongRunIntoRequestsWithinLimits) {
+  // 1000 batches of 3 writes and 5000 bytes each: the write limit allows 166
+  // batches per request and the byte budget 209, so the write limit applies.
+  std::vector<Batch> batches(1000, Batch{3, 5000});
+  std::vector<size_t> request_sizes;
+  for (size_t sent = 0; sent < batches.size();) {
+    std::vector<Batch> unsent(batches.begin() + sent, batches.end());
+    size_t count = Count(unsent);
+    ASSERT_GE(count, 1u);
+    EXPECT_LE(count * 3, kMaxWritesPerRequest);
+    EXPECT_LE(count * 5000, kMaxWriteRequestBytes);
+    request_sizes.push_back(count);
+    sent += count;
+  }
+  EXPECT_EQ(request_sizes,
+            (std::vector<size_t>{166, 166, 166, 166, 166, 166, 4}));
+}
+
+}  // namespace
+}  // namespace remote
+}  // namespace firestore
+}  // namespace firebase
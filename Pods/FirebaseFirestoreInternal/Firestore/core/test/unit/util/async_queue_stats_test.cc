@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Firestore/core/src/util/async_queue_stats.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "Firestore/core/src/util/async_queue.h"
+#include "Firestore/core/src/util/executor.h"
+#include "gtest/gtest.h"
+
+namespace firebase {
+namespace firestore {
+namespace util {
+namespace {
+
+using std::chrono::microseconds;
+
+using Clock = AsyncQueueStats::Clock;
+
+TEST(AsyncQueueStatsTest, TracksQueueDepth) {
+  AsyncQueueStats stats(microseconds(1000));
+  stats.OperationEnqueued();
+  stats.OperationEnqueued();
+  EXPECT_EQ(stats.queue_depth(), 2);
+
+  Clock::time_point now = Clock::now();
+  stats.RecordOperation("op", now, now, now, /*immediate=*/true);
+  EXPECT_EQ(stats.queue_depth(), 1);
+
+  // Delayed operations are not counted towards the queue depth.
+  stats.RecordOperation("timer", now, now, now, /*immediate=*/false);
+  EXPECT_EQ(stats.queue_depth(), 1);
+
+  stats.OperationDropped();
+  EXPECT_EQ(stats.queue_depth(), 0);
+  EXPECT_EQ(stats.max_queue_depth(), 2);
+
+  // The depth never goes negative.
+  stats.OperationDropped();
+  EXPECT_EQ(stats.queue_depth(), 0);
+}
+
+TEST(AsyncQueueStatsTest, DroppedOperationsAreNotRecorded) {
+  AsyncQueueStats stats(microseconds(1000));
+  stats.OperationEnqueued();
+  stats.OperationDropped();
+  EXPECT_TRUE(stats.GetTaskStats().empty());
+  EXPECT_TRUE(stats.GetSlowOperations().empty());
+}
+
+TEST(AsyncQueueStatsTest, ResetKeepsQueueDepth) {
+  AsyncQueueStats stats(microseconds(0));
+  stats.OperationEnqueued();
+  stats.OperationEnqueued();
+  Clock::time_point now = Clock::now();
+  stats.RecordOperation("op", now, now, now, /*immediate=*/true);
+  ASSERT_EQ(stats.GetSlowOperations().size(), 1u);
+
+  stats.Reset();
+  EXPECT_TRUE(stats.GetTaskStats().empty());
+  EXPECT_TRUE(stats.GetSlowOperations().empty());
+  EXPECT_EQ(stats.queue_depth(), 1);
+  EXPECT_EQ(stats.max_queue_depth(), 1);
+}
+
+TEST(AsyncQueueStatsTest, QueueDepthCountsOperationsDiscardedOnDispose) {
+  auto queue = AsyncQueue::Create(Executor::CreateSerial("stats"));
+  queue->EnableInstrumentation(microseconds(1000));
+  std::shared_ptr<AsyncQueueStats> stats = queue->stats();
+
+  std::promise<void> blocker_started;
+  std::promise<void> others_enqueued;
+  queue->Enqueue(
+      [&] {
+        blocker_started.set_value();
+        others_enqueued.get_future().wait();
+        // Keep running until `Dispose` has discarded the operations queued
+        // behind this one.
+        while (stats->queue_depth() > 1) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      },
+      "blocker");
+  blocker_started.get_future().wait();
+  for (int i = 0; i < 3; ++i) {
+    queue->Enqueue([] { FAIL() << "Discarded operations must not run"; },
+                   "discarded");
+  }
+  EXPECT_EQ(stats->queue_depth(), 4);
+  others_enqueued.set_value();
+
+  // Waits for the running operation to finish.
+  queue->Dispose();
+  EXPECT_EQ(stats->queue_depth(), 0);
+  EXPECT_EQ(stats->max_queue_depth(), 4);
+
+  AsyncQueueStats::TaskStatsMap task_stats = stats->GetTaskStats();
+  EXPECT_EQ(task_stats.size(), 1u);
+  EXPECT_EQ(task_stats["blocker"].run_time.count(), 1);
+}
+
+TEST(AsyncQueueStatsTest, QueueDepthIgnoresDisabledInstrumentation) {
+  auto queue = AsyncQueue::Create(Executor::CreateSerial("stats"));
+  queue->EnableInstrumentation(microseconds(1000));
+  std::shared_ptr<AsyncQueueStats> stats = queue->stats();
+
+  queue->EnqueueBlocking([] {});
+  EXPECT_EQ(stats->queue_depth(), 0);
+
+  // Operations enqueued after instrumentation is disabled never report to the
+  // old stats, whether they run or are discarded.
+  queue->DisableInstrumentation();
+  queue->EnqueueBlocking([] {});
+  queue->Dispose();
+  EXPECT_EQ(stats->queue_depth(), 0);
+  EXPECT_EQ(stats->GetTaskStats().size(), 1u);
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace firestore
+}  // namespace firebase
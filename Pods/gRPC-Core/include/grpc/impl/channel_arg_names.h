@@ -81,6 +81,13 @@
 /** How much memory to use for hpack encoding. Int valued, bytes. */
 #define GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_ENCODER \
   "grpc.http2.hpack_table_size.encoder"
+/** EXPERIMENTAL. If non-zero, server connections share the decoded values of
+    headers the client adds to the hpack table with every other server
+    connection in the process, rather than keeping a private copy each.
+    Useful for servers with many clients sending the same headers. Defaults
+    to off (0). */
+#define GRPC_ARG_HTTP2_HPACK_SHARED_INTERNING \
+  "grpc.http2.hpack_shared_interning"
 /** How big a frame are we willing to receive via HTTP2.
     Min 16384, max 16777215. Larger values give lower CPU usage for large
     messages, but more head of line blocking for small messages. */
@@ -259,6 +266,15 @@
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, large reads map the received pages into the process with
+   TCP_ZEROCOPY_RECEIVE instead of copying them. By default, it is disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy receive threshold: only map received pages if a read is
+   expected to return >= this many bytes. By default, this is set to 256KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_RECEIVE_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_receive_bytes_threshold"
 /* Overrides the TCP socket receive buffer size, SO_RCVBUF. */
 #define GRPC_ARG_TCP_RECEIVE_BUFFER_SIZE "grpc.tcp_receive_buffer_size"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
@@ -855,7 +855,8 @@ grpc_call* ClientChannel::CreateCall(
     grpc_call* parent_call, uint32_t propagation_mask,
     grpc_completion_queue* cq, grpc_pollset_set* /*pollset_set_alternative*/,
     Slice path, absl::optional<Slice> authority, Timestamp deadline, bool) {
-  auto arena = call_arena_allocator()->MakeArena();
+  auto arena =
+      call_arena_allocator()->MakeArenaForMethod(path.as_string_view());
   arena->SetContext<grpc_event_engine::experimental::EventEngine>(
       event_engine());
   return MakeClientCall(parent_call, propagation_mask, cq, std::move(path),
@@ -60,6 +60,15 @@ ABSL_FLAG(absl::optional<std::string>, grpc_poll_strategy, {},
           "Declares which polling engines to try when starting gRPC. This is a "
           "comma-separated list of engines, which are tried in priority order "
           "first -> last.");
+ABSL_FLAG(absl::optional<int32_t>, grpc_poller_busy_poll_us, {},
+          "EXPERIMENTAL. The longest time in microseconds the epoll1 poller "
+          "spins polling for events without blocking before it goes to "
+          "sleep. The poller shrinks the window while spinning finds nothing "
+          "and grows it back when it does. Set to 0 to never spin.");
+ABSL_FLAG(absl::optional<int32_t>, grpc_poller_events_per_wakeup, {},
+          "EXPERIMENTAL. The number of fd events the epoll1 poller handles on "
+          "each wakeup when it was not kicked. Larger batches amortize the "
+          "wakeup across more events.");
 ABSL_FLAG(absl::optional<bool>, grpc_abort_on_leaks, {},
           "A debugging aid to cause a call to abort() when gRPC objects are "
           "leaked past grpc_shutdown()");
@@ -83,6 +92,13 @@ ConfigVars::ConfigVars(const Overrides& overrides)
           LoadConfig(FLAGS_grpc_client_channel_backup_poll_interval_ms,
                      "GRPC_CLIENT_CHANNEL_BACKUP_POLL_INTERVAL_MS",
                      overrides.client_channel_backup_poll_interval_ms, 5000)),
+      poller_busy_poll_us_(LoadConfig(FLAGS_grpc_poller_busy_poll_us,
+                                      "GRPC_POLLER_BUSY_POLL_US",
+                                      overrides.poller_busy_poll_us, 0)),
+      poller_events_per_wakeup_(
+          LoadConfig(FLAGS_grpc_poller_events_per_wakeup,
+                     "GRPC_POLLER_EVENTS_PER_WAKEUP",
+                     overrides.poller_events_per_wakeup, 1)),
       enable_fork_support_(LoadConfig(
           FLAGS_grpc_enable_fork_support, "GRPC_ENABLE_FORK_SUPPORT",
           overrides.enable_fork_support, GRPC_ENABLE_FORK_SUPPORT_DEFAULT)),
@@ -138,6 +154,8 @@ std::string ConfigVars::ToString() const {
       absl::CEscape(Verbosity()), "\"",
       ", enable_fork_support: ", EnableForkSupport() ? "true" : "false",
       ", poll_strategy: ", "\"", absl::CEscape(PollStrategy()), "\"",
+      ", poller_busy_poll_us: ", PollerBusyPollUs(),
+      ", poller_events_per_wakeup: ", PollerEventsPerWakeup(),
       ", abort_on_leaks: ", AbortOnLeaks() ? "true" : "false",
       ", system_ssl_roots_dir: ", "\"", absl::CEscape(SystemSslRootsDir()),
       "\"", ", default_ssl_roots_file_path: ", "\"",
@@ -34,6 +34,8 @@ class GPR_DLL ConfigVars {
  public:
   struct Overrides {
     absl::optional<int32_t> client_channel_backup_poll_interval_ms;
+    absl::optional<int32_t> poller_busy_poll_us;
+    absl::optional<int32_t> poller_events_per_wakeup;
     absl::optional<bool> enable_fork_support;
     absl::optional<bool> abort_on_leaks;
     absl::optional<bool> not_use_system_ssl_roots;
@@ -86,6 +88,15 @@ class GPR_DLL ConfigVars {
   // comma-separated list of engines, which are tried in priority order first ->
   // last.
   absl::string_view PollStrategy() const { return poll_strategy_; }
+  // EXPERIMENTAL. The longest time in microseconds the epoll1 poller spins
+  // polling for events without blocking before it goes to sleep. The poller
+  // shrinks the window while spinning finds nothing and grows it back when it
+  // does. Set to 0 to never spin.
+  int32_t PollerBusyPollUs() const { return poller_busy_poll_us_; }
+  // EXPERIMENTAL. The number of fd events the epoll1 poller handles on each
+  // wakeup when it was not kicked. Larger batches amortize the wakeup across
+  // more events.
+  int32_t PollerEventsPerWakeup() const { return poller_events_per_wakeup_; }
   // A debugging aid to cause a call to abort() when gRPC objects are leaked
   // past grpc_shutdown()
   bool AbortOnLeaks() const { return abort_on_leaks_; }
@@ -109,6 +120,8 @@ class GPR_DLL ConfigVars {
   static const ConfigVars& Load();
   static std::atomic<ConfigVars*> config_vars_;
   int32_t client_channel_backup_poll_interval_ms_;
+  int32_t poller_busy_poll_us_;
+  int32_t poller_events_per_wakeup_;
   bool enable_fork_support_;
   bool abort_on_leaks_;
   bool not_use_system_ssl_roots_;
@@ -47,6 +47,34 @@ static const b64_huff_sym huff_alphabet[64] = {
 
 static const uint8_t tail_xtra[3] = {0, 2, 3};
 
+// The huffman encoders below accumulate codes in a 64 bit word and write them
+// out 32 bits at a time, rather than a byte at a time.
+static void write_be32(uint8_t* out, uint32_t value) {
+  out[0] = static_cast<uint8_t>(value >> 24);
+  out[1] = static_cast<uint8_t>(value >> 16);
+  out[2] = static_cast<uint8_t>(value >> 8);
+  out[3] = static_cast<uint8_t>(value);
+}
+
+// Writes out the whole bytes left in temp, followed by the last partial byte
+// padded with ones (the EOS prefix) as required by RFC 7541 5.2.
+static uint8_t* flush_tail(uint64_t temp, uint32_t temp_length, uint8_t* out) {
+  while (temp_length >= 8) {
+    temp_length -= 8;
+    *out++ = static_cast<uint8_t>(temp >> temp_length);
+  }
+  if (temp_length) {
+    // NB: the following integer arithmetic operation needs to be in its
+    // expanded form due to the "integral promotion" performed (see section
+    // 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
+    // is then required to avoid the compiler warning
+    *out++ =
+        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
+                             static_cast<uint8_t>(0xffu >> temp_length));
+  }
+  return out;
+}
+
 grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
   size_t input_triplets = input_length / 3;
@@ -110,25 +138,20 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
        ++in) {
     int sym = *in;
+    // Codes are at most 30 bits long, and fewer than 32 bits are pending
+    // here, so temp can't overflow.
     temp <<= grpc_chttp2_huffsyms[sym].length;
     temp |= grpc_chttp2_huffsyms[sym].bits;
     temp_length += grpc_chttp2_huffsyms[sym].length;
 
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
+    if (temp_length >= 32) {
+      temp_length -= 32;
+      write_be32(out, static_cast<uint32_t>(temp >> temp_length));
+      out += 4;
     }
   }
 
-  if (temp_length) {
-    // NB: the following integer arithmetic operation needs to be in its
-    // expanded form due to the "integral promotion" performed (see section
-    // 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-    // is then required to avoid the compiler warning
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
-  }
+  out = flush_tail(temp, temp_length, out);
 
   CHECK(out == GRPC_SLICE_END_PTR(output));
 
@@ -136,14 +159,15 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
 }
 
 struct huff_out {
-  uint32_t temp;
+  uint64_t temp;
   uint32_t temp_length;
   uint8_t* out;
 };
 static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    write_be32(out->out, static_cast<uint32_t>(out->temp >> out->temp_length));
+    out->out += 4;
   }
 }
 
@@ -152,7 +176,7 @@ static void enc_add2(huff_out* out, uint8_t a, uint8_t b, uint32_t* wire_size) {
   b64_huff_sym sa = huff_alphabet[a];
   b64_huff_sym sb = huff_alphabet[b];
   out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
+              (static_cast<uint64_t>(sa.bits) << sb.length) | sb.bits;
   out->temp_length +=
       static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
   enc_flush_some(out);
@@ -216,15 +240,7 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     }
   }
 
-  if (out.temp_length) {
-    // NB: the following integer arithmetic operation needs to be in its
-    // expanded form due to the "integral promotion" performed (see section
-    // 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-    // is then required to avoid the compiler warning
-    *out.out++ = static_cast<uint8_t>(
-        static_cast<uint8_t>(out.temp << (8u - out.temp_length)) |
-        static_cast<uint8_t>(0xffu >> out.temp_length));
-  }
+  out.out = flush_tail(out.temp, out.temp_length, out.out);
 
   CHECK(out.out <= GRPC_SLICE_END_PTR(output));
   GRPC_SLICE_SET_LENGTH(output, out.out - start_out);
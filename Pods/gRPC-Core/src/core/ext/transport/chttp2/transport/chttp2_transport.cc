@@ -64,6 +64,7 @@
 #include "src/core/ext/transport/chttp2/transport/frame_rst_stream.h"
 #include "src/core/ext/transport/chttp2/transport/frame_security.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_intern_cache.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/ext/transport/chttp2/transport/legacy_frame.h"
@@ -531,6 +532,11 @@ static void read_channel_args(grpc_chttp2_transport* t,
   if (value >= 0) {
     t->settings.mutable_local().SetHeaderTableSize(value);
   }
+  if (!is_client &&
+      channel_args.GetBool(GRPC_ARG_HTTP2_HPACK_SHARED_INTERNING)
+          .value_or(false)) {
+    t->hpack_parser.SetInternCache(grpc_core::HPackInternCache::Get());
+  }
   t->settings.mutable_local().SetMaxHeaderListSize(
       grpc_core::GetHardLimitFromChannelArgs(channel_args));
   value = channel_args.GetInt(GRPC_ARG_HTTP2_MAX_FRAME_SIZE).value_or(-1);
@@ -0,0 +1,64 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/chttp2/transport/hpack_intern_cache.h"
+
+#include <grpc/support/port_platform.h>
+
+#include <utility>
+
+#include "absl/hash/hash.h"
+#include "src/core/util/no_destruct.h"
+
+namespace grpc_core {
+
+HPackInternCache* HPackInternCache::Get() {
+  static NoDestruct<HPackInternCache> cache;
+  return cache.get();
+}
+
+HPackInternCache::Slot* HPackInternCache::SlotFor(size_t hash, Shard** shard) {
+  *shard = &shards_[hash % kNumShards];
+  return &(*shard)->slots[(hash / kNumShards) % kSlotsPerShard];
+}
+
+absl::optional<ParsedMetadata<grpc_metadata_batch>> HPackInternCache::Lookup(
+    absl::string_view key, absl::string_view wire_value, bool is_huff) {
+  if (wire_value.size() > kMaxWireLength) return absl::nullopt;
+  Shard* shard;
+  Slot* slot = SlotFor(absl::HashOf(key, wire_value, is_huff), &shard);
+  absl::ReaderMutexLock lock(&shard->mu);
+  if (slot->is_huff != is_huff || slot->key != key ||
+      slot->wire_value != wire_value) {
+    return absl::nullopt;
+  }
+  return slot->md.Copy();
+}
+
+void HPackInternCache::Insert(absl::string_view key,
+                              absl::string_view wire_value, bool is_huff,
+                              const ParsedMetadata<grpc_metadata_batch>& md) {
+  if (wire_value.size() > kMaxWireLength) return;
+  Shard* shard;
+  Slot* slot = SlotFor(absl::HashOf(key, wire_value, is_huff), &shard);
+  ParsedMetadata<grpc_metadata_batch> copy = md.Copy();
+  absl::MutexLock lock(&shard->mu);
+  slot->key.assign(key.data(), key.size());
+  slot->wire_value.assign(wire_value.data(), wire_value.size());
+  slot->is_huff = is_huff;
+  // Release the replaced metadata after the lock is dropped.
+  std::swap(slot->md, copy);
+}
+
+}  // namespace grpc_core
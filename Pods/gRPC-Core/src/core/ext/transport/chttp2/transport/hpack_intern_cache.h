@@ -0,0 +1,92 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_INTERN_CACHE_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_INTERN_CACHE_H
+
+#include <grpc/support/port_platform.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/parsed_metadata.h"
+
+namespace grpc_core {
+
+// A process wide cache of parsed HPACK headers, shared by every connection
+// that opts in.
+//
+// Servers with many connections see the same headers (user-agent, authority,
+// per-client auth tokens, ...) from each of them, and would otherwise decode,
+// copy and parse every value again for each connection's dynamic table. The
+// cache is keyed on the header key and the value exactly as it appeared on the
+// wire, so a hit skips the huffman decode, the copy and the metadata parse, and
+// all connections share one refcounted buffer for the value.
+//
+// Lookups only take their shard's lock shared, so hits on different
+// connections don't serialize. Only misses, which insert, take it exclusively.
+//
+// The cache is direct mapped: each (key, wire value) pair hashes to a single
+// slot, and inserting into an occupied slot replaces its entry. This bounds
+// its memory, and lets frequently repeated headers win their slots back from
+// one-off values.
+class HPackInternCache {
+ public:
+  // Values longer than this (on the wire) are never cached.
+  static constexpr size_t kMaxWireLength = 512;
+
+  static HPackInternCache* Get();
+
+  // Returns a copy of the metadata previously stored for `key` and
+  // `wire_value`, if there is one.
+  absl::optional<ParsedMetadata<grpc_metadata_batch>> Lookup(
+      absl::string_view key, absl::string_view wire_value, bool is_huff);
+  // Remembers `md` as the parse of `wire_value` for `key`. Its value must not
+  // reference the input it was parsed from, or the cache would keep that
+  // input alive.
+  void Insert(absl::string_view key, absl::string_view wire_value,
+              bool is_huff, const ParsedMetadata<grpc_metadata_batch>& md);
+
+ private:
+  static constexpr size_t kNumShards = 16;
+  static constexpr size_t kSlotsPerShard = 256;
+
+  struct Slot {
+    std::string key;
+    std::string wire_value;
+    bool is_huff = false;
+    ParsedMetadata<grpc_metadata_batch> md;
+  };
+
+  struct Shard {
+    // An absl::Mutex rather than a grpc_core::Mutex for its reader lock.
+    absl::Mutex mu;
+    Slot slots[kSlotsPerShard] ABSL_GUARDED_BY(mu);
+  };
+
+  // Returns the slot for a hash, and the shard it lives in.
+  Slot* SlotFor(size_t hash, Shard** shard);
+
+  Shard shards_[kNumShards];
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_INTERN_CACHE_H
@@ -351,6 +351,15 @@ absl::string_view HPackParser::String::string_view() const {
   GPR_UNREACHABLE_CODE(return absl::string_view());
 }
 
+// Returns the capacity to reserve for the decoding of a huffman coded string
+// of `length` bytes, so that the decoder never has to grow its output. Huffman
+// codes are at least 5 bits long, which bounds the decoded size. Returns 0 if
+// the string hasn't been fully received yet, since parsing will stop early.
+static size_t HuffDecodeReserveSize(size_t remaining, size_t length) {
+  if (remaining < length) return 0;
+  return length * 8 / 5;
+}
+
 template <typename Out>
 HpackParseStatus HPackParser::String::ParseHuff(Input* input, uint32_t length,
                                                 Out output) {
@@ -502,6 +511,7 @@ HPackParser::String::StringResult HPackParser::String::Parse(Input* input,
   if (is_huff) {
     // Huffman coded
     std::vector<uint8_t> output;
+    output.reserve(HuffDecodeReserveSize(input->remaining(), length));
     HpackParseStatus sts =
         ParseHuff(input, length, [&output](uint8_t c) { output.push_back(c); });
     size_t wire_len = output.size();
@@ -525,6 +535,7 @@ HPackParser::String::StringResult HPackParser::String::ParseBinary(
   } else {
     // Huffman encoded...
     std::vector<uint8_t> decompressed;
+    decompressed.reserve(HuffDecodeReserveSize(input->remaining(), length));
     // State here says either we don't know if it's base64 or binary, or we do
     // and what is it.
     enum class State { kUnsure, kBinary, kBase64 };
@@ -951,10 +962,37 @@ class HPackParser::Parser {
     }
   }
 
+  // Returns the wire bytes of the value about to be parsed if it should be
+  // looked up in, and added to, the intern cache. Only values headed for the
+  // hpack table are worth sharing: they're the ones the peer expects to repeat.
+  absl::optional<absl::string_view> InternableWireValue() const {
+    if (state_.intern_cache == nullptr || !state_.add_to_table ||
+        state_.is_binary_header ||
+        state_.string_length > HPackInternCache::kMaxWireLength ||
+        input_->remaining() < state_.string_length) {
+      return absl::nullopt;
+    }
+    return absl::string_view(reinterpret_cast<const char*>(input_->cur_ptr()),
+                             state_.string_length);
+  }
+
   bool ParseValueBody() {
     DCHECK(state_.parse_state == ParseState::kParsingValueBody);
+    const auto wire_value = InternableWireValue();
+    absl::optional<ParsedMetadata<grpc_metadata_batch>> interned;
+    if (wire_value.has_value()) {
+      interned = state_.intern_cache->Lookup(
+          Match(
+              state_.key, [](const Slice& s) { return s.as_string_view(); },
+              [](const HPackTable::Memento* m) { return m->md.key(); }),
+          *wire_value, state_.is_string_huff_compressed);
+      if (interned.has_value()) input_->Advance(state_.string_length);
+    }
     auto value =
-        state_.is_binary_header
+        interned.has_value()
+            ? String::StringResult{HpackParseStatus::kOk, state_.string_length,
+                                   String()}
+        : state_.is_binary_header
             ? String::ParseBinary(input_, state_.is_string_huff_compressed,
                                   state_.string_length)
             : String::Parse(input_, state_.is_string_huff_compressed,
@@ -994,18 +1032,33 @@ class HPackParser::Parser {
         }
       }
     }
-    auto value_slice = value.value.Take();
-    const auto transport_size =
-        key_string.size() + value.wire_size + hpack_constants::kEntryOverhead;
-    auto md = grpc_metadata_batch::Parse(
-        key_string, std::move(value_slice), state_.add_to_table, transport_size,
-        [key_string, this](absl::string_view message, const Slice&) {
-          if (!state_.field_error.ok()) return;
-          input_->SetErrorAndContinueParsing(
-              HpackParseResult::MetadataParseError(key_string));
-          LOG(ERROR) << "Error parsing '" << key_string
-                     << "' metadata: " << message;
-        });
+    ParsedMetadata<grpc_metadata_batch> md;
+    if (interned.has_value()) {
+      md = std::move(*interned);
+    } else {
+      const auto transport_size =
+          key_string.size() + value.wire_size + hpack_constants::kEntryOverhead;
+      bool parse_failed = false;
+      md = grpc_metadata_batch::Parse(
+          key_string, value.value.Take(), state_.add_to_table, transport_size,
+          [key_string, &parse_failed, this](absl::string_view message,
+                                            const Slice&) {
+            parse_failed = true;
+            if (!state_.field_error.ok()) return;
+            input_->SetErrorAndContinueParsing(
+                HpackParseResult::MetadataParseError(key_string));
+            LOG(ERROR) << "Error parsing '" << key_string
+                       << "' metadata: " << message;
+          });
+      // Take() copies the value out of the input, so the cached metadata
+      // doesn't keep the read buffer alive. Only headers that parsed cleanly
+      // are shared, since a hit doesn't report errors again.
+      if (wire_value.has_value() && value.status == HpackParseStatus::kOk &&
+          !parse_failed && state_.field_error.ok()) {
+        state_.intern_cache->Insert(key_string, *wire_value,
+                                    state_.is_string_huff_compressed, md);
+      }
+    }
     HPackTable::Memento memento{
         std::move(md), state_.field_error.PersistentStreamErrorOrNullptr()};
     input_->UpdateFrontier();
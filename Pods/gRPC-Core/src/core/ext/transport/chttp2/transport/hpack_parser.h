@@ -34,6 +34,7 @@
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include "absl/types/variant.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_intern_cache.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parse_result.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser_table.h"
 #include "src/core/ext/transport/chttp2/transport/legacy_frame.h"
@@ -106,6 +107,10 @@ class HPackParser {
   // Reset state ready for the next BeginFrame
   void FinishFrame();
 
+  // Share decoded values of headers added to the hpack table through `cache`.
+  // Intended for servers, which see the same headers on many connections.
+  void SetInternCache(HPackInternCache* cache) { state_.intern_cache = cache; }
+
   // Retrieve the associated hpack table (for tests, debugging)
   HPackTable* hpack_table() { return &state_.hpack_table; }
   // Is the current frame a boundary of some sort
@@ -252,6 +257,8 @@ class HPackParser {
     // Current parse state
     ParseState parse_state = ParseState::kTop;
     absl::variant<const HPackTable::Memento*, Slice> key;
+    // Cache of decoded values shared with other connections, if any
+    HPackInternCache* intern_cache = nullptr;
   };
 
   grpc_error_handle ParseInput(Input input, bool is_last,
@@ -112,7 +112,10 @@ class InprocServerTransport final : public ServerTransport {
       case ConnectionState::kReady:
         break;
     }
-    auto arena = call_arena_allocator_->MakeArena();
+    auto* path = md->get_pointer(HttpPathMetadata());
+    auto arena = path == nullptr ? call_arena_allocator_->MakeArena()
+                                 : call_arena_allocator_->MakeArenaForMethod(
+                                       path->as_string_view());
     arena->SetContext<grpc_event_engine::experimental::EventEngine>(
         event_engine_.get());
     auto server_call = MakeCallPair(std::move(md), std::move(arena));
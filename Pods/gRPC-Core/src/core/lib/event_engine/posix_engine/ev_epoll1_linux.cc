@@ -19,7 +19,9 @@
 #include <grpc/support/sync.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 #include "absl/log/check.h"
@@ -27,6 +29,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "src/core/config/config_vars.h"
 #include "src/core/lib/event_engine/poller.h"
 #include "src/core/lib/event_engine/time_util.h"
 #include "src/core/lib/iomgr/port.h"
@@ -46,13 +49,13 @@
 #include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
 #include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
 #include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix_default.h"
+#include "src/core/telemetry/stats.h"
+#include "src/core/telemetry/stats_data.h"
 #include "src/core/util/fork.h"
 #include "src/core/util/status_helper.h"
 #include "src/core/util/strerror.h"
 #include "src/core/util/sync.h"
 
-#define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION 1
-
 namespace grpc_event_engine {
 namespace experimental {
 
@@ -363,6 +366,14 @@ Epoll1Poller::Epoll1Poller(Scheduler* scheduler)
                   &ev) == 0);
   g_epoll_set_.num_events = 0;
   g_epoll_set_.cursor = 0;
+  const auto& config = grpc_core::ConfigVars::Get();
+  events_per_wakeup_ =
+      std::clamp(config.PollerEventsPerWakeup(), 1, MAX_EPOLL_EVENTS);
+  max_busy_poll_window_ =
+      std::chrono::microseconds(std::max(config.PollerBusyPollUs(), 0));
+  min_busy_poll_window_ = std::max<EventEngine::Duration>(
+      max_busy_poll_window_ / 16, std::chrono::microseconds(1));
+  busy_poll_window_ = max_busy_poll_window_;
   ForkPollerListAddPoller(this);
 }
 
@@ -464,19 +475,53 @@ bool Epoll1Poller::ProcessEpollEvents(int max_epoll_events_to_handle,
 //  See ProcessEpollEvents() function for more details. It returns the number
 // of events generated by epoll_wait.
 int Epoll1Poller::DoEpollWait(EventEngine::Duration timeout) {
+  int r = 0;
+  if (max_busy_poll_window_ > EventEngine::Duration::zero() &&
+      timeout > EventEngine::Duration::zero()) {
+    // Spin for a while before going to sleep, since a sleeping poller only
+    // reacts to an event after the kernel has woken it up and rescheduled it.
+    auto start = std::chrono::steady_clock::now();
+    auto spin_deadline = start + std::min(busy_poll_window_, timeout);
+    std::chrono::steady_clock::time_point now;
+    do {
+      r = EpollWait(0);
+      now = std::chrono::steady_clock::now();
+    } while (r == 0 && now < spin_deadline);
+    auto spun = now - start;
+    grpc_core::global_stats().IncrementPollerBusyPollMicros(static_cast<int>(
+        std::chrono::duration_cast<std::chrono::microseconds>(spun).count()));
+    // Keep spinning for longer while it pays off, and back off while it
+    // doesn't.
+    if (r > 0) {
+      busy_poll_window_ = std::min(busy_poll_window_ * 2, max_busy_poll_window_);
+    } else {
+      busy_poll_window_ =
+          std::max(busy_poll_window_ / 2, min_busy_poll_window_);
+      timeout = std::max(
+          timeout - std::chrono::duration_cast<EventEngine::Duration>(spun),
+          EventEngine::Duration::zero());
+    }
+  }
+  if (r == 0) {
+    r = EpollWait(static_cast<int>(
+        grpc_event_engine::experimental::Milliseconds(timeout)));
+  }
+  g_epoll_set_.num_events = r;
+  g_epoll_set_.cursor = 0;
+  return r;
+}
+
+int Epoll1Poller::EpollWait(int timeout_ms) {
   int r;
   do {
     r = epoll_wait(g_epoll_set_.epfd, g_epoll_set_.events, MAX_EPOLL_EVENTS,
-                   static_cast<int>(
-                       grpc_event_engine::experimental::Milliseconds(timeout)));
+                   timeout_ms);
   } while (r < 0 && errno == EINTR);
   if (r < 0) {
     grpc_core::Crash(absl::StrFormat(
         "(event_engine) Epoll1Poller:%p encountered epoll_wait error: %s", this,
         grpc_core::StrError(errno).c_str()));
   }
-  g_epoll_set_.num_events = r;
-  g_epoll_set_.cursor = 0;
   return r;
 }
 
@@ -531,9 +576,8 @@ Poller::WorkResult Epoll1Poller::Work(
   {
     grpc_core::MutexLock lock(&mu_);
     // If was_kicked_ is true, collect all pending events in this iteration.
-    if (ProcessEpollEvents(
-            was_kicked_ ? INT_MAX : MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION,
-            pending_events)) {
+    if (ProcessEpollEvents(was_kicked_ ? INT_MAX : events_per_wakeup_,
+                           pending_events)) {
       was_kicked_ = false;
       was_kicked_ext = true;
     }
@@ -541,6 +585,8 @@ Poller::WorkResult Epoll1Poller::Work(
       return Poller::WorkResult::kKicked;
     }
   }
+  grpc_core::global_stats().IncrementPollerEventsPerWakeup(
+      static_cast<int>(pending_events.size()));
   // Run the provided callback.
   schedule_poll_again();
   // Process all pending events inline.
@@ -609,6 +655,10 @@ int Epoll1Poller::DoEpollWait(EventEngine::Duration /*timeout*/) {
   grpc_core::Crash("unimplemented");
 }
 
+int Epoll1Poller::EpollWait(int /*timeout_ms*/) {
+  grpc_core::Crash("unimplemented");
+}
+
 Poller::WorkResult Epoll1Poller::Work(
     EventEngine::Duration /*timeout*/,
     absl::FunctionRef<void()> /*schedule_poll_again*/) {
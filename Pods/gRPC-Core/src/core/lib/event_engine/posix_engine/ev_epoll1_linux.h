@@ -89,8 +89,13 @@ class Epoll1Poller : public PosixEventPoller {
   //  not "process" any of the events yet; that is done in ProcessEpollEvents().
   //  See ProcessEpollEvents() function for more details. It returns the number
   // of events generated by epoll_wait.
+  //  When busy polling is enabled, it first spins on a non-blocking
+  //  epoll_wait for up to the current busy poll window before it blocks.
   int DoEpollWait(
       grpc_event_engine::experimental::EventEngine::Duration timeout);
+  // Calls epoll_wait once, retrying on EINTR, and returns the number of events
+  // stored in g_epoll_set.events.
+  int EpollWait(int timeout_ms);
   class HandlesList {
    public:
     explicit HandlesList(Epoll1EventHandle* handle) : handle(handle) {}
@@ -121,6 +126,16 @@ class Epoll1Poller : public PosixEventPoller {
   // A singleton epoll set
   EpollSet g_epoll_set_;
   bool was_kicked_ ABSL_GUARDED_BY(mu_);
+  // The number of events handled by each Work() call that was not kicked.
+  int events_per_wakeup_ = 1;
+  // The bounds of the time DoEpollWait() spins before blocking, and the
+  // current window, which adapts to whether spinning has been finding events.
+  // Like g_epoll_set_, these are only accessed by the polling thread.
+  grpc_event_engine::experimental::EventEngine::Duration max_busy_poll_window_{
+      0};
+  grpc_event_engine::experimental::EventEngine::Duration min_busy_poll_window_{
+      0};
+  grpc_event_engine::experimental::EventEngine::Duration busy_poll_window_{0};
   std::list<EventHandle*> free_epoll1_handles_list_ ABSL_GUARDED_BY(mu_);
   std::unique_ptr<WakeupFd> wakeup_fd_;
   bool closed_;
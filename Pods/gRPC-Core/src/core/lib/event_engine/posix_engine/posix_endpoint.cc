@@ -61,7 +61,9 @@
 #include <linux/errqueue.h>    // IWYU pragma: keep
 #include <linux/netlink.h>     // IWYU pragma: keep
 #include <sys/prctl.h>         // IWYU pragma: keep
+#include <sys/mman.h>          // IWYU pragma: keep
 #include <sys/resource.h>      // IWYU pragma: keep
+#include <unistd.h>            // IWYU pragma: keep
 #endif
 #include <netinet/in.h>  // IWYU pragma: keep
 
@@ -74,6 +76,10 @@
 #define TCP_CM_INQ TCP_INQ
 #endif
 
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+
 #ifdef GRPC_HAVE_MSG_NOSIGNAL
 #define SENDMSG_FLAGS MSG_NOSIGNAL
 #else
@@ -309,7 +315,33 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
   CHECK_NE(incoming_buffer_->Length(), 0u);
   DCHECK_GT(min_progress_size_, 0);
 
-  do {
+  // Map as much of the payload as possible first. Whatever is left, such as
+  // the bytes after the last whole page, is copied below.
+  SliceBuffer zerocopy_buffer;
+  size_t expected_length =
+      std::max<size_t>(min_progress_size_, static_cast<size_t>(target_length_));
+  size_t zerocopy_read_bytes =
+      TcpZerocopyReceive(expected_length, zerocopy_buffer);
+
+  // Only copy what is left of the expected read, so that the pages behind it
+  // are left for the next read to map rather than copied here.
+  size_t copy_length = incoming_buffer_->Length();
+  if (zerocopy_read_bytes > 0) {
+    copy_length = std::min(copy_length, expected_length - zerocopy_read_bytes);
+    size_t iov_bytes = 0;
+    for (size_t i = 0; i < iov_len; i++) {
+      if (iov_bytes + iov[i].iov_len >= copy_length) {
+        iov[i].iov_len = copy_length - iov_bytes;
+        iov_len = i + 1;
+        break;
+      }
+      iov_bytes += iov[i].iov_len;
+    }
+    // Nothing left to copy, so the socket may well still be readable.
+    if (copy_length == 0) inq_ = 1;
+  }
+
+  while (copy_length > 0) {
     // Assume there is something on the queue. If we receive TCP_INQ from
     // kernel, we will update this value, otherwise, we have to assume there is
     // always something to read until we get EAGAIN.
@@ -335,7 +367,7 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
     if (read_bytes < 0 && errno == EAGAIN) {
       // NB: After calling call_read_cb a parallel call of the read handler may
       // be running.
-      if (total_read_bytes > 0) {
+      if (total_read_bytes > 0 || zerocopy_read_bytes > 0) {
         break;
       }
       FinishEstimate();
@@ -345,7 +377,7 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
 
     // We have read something in previous reads. We need to deliver those bytes
     // to the upper layer.
-    if (read_bytes <= 0 && total_read_bytes >= 1) {
+    if (read_bytes <= 0 && total_read_bytes + zerocopy_read_bytes >= 1) {
       break;
     }
 
@@ -379,7 +411,7 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
 #endif  // GRPC_HAVE_TCP_INQ
 
     total_read_bytes += read_bytes;
-    if (inq_ == 0 || total_read_bytes == incoming_buffer_->Length()) {
+    if (inq_ == 0 || total_read_bytes == copy_length) {
       break;
     }
 
@@ -403,7 +435,7 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
       ++j;
     }
     iov_len = j;
-  } while (true);
+  }
 
   if (inq_ == 0) {
     FinishEstimate();
@@ -415,12 +447,15 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
     inq_ = 1;
   }
 
-  DCHECK_GT(total_read_bytes, 0u);
+  DCHECK_GT(total_read_bytes + zerocopy_read_bytes, 0u);
   status = absl::OkStatus();
   if (grpc_core::IsTcpFrameSizeTuningEnabled()) {
     // Update min progress size based on the total number of bytes read in
     // this round.
-    min_progress_size_ -= total_read_bytes;
+    min_progress_size_ -= total_read_bytes + zerocopy_read_bytes;
+    // The zero-copy bytes precede the ones read into incoming_buffer_.
+    zerocopy_buffer.MoveFirstNBytesIntoSliceBuffer(zerocopy_read_bytes,
+                                                   last_read_buffer_);
     if (min_progress_size_ > 0) {
       // There is still some bytes left to be read before we can signal
       // the read as complete. Append the bytes read so far into
@@ -447,6 +482,11 @@ bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
     incoming_buffer_->MoveLastNBytesIntoSliceBuffer(
         incoming_buffer_->Length() - total_read_bytes, last_read_buffer_);
   }
+  if (zerocopy_read_bytes > 0) {
+    incoming_buffer_->MoveFirstNBytesIntoSliceBuffer(total_read_bytes,
+                                                     zerocopy_buffer);
+    incoming_buffer_->Swap(zerocopy_buffer);
+  }
   return true;
 }
 
@@ -545,6 +585,150 @@ void PosixEndpointImpl::MaybeMakeReadSlices() {
   }
 }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+namespace {
+
+// The prefix of struct tcp_zerocopy_receive understood by every kernel that
+// supports TCP_ZEROCOPY_RECEIVE (4.18 and later). It is declared here because
+// <linux/tcp.h> conflicts with <netinet/tcp.h>.
+struct TcpZerocopyReceiveArgs {
+  uint64_t address;         // In: address of mapping.
+  uint32_t length;          // In/out: number of bytes to map/mapped.
+  uint32_t recv_skip_hint;  // Out: number of bytes to read with recvmsg.
+};
+
+// Owns the pages of one zero-copy read on behalf of the slice holding them,
+// along with the quota charged for them.
+struct ZerocopyReceiveMapping {
+  grpc_core::RefCountedPtr<TcpZerocopyReceiveRegions> regions;
+  void* addr;
+  size_t length;
+  grpc_core::MemoryAllocator::Reservation reservation;
+};
+
+void ReleaseZerocopyReceiveMapping(void* arg) {
+  auto* mapping = static_cast<ZerocopyReceiveMapping*>(arg);
+  mapping->regions->Put(mapping->addr, mapping->length);
+  delete mapping;
+}
+
+}  // namespace
+
+TcpZerocopyReceiveRegions::~TcpZerocopyReceiveRegions() {
+  for (void* addr : free_regions_) munmap(addr, region_length_);
+}
+
+void* TcpZerocopyReceiveRegions::Get() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (!free_regions_.empty()) {
+      void* addr = free_regions_.back();
+      free_regions_.pop_back();
+      return addr;
+    }
+  }
+  void* addr = mmap(nullptr, region_length_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << "Failed to map rx zero-copy region: "
+               << grpc_core::StrError(errno);
+    return nullptr;
+  }
+  return addr;
+}
+
+void TcpZerocopyReceiveRegions::Put(void* addr, size_t length) {
+  // Zapping the pages hands them back to the socket; the range itself stays
+  // mapped and the next receive into it starts from empty page tables.
+  if (length > 0) madvise(addr, length, MADV_DONTNEED);
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (free_regions_.size() < kMaxFreeRegions) {
+      free_regions_.push_back(addr);
+      return;
+    }
+  }
+  munmap(addr, region_length_);
+}
+
+size_t PosixEndpointImpl::TcpZerocopyReceive(size_t expected_length,
+                                             SliceBuffer& buffer) {
+  if (!rx_zerocopy_enabled_ || !memory_owner_.is_valid()) return 0;
+  static const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t received = 0;
+  while (rx_zerocopy_enabled_ && received < expected_length) {
+    // Pages can only be mapped whole, so a read is only worth mapping if
+    // enough bytes are expected to arrive.
+    size_t map_length = std::min(expected_length - received,
+                                 rx_zerocopy_regions_->RegionLength());
+    map_length -= map_length % kPageSize;
+    if (map_length == 0 || map_length < rx_zerocopy_threshold_) break;
+
+    void* addr = rx_zerocopy_regions_->Get();
+    if (addr == nullptr) {
+      rx_zerocopy_enabled_ = false;
+      break;
+    }
+    TcpZerocopyReceiveArgs zc{};
+    zc.address = reinterpret_cast<uintptr_t>(addr);
+    zc.length = static_cast<uint32_t>(map_length);
+    socklen_t zc_len = sizeof(zc);
+    int ret = getsockopt(fd_, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+    if (ret != 0 && errno != EAGAIN && errno != EINTR) {
+      // Any other failure means the socket can't do zerocopy receives at all,
+      // e.g. because the kernel lacks support or it isn't a TCP socket.
+      LOG(ERROR) << "Disabling rx zero-copy, getsockopt failed: "
+                 << grpc_core::StrError(errno);
+      rx_zerocopy_enabled_ = false;
+    }
+    size_t mapped = ret == 0 ? zc.length : 0;
+    size_t skip = ret == 0 ? zc.recv_skip_hint : 0;
+    if (mapped == 0) {
+      rx_zerocopy_regions_->Put(addr, 0);
+    } else {
+      AddToEstimate(mapped);
+      received += mapped;
+      // Mapped pages are socket memory the peer can make us hold for as long
+      // as the upper layers keep the slice, so they count against the quota
+      // like the buffers they replace.
+      auto* mapping =
+          new ZerocopyReceiveMapping{rx_zerocopy_regions_, addr, mapped,
+                                     memory_owner_.MakeReservation(mapped)};
+      buffer.Append(Slice(grpc_slice_new_with_user_data(
+          addr, mapped, ReleaseZerocopyReceiveMapping, mapping)));
+    }
+    if (skip == 0) {
+      // A mapping stops at the end of the data the kernel had at hand, which
+      // need not be all of it, so only stop once nothing more could be mapped.
+      if (mapped == 0) break;
+      continue;
+    }
+    if (received == expected_length) break;
+
+    // The kernel can't map the next skip bytes, e.g. because they don't
+    // start on a page boundary or don't fill a page. Copy exactly those so
+    // that the pages behind them can be mapped next round.
+    size_t copy_length = std::min(skip, expected_length - received);
+    MutableSlice copy(memory_owner_.MakeSlice(copy_length));
+    ssize_t copied;
+    do {
+      copied = recv(fd_, copy.begin(), copy_length, 0);
+    } while (copied < 0 && errno == EINTR);
+    // Leave EAGAIN, end of stream and errors to the recvmsg loop to report.
+    if (copied <= 0) break;
+    AddToEstimate(static_cast<size_t>(copied));
+    received += copied;
+    buffer.Append(Slice(copy.TakeCSlice()).TakeSubSlice(0, copied));
+    if (static_cast<size_t>(copied) < copy_length) break;
+  }
+  return received;
+}
+#else   // GRPC_LINUX_ERRQUEUE
+size_t PosixEndpointImpl::TcpZerocopyReceive(size_t /*expected_length*/,
+                                             SliceBuffer& /*buffer*/) {
+  return 0;
+}
+#endif  // GRPC_LINUX_ERRQUEUE
+
 bool PosixEndpointImpl::HandleReadLocked(absl::Status& status) {
   if (status.ok() && memory_owner_.is_valid()) {
     MaybeMakeReadSlices();
@@ -1308,6 +1492,21 @@ PosixEndpointImpl::PosixEndpointImpl(EventHandle* handle,
               << ",ulimit hard memlock value = " << GetUlimitHardMemLock();
     }
   }
+#endif  // GRPC_LINUX_ERRQUEUE
+#ifdef GRPC_LINUX_ERRQUEUE
+  rx_zerocopy_enabled_ = options.tcp_rx_zero_copy_enabled;
+  rx_zerocopy_threshold_ = options.tcp_rx_zerocopy_receive_bytes_threshold;
+  if (rx_zerocopy_enabled_) {
+    static const int kPageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+    int region_length = max_read_chunk_size_ - max_read_chunk_size_ % kPageSize;
+    if (region_length > 0) {
+      rx_zerocopy_regions_ =
+          grpc_core::MakeRefCounted<TcpZerocopyReceiveRegions>(fd_,
+                                                               region_length);
+    } else {
+      rx_zerocopy_enabled_ = false;
+    }
+  }
 #endif  // GRPC_LINUX_ERRQUEUE
   tcp_zerocopy_send_ctx_ = std::make_unique<TcpZerocopySendCtx>(
       zerocopy_enabled, options.tcp_tx_zerocopy_max_simultaneous_sends,
@@ -29,6 +29,7 @@
 #include <memory>
 #include <new>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
@@ -48,6 +49,7 @@
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/util/crash.h"
 #include "src/core/util/ref_counted.h"
+#include "src/core/util/ref_counted_ptr.h"
 #include "src/core/util/sync.h"
 
 #ifdef GRPC_POSIX_SOCKET_TCP
@@ -463,6 +465,37 @@ class TcpZerocopySendCtx {
   OptMemState zcopy_enobuf_state_ ABSL_GUARDED_BY(mu_) = OptMemState::kOpen;
 };
 
+// Address ranges that received pages are mapped into. A range stays with the
+// slice that references its pages and only comes back once that slice is
+// released, so a steady stream of reads doesn't mmap and munmap every time.
+class TcpZerocopyReceiveRegions
+    : public grpc_core::RefCounted<TcpZerocopyReceiveRegions> {
+ public:
+  TcpZerocopyReceiveRegions(int fd, size_t region_length)
+      : fd_(fd), region_length_(region_length) {}
+  ~TcpZerocopyReceiveRegions() override;
+
+  size_t RegionLength() const { return region_length_; }
+
+  // Returns a range of RegionLength() bytes mapped onto the socket, or
+  // nullptr if it couldn't be mapped.
+  void* Get();
+
+  // Drops the first length bytes of pages mapped into addr and makes the range
+  // available to Get() again.
+  void Put(void* addr, size_t length);
+
+ private:
+  // Enough for a few reads to be in flight in the upper layers at once; more
+  // ranges than that are unmapped when released.
+  static constexpr size_t kMaxFreeRegions = 4;
+
+  const int fd_;
+  const size_t region_length_;
+  grpc_core::Mutex mu_;
+  std::vector<void*> free_regions_ ABSL_GUARDED_BY(mu_);
+};
+
 class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
  public:
   PosixEndpointImpl(
@@ -507,6 +540,16 @@ class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
   void MaybeMakeReadSlices() ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
   bool TcpDoRead(absl::Status& status) ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
+  // Maps up to expected_length received bytes into the process with
+  // TCP_ZEROCOPY_RECEIVE when rx zerocopy is enabled and that is large enough.
+  // Bytes the kernel can't map, such as those ahead of the next page boundary,
+  // are copied so that the pages after them can be mapped too. Appends the
+  // bytes in the order they were received to buffer, mapped ones as slices
+  // that unmap them when released, and returns how many there were.
+  size_t TcpZerocopyReceive(
+      size_t expected_length,
+      grpc_event_engine::experimental::SliceBuffer& buffer)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
   void FinishEstimate();
   void AddToEstimate(size_t bytes);
   void MaybePostReclaimer() ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
@@ -552,6 +595,15 @@ class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
   int inq_ = 1;
   // cache whether kernel supports inq.
   bool inq_capable_ = false;
+  // Whether reads may map received pages instead of copying them. Cleared if
+  // the socket turns out not to support it.
+  bool rx_zerocopy_enabled_ ABSL_GUARDED_BY(read_mu_) = false;
+  // Only map received pages if a read is expected to return at least this
+  // many bytes.
+  size_t rx_zerocopy_threshold_ = 0;
+  // Where received pages are mapped. Shared with the slices holding them, so
+  // it outlives the endpoint until the last of them is released.
+  grpc_core::RefCountedPtr<TcpZerocopyReceiveRegions> rx_zerocopy_regions_;
 
   grpc_event_engine::experimental::SliceBuffer* outgoing_buffer_ = nullptr;
   // byte within outgoing_buffer's slices[0] to write next.
@@ -30,6 +30,8 @@
 #include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/random/distributions.h"
+#include "absl/random/random.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
@@ -194,23 +196,71 @@ void WorkStealingThreadPool::Run(EventEngine::Closure* closure) {
 
 // -------- WorkStealingThreadPool::TheftRegistry --------
 
-void WorkStealingThreadPool::TheftRegistry::Enroll(WorkQueue* queue) {
-  grpc_core::MutexLock lock(&mu_);
-  queues_.emplace(queue);
+WorkStealingThreadPool::TheftRegistry::~TheftRegistry() {
+  Entry* entry = head_.load(std::memory_order_acquire);
+  while (entry != nullptr) {
+    Entry* next = entry->next;
+    CHECK(!entry->in_use.load(std::memory_order_relaxed));
+    delete entry;
+    entry = next;
+  }
+}
+
+WorkQueue* WorkStealingThreadPool::TheftRegistry::Enroll() {
+  // Reuse a queue released by a thread that has exited, if there is one.
+  for (Entry* entry = head_.load(std::memory_order_acquire); entry != nullptr;
+       entry = entry->next) {
+    bool in_use = false;
+    if (!entry->in_use.load(std::memory_order_relaxed) &&
+        entry->in_use.compare_exchange_strong(in_use, true,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+      return &entry->queue;
+    }
+  }
+  auto* entry = new Entry(owner_);
+  entry->next = head_.load(std::memory_order_relaxed);
+  while (!head_.compare_exchange_weak(entry->next, entry,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_relaxed)) {
+  }
+  size_.fetch_add(1, std::memory_order_relaxed);
+  return &entry->queue;
 }
 
 void WorkStealingThreadPool::TheftRegistry::Unenroll(WorkQueue* queue) {
-  grpc_core::MutexLock lock(&mu_);
-  queues_.erase(queue);
+  CHECK(queue->Empty());
+  for (Entry* entry = head_.load(std::memory_order_acquire); entry != nullptr;
+       entry = entry->next) {
+    if (&entry->queue == queue) {
+      entry->in_use.store(false, std::memory_order_release);
+      return;
+    }
+  }
+  grpc_core::Crash("Unenrolled a work queue that was never enrolled");
 }
 
 EventEngine::Closure* WorkStealingThreadPool::TheftRegistry::StealOne() {
-  grpc_core::MutexLock lock(&mu_);
-  EventEngine::Closure* closure;
-  for (auto* queue : queues_) {
-    closure = queue->PopMostRecent();
-    if (closure != nullptr) return closure;
+  thread_local absl::InsecureBitGen bitgen;
+  size_t size = size_.load(std::memory_order_relaxed);
+  if (size == 0) return nullptr;
+  // Entries are only ever pushed onto the head of the list, so the first
+  // `size` entries are stable. Visit them all once, starting at a random one
+  // and wrapping around.
+  Entry* head = head_.load(std::memory_order_acquire);
+  Entry* start = head;
+  for (size_t i = absl::Uniform<size_t>(bitgen, 0, size);
+       i > 0 && start->next != nullptr; --i) {
+    start = start->next;
   }
+  Entry* entry = start;
+  do {
+    if (entry->in_use.load(std::memory_order_relaxed)) {
+      EventEngine::Closure* closure = entry->queue.PopOldest();
+      if (closure != nullptr) return closure;
+    }
+    entry = entry->next != nullptr ? entry->next : head;
+  } while (entry != start);
   return nullptr;
 }
 
@@ -224,7 +274,7 @@ void WorkStealingThreadPool::PostforkChild() { pool_->Postfork(); }
 
 WorkStealingThreadPool::WorkStealingThreadPoolImpl::WorkStealingThreadPoolImpl(
     size_t reserve_threads)
-    : reserve_threads_(reserve_threads), queue_(this) {}
+    : reserve_threads_(reserve_threads), theft_registry_(this), queue_(this) {}
 
 void WorkStealingThreadPool::WorkStealingThreadPoolImpl::Start() {
   for (size_t i = 0; i < reserve_threads_; i++) {
@@ -482,8 +532,7 @@ void WorkStealingThreadPool::ThreadState::ThreadBody() {
 #endif
     pool_->TrackThread(gpr_thd_currentid());
   }
-  g_local_queue = new BasicWorkQueue(pool_.get());
-  pool_->theft_registry()->Enroll(g_local_queue);
+  g_local_queue = pool_->theft_registry()->Enroll();
   ThreadLocal::SetIsEventEngineThread(true);
   while (Step()) {
     // loop until the thread should no longer run
@@ -501,9 +550,8 @@ void WorkStealingThreadPool::ThreadState::ThreadBody() {
   } else if (pool_->IsShutdown()) {
     FinishDraining();
   }
-  CHECK(g_local_queue->Empty());
   pool_->theft_registry()->Unenroll(g_local_queue);
-  delete g_local_queue;
+  g_local_queue = nullptr;
   if (g_log_verbose_failures) {
     pool_->UntrackThread(gpr_thd_currentid());
   }
@@ -33,6 +33,7 @@
 #include "src/core/lib/event_engine/thread_pool/thread_count.h"
 #include "src/core/lib/event_engine/thread_pool/thread_pool.h"
 #include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
+#include "src/core/lib/event_engine/work_queue/chase_lev_work_queue.h"
 #include "src/core/lib/event_engine/work_queue/work_queue.h"
 #include "src/core/util/backoff.h"
 #include "src/core/util/notification.h"
@@ -77,22 +78,41 @@ class WorkStealingThreadPool final : public ThreadPool {
 
   // A pool of WorkQueues that participate in work stealing.
   //
-  // Every worker thread registers and unregisters its thread-local thread pool
+  // Every worker thread registers and unregisters its thread-local work queue
   // here, and steals closures from other threads when work is otherwise
   // unavailable.
+  //
+  // Stealing is lock-free: queues are kept in an append-only list that is only
+  // ever pushed to, and a queue released by an exiting thread is handed to the
+  // next thread that enrolls rather than being freed. All queues are destroyed
+  // with the registry.
   class TheftRegistry {
    public:
-    // Allow any member of the registry to steal from the provided queue.
-    void Enroll(WorkQueue* queue) ABSL_LOCKS_EXCLUDED(mu_);
-    // Disallow work stealing from the provided queue.
-    void Unenroll(WorkQueue* queue) ABSL_LOCKS_EXCLUDED(mu_);
+    explicit TheftRegistry(void* owner) : owner_(owner) {}
+    ~TheftRegistry();
+    // Returns a work queue for the calling thread, and allows any member of
+    // the registry to steal from it. Only the calling thread may add to the
+    // queue or call its PopMostRecent method.
+    WorkQueue* Enroll();
+    // Disallow work stealing from the provided queue, and release it for reuse
+    // by another thread. The queue must be empty.
+    void Unenroll(WorkQueue* queue);
     // Returns one closure from another thread, or nullptr if none are
-    // available.
-    EventEngine::Closure* StealOne() ABSL_LOCKS_EXCLUDED(mu_);
+    // available. Victims are visited starting at a random queue, so that idle
+    // threads don't all contend on the same one.
+    EventEngine::Closure* StealOne();
 
    private:
-    grpc_core::Mutex mu_;
-    absl::flat_hash_set<WorkQueue*> queues_ ABSL_GUARDED_BY(mu_);
+    struct Entry {
+      explicit Entry(void* owner) : queue(owner) {}
+      ChaseLevWorkQueue queue;
+      std::atomic<bool> in_use{true};
+      Entry* next = nullptr;
+    };
+
+    void* const owner_;
+    std::atomic<Entry*> head_{nullptr};
+    std::atomic<size_t> size_{0};
   };
 
   // An implementation of the ThreadPool
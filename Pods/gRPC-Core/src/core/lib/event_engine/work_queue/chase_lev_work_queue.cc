@@ -0,0 +1,122 @@
+// Copyright 2026 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "src/core/lib/event_engine/work_queue/chase_lev_work_queue.h"
+
+#include <grpc/support/port_platform.h>
+
+#include <utility>
+
+#include "src/core/lib/event_engine/common_closures.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// Implementation note: the owner pushes and takes closures at bottom_, and
+// thieves take them from top_. Slots in [top_, bottom_) hold queued closures.
+// The memory orderings follow the C11 version of the algorithm in the paper.
+
+ChaseLevWorkQueue::ChaseLevWorkQueue(void* owner) : owner_(owner) {}
+
+bool ChaseLevWorkQueue::Empty() const { return Size() == 0; }
+
+size_t ChaseLevWorkQueue::Size() const {
+  int64_t t = top_.load(std::memory_order_acquire);
+  int64_t b = bottom_.load(std::memory_order_acquire);
+  size_t size = b > t ? static_cast<size_t>(b - t) : 0;
+  if (has_overflow_.load(std::memory_order_acquire)) size += overflow_.Size();
+  return size;
+}
+
+EventEngine::Closure* ChaseLevWorkQueue::PopMostRecent() {
+  // Add keeps spilling into the overflow queue until it drains, even if
+  // thieves free up room in the ring buffer, so every closure in the overflow
+  // queue is newer than every closure in the ring buffer.
+  if (has_overflow_.load(std::memory_order_relaxed)) {
+    EventEngine::Closure* closure = overflow_.PopMostRecent();
+    if (closure != nullptr) return closure;
+    // Only the owner adds to the overflow queue, so it stays empty until the
+    // owner adds to it again.
+    has_overflow_.store(false, std::memory_order_relaxed);
+  }
+  int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top_.load(std::memory_order_relaxed);
+  if (t > b) {
+    // Empty.
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  EventEngine::Closure* closure =
+      buffer_[b & kMask].load(std::memory_order_relaxed);
+  if (t == b) {
+    // Last closure: race any thieves for it.
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      closure = nullptr;
+    }
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+  return closure;
+}
+
+EventEngine::Closure* ChaseLevWorkQueue::PopOldest() {
+  int64_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom_.load(std::memory_order_acquire);
+  if (t < b) {
+    EventEngine::Closure* closure =
+        buffer_[t & kMask].load(std::memory_order_relaxed);
+    // Lost the race to the owner or another thief.
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return closure;
+  }
+  if (has_overflow_.load(std::memory_order_acquire)) {
+    return overflow_.PopOldest();
+  }
+  return nullptr;
+}
+
+void ChaseLevWorkQueue::Add(EventEngine::Closure* closure) {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_acquire);
+  if (has_overflow_.load(std::memory_order_relaxed)) {
+    // Adding to the ring buffer ahead of older spilled closures would let
+    // PopMostRecent return those first. Only the owner adds to the overflow
+    // queue, so once it is seen empty it stays that way.
+    if (!overflow_.Empty()) {
+      overflow_.Add(closure);
+      return;
+    }
+    has_overflow_.store(false, std::memory_order_relaxed);
+  }
+  if (b - t >= kCapacity) {
+    has_overflow_.store(true, std::memory_order_release);
+    overflow_.Add(closure);
+    return;
+  }
+  buffer_[b & kMask].store(closure, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+void ChaseLevWorkQueue::Add(absl::AnyInvocable<void()> invocable) {
+  Add(SelfDeletingClosure::Create(std::move(invocable)));
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
@@ -0,0 +1,94 @@
+// Copyright 2026 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_SRC_CORE_LIB_EVENT_ENGINE_WORK_QUEUE_CHASE_LEV_WORK_QUEUE_H
+#define GRPC_SRC_CORE_LIB_EVENT_ENGINE_WORK_QUEUE_CHASE_LEV_WORK_QUEUE_H
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/support/port_platform.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "absl/functional/any_invocable.h"
+#include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
+#include "src/core/lib/event_engine/work_queue/work_queue.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A WorkQueue implementation based on the bounded Chase-Lev work-stealing
+// deque ("Correct and Efficient Work-Stealing for Weak Memory Models", Lê et
+// al., PPoPP 2013).
+//
+// The queue has a single owner thread, which adds closures and takes the most
+// recent ones from the bottom of a ring buffer without taking any lock. Any
+// other thread may steal the oldest closures from the top, which costs one
+// compare-and-swap.
+//
+// Unlike BasicWorkQueue, this queue is not safe for arbitrary concurrent use:
+// Add and PopMostRecent must only be called by the owner thread, while
+// PopOldest, Empty and Size may be called from any thread. Empty and Size are
+// approximate while other threads are stealing.
+//
+// Closures that don't fit in the ring buffer are spilled into a
+// BasicWorkQueue, and later closures keep going there until it drains. The
+// overflow queue therefore only ever holds the newest closures: the owner takes
+// from it before the ring buffer, and thieves after.
+class ChaseLevWorkQueue : public WorkQueue {
+ public:
+  // The number of closures the ring buffer holds. Must be a power of two.
+  static constexpr int64_t kCapacity = 4096;
+
+  ChaseLevWorkQueue() : owner_(nullptr) {}
+  explicit ChaseLevWorkQueue(void* owner);
+  // Returns whether the queue is empty.
+  bool Empty() const override;
+  // Returns the size of the queue.
+  size_t Size() const override;
+  // Returns the most recent element from the queue. Must only be called by the
+  // owner thread.
+  //
+  // This method may return nullptr even if the queue is not empty, if the last
+  // closure was stolen concurrently.
+  EventEngine::Closure* PopMostRecent() override;
+  // Returns the oldest element from the queue, or nullptr if either empty or
+  // the queue is under contention. May be called from any thread.
+  EventEngine::Closure* PopOldest() override;
+  // Adds a closure to the queue. Must only be called by the owner thread.
+  void Add(EventEngine::Closure* closure) override;
+  // Wraps an AnyInvocable and adds it to the the queue. Must only be called by
+  // the owner thread.
+  void Add(absl::AnyInvocable<void()> invocable) override;
+  const void* owner() override { return owner_; }
+
+ private:
+  static constexpr int64_t kMask = kCapacity - 1;
+  static_assert((kCapacity & kMask) == 0, "kCapacity must be a power of two");
+
+  // Stealers and the owner each mostly touch one of the indexes, so keep them
+  // on separate cache lines.
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  std::atomic<EventEngine::Closure*> buffer_[kCapacity]{};
+  BasicWorkQueue overflow_;
+  // Set while the overflow queue may hold closures, so that the common path
+  // doesn't take its lock.
+  std::atomic<bool> has_overflow_{false};
+  const void* const owner_ = nullptr;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_SRC_CORE_LIB_EVENT_ENGINE_WORK_QUEUE_CHASE_LEV_WORK_QUEUE_H
@@ -26,17 +26,95 @@
 
 #include "absl/log/log.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/telemetry/stats.h"
+#include "src/core/telemetry/stats_data.h"
 #include "src/core/util/alloc.h"
+#include "src/core/util/no_destruct.h"
+#include "src/core/util/per_cpu.h"
+#include "src/core/util/sync.h"
 namespace grpc_core {
 
 namespace {
 
+// Initial zones of destroyed arenas, kept for the next arenas created. Calls on
+// a channel mostly get the same size estimate, so in the steady state creating
+// and destroying a call's arena skips malloc and free entirely.
+//
+// The cache is sharded by cpu rather than kept per thread: calls are often
+// created on one thread and destroyed on another, and per thread caches would
+// fill up on the destroying threads while the creating ones kept allocating.
+// It is never destroyed, so arenas can still be destroyed during shutdown and
+// thread exit; the blocks it holds at exit are bounded by the shard count.
+class ArenaBlockCache {
+ public:
+  static constexpr size_t kMaxBlocks = 4;
+  static constexpr size_t kMaxBlockSize = 32 * 1024;
+
+  static ArenaBlockCache& Get() {
+    static NoDestruct<ArenaBlockCache> cache;
+    return *cache;
+  }
+
+  // Returns a cached block of at least `size` bytes, and at most twice that so
+  // that small arenas don't pin large blocks, updating `size` to the size of
+  // the block. Returns nullptr if there's no such block.
+  void* Take(size_t& size) {
+    Shard& shard = shards_.this_cpu();
+    MutexLock lock(&shard.mu);
+    for (size_t i = shard.num_blocks; i > 0; --i) {
+      Block& block = shard.blocks[i - 1];
+      if (block.size < size || block.size / 2 > size) continue;
+      void* storage = block.storage;
+      size = block.size;
+      block = shard.blocks[--shard.num_blocks];
+      return storage;
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of `storage` if it is small enough to cache.
+  bool Put(void* storage, size_t size) {
+    if (size > kMaxBlockSize) return false;
+    void* evicted = nullptr;
+    {
+      Shard& shard = shards_.this_cpu();
+      MutexLock lock(&shard.mu);
+      if (shard.num_blocks == kMaxBlocks) {
+        // Evict the oldest block: recent sizes are the better predictor.
+        evicted = shard.blocks[0].storage;
+        shard.blocks[0] = shard.blocks[--shard.num_blocks];
+      }
+      shard.blocks[shard.num_blocks++] = Block{storage, size};
+    }
+    if (evicted != nullptr) gpr_free_aligned(evicted);
+    return true;
+  }
+
+ private:
+  struct Block {
+    void* storage;
+    size_t size;
+  };
+
+  struct Shard {
+    Mutex mu;
+    Block blocks[kMaxBlocks] ABSL_GUARDED_BY(mu);
+    size_t num_blocks ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  PerCpu<Shard> shards_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
+};
+
 void* ArenaStorage(size_t& initial_size) {
   size_t base_size = Arena::ArenaOverhead() +
                      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(
                          arena_detail::BaseArenaContextTraits::ContextSize());
   initial_size =
       std::max(GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size), base_size);
+  if (void* storage = ArenaBlockCache::Get().Take(initial_size)) {
+    global_stats().IncrementArenaPoolReuses();
+    return storage;
+  }
   static constexpr size_t alignment =
       (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
        GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
@@ -100,8 +178,11 @@ void Arena::DestroyManagedNewObjects() {
 }
 
 void Arena::Destroy() const {
+  const size_t storage_size = initial_zone_size_;
   this->~Arena();
-  gpr_free_aligned(const_cast<Arena*>(this));
+  if (!ArenaBlockCache::Get().Put(const_cast<Arena*>(this), storage_size)) {
+    gpr_free_aligned(const_cast<Arena*>(this));
+  }
 }
 
 void* Arena::AllocZone(size_t size) {
@@ -113,6 +194,7 @@ void* Arena::AllocZone(size_t size) {
   static constexpr size_t zone_base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Zone));
   size_t alloc_size = zone_base_size + size;
+  global_stats().IncrementArenaZoneSpills();
   arena_factory_->allocator().Reserve(alloc_size);
   total_allocated_.fetch_add(alloc_size, std::memory_order_relaxed);
   Zone* z = new (gpr_malloc_aligned(alloc_size, GPR_MAX_ALIGNMENT)) Zone();
@@ -28,6 +28,7 @@
 #include <grpc/event_engine/memory_allocator.h>
 #include <grpc/support/port_platform.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include <atomic>
 #include <iosfwd>
@@ -157,6 +158,11 @@ class Arena final : public RefCounted<Arena, NonPolymorphicRefCount,
     return total_used_.load(std::memory_order_relaxed);
   }
 
+  // An opaque value for the ArenaFactory that created this arena, which lets
+  // FinalizeArena tell apart arenas it made for different purposes.
+  uint32_t factory_tag() const { return factory_tag_; }
+  void set_factory_tag(uint32_t tag) { factory_tag_ = tag; }
+
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(size);
@@ -360,6 +366,7 @@ class Arena final : public RefCounted<Arena, NonPolymorphicRefCount,
   std::atomic<Zone*> last_zone_{nullptr};
   std::atomic<ManagedNewObject*> managed_new_head_{nullptr};
   RefCountedPtr<ArenaFactory> arena_factory_;
+  uint32_t factory_tag_ = 0;
 };
 
 // Arenas form a context for activities
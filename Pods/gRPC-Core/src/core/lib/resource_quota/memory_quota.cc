@@ -436,7 +436,10 @@ void BasicMemoryQuota::Start() {
   auto reclamation_loop = Loop(Seq(
       [self]() -> Poll<int> {
         // If there's free memory we no longer need to reclaim memory!
-        if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
+        // Bytes parked in the cpu caches are free too.
+        if (self->free_bytes_.load(std::memory_order_acquire) > 0 ||
+            (self->DrainCpuCaches() > 0 &&
+             self->free_bytes_.load(std::memory_order_acquire) > 0)) {
           return Pending{};
         }
         return 0;
@@ -492,6 +495,13 @@ void BasicMemoryQuota::Start() {
 void BasicMemoryQuota::Stop() { reclaimer_activity_.reset(); }
 
 void BasicMemoryQuota::SetSize(size_t new_size) {
+  const size_t num_caches = cpu_caches_.end() - cpu_caches_.begin();
+  cpu_cache_limit_.store(
+      static_cast<intptr_t>(std::min<size_t>(kMaxCpuCacheBytes,
+                                             new_size / 16 / num_caches)),
+      std::memory_order_relaxed);
+  // The caches may now hold more than the new limit allows.
+  DrainCpuCaches();
   size_t old_size = quota_size_.exchange(new_size, std::memory_order_relaxed);
   if (old_size < new_size) {
     // We're growing the quota.
@@ -506,11 +516,16 @@ void BasicMemoryQuota::Take(GrpcMemoryAllocatorImpl* allocator, size_t amount) {
   // If there's a request for nothing, then do nothing!
   if (amount == 0) return;
   DCHECK(amount <= std::numeric_limits<intptr_t>::max());
-  // Grab memory from the quota.
-  auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
-  // If we push into overcommit, awake the reclaimer.
-  if (prior >= 0 && prior < static_cast<intptr_t>(amount)) {
-    if (reclaimer_activity_ != nullptr) reclaimer_activity_->ForceWakeup();
+  // Grab memory from this cpu's cache if it can cover the request, and from
+  // the quota otherwise.
+  if (!TakeFromCpuCache(amount)) {
+    auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
+    // If we push into overcommit, awake the reclaimer - unless the bytes
+    // parked in the cpu caches cover the shortfall.
+    if (prior >= 0 && prior < static_cast<intptr_t>(amount) &&
+        prior + DrainCpuCaches() < static_cast<intptr_t>(amount)) {
+      if (reclaimer_activity_ != nullptr) reclaimer_activity_->ForceWakeup();
+    }
   }
 
   if (IsFreeLargeAllocatorEnabled()) {
@@ -551,7 +566,45 @@ void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
 }
 
 void BasicMemoryQuota::Return(size_t amount) {
-  free_bytes_.fetch_add(amount, std::memory_order_relaxed);
+  const intptr_t limit = cpu_cache_limit_.load(std::memory_order_relaxed);
+  // free_bytes_ is only touched once this cpu's cache overflows. Bytes cached
+  // while in overcommit are still seen by reclamation, which drains the caches
+  // before deciding whether to reclaim.
+  if (static_cast<intptr_t>(amount) > limit) {
+    free_bytes_.fetch_add(amount, std::memory_order_relaxed);
+    return;
+  }
+  auto& cache = cpu_caches_.this_cpu().free_bytes;
+  const intptr_t cached =
+      cache.fetch_add(amount, std::memory_order_relaxed) + amount;
+  if (cached > limit) {
+    free_bytes_.fetch_add(cache.exchange(0, std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  }
+}
+
+bool BasicMemoryQuota::TakeFromCpuCache(size_t amount) {
+  auto& cache = cpu_caches_.this_cpu().free_bytes;
+  intptr_t cached = cache.load(std::memory_order_relaxed);
+  while (cached >= static_cast<intptr_t>(amount)) {
+    if (cache.compare_exchange_weak(cached, cached - amount,
+                                    std::memory_order_relaxed,
+                                    std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+intptr_t BasicMemoryQuota::DrainCpuCaches() {
+  intptr_t drained = 0;
+  for (auto& cache : cpu_caches_) {
+    drained += cache.free_bytes.exchange(0, std::memory_order_relaxed);
+  }
+  if (drained != 0) {
+    free_bytes_.fetch_add(drained, std::memory_order_relaxed);
+  }
+  return drained;
 }
 
 void BasicMemoryQuota::AddNewAllocator(GrpcMemoryAllocatorImpl* allocator) {
@@ -41,6 +41,7 @@
 #include "src/core/lib/promise/poll.h"
 #include "src/core/lib/resource_quota/periodic_update.h"
 #include "src/core/util/orphanable.h"
+#include "src/core/util/per_cpu.h"
 #include "src/core/util/ref_counted_ptr.h"
 #include "src/core/util/sync.h"
 #include "src/core/util/time.h"
@@ -350,6 +351,22 @@ class BasicMemoryQuota final
 
   static constexpr intptr_t kInitialSize = std::numeric_limits<intptr_t>::max();
 
+  // Bytes returned to the quota are parked in a per-cpu cache, and later
+  // requests on the same cpu are served from it, so that allocators on
+  // different cpus don't all contend on free_bytes_. Cached bytes are flushed
+  // to free_bytes_ in batches of up to cpu_cache_limit_ bytes.
+  struct alignas(GPR_CACHELINE_SIZE) CpuCache {
+    std::atomic<intptr_t> free_bytes{0};
+  };
+  // The most bytes each cpu cache holds.
+  static constexpr intptr_t kMaxCpuCacheBytes = 64 * 1024;
+
+  // Try to satisfy a Take from this cpu's cache.
+  bool TakeFromCpuCache(size_t amount);
+  // Flush all cpu caches into free_bytes_, returning the number of bytes
+  // flushed.
+  intptr_t DrainCpuCaches();
+
   // Move allocator from big bucket to small bucket.
   void MaybeMoveAllocatorBigToSmall(GrpcMemoryAllocatorImpl* allocator);
   // Move allocator from small bucket to big bucket.
@@ -361,6 +378,12 @@ class BasicMemoryQuota final
   std::atomic<intptr_t> free_bytes_{kInitialSize};
   // The total number of bytes in this quota.
   std::atomic<size_t> quota_size_{kInitialSize};
+  // Free bytes cached per cpu. These still belong to the quota, but are not
+  // reflected in free_bytes_ until they are flushed: to bound the effect on
+  // pressure estimates the caches together hold at most 1/16th of the quota.
+  PerCpu<CpuCache> cpu_caches_{
+      PerCpuOptions().SetCpusPerShard(2).SetMaxShards(32)};
+  std::atomic<intptr_t> cpu_cache_limit_{kMaxCpuCacheBytes};
 
   // Reclaimer queues.
   ReclaimerQueue reclaimers_[kNumReclamationPasses];
@@ -105,7 +105,11 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
       channel_stack->call_stack_size;
 
-  RefCountedPtr<Arena> arena = channel->call_arena_allocator()->MakeArena();
+  RefCountedPtr<Arena> arena =
+      args->path.has_value()
+          ? channel->call_arena_allocator()->MakeArenaForMethod(
+                args->path->as_string_view())
+          : channel->call_arena_allocator()->MakeArena();
   arena->SetContext<grpc_event_engine::experimental::EventEngine>(
       args->channel->event_engine());
   call = new (arena->Alloc(call_alloc_size)) FilterStackCall(arena, *args);
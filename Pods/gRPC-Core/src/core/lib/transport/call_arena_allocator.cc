@@ -18,10 +18,31 @@
 
 #include <algorithm>
 
+#include "absl/hash/hash.h"
+
 namespace grpc_core {
 
+// Arenas made by MakeArenaForMethod carry the index of their method estimator
+// plus one as their factory tag, so that zero means "no method".
+RefCountedPtr<Arena> CallArenaAllocator::MakeArenaForMethod(
+    absl::string_view method) {
+  if (method.empty()) return MakeArena();
+  const size_t index =
+      absl::Hash<absl::string_view>()(method) % kMethodEstimators;
+  CallSizeEstimator& estimator = method_estimators_[index];
+  auto arena = Arena::Create(estimator.HasEstimate()
+                                 ? estimator.CallSizeEstimate()
+                                 : call_size_estimator_.CallSizeEstimate(),
+                             Ref());
+  arena->set_factory_tag(index + 1);
+  return arena;
+}
+
 void CallArenaAllocator::FinalizeArena(Arena* arena) {
-  call_size_estimator_.UpdateCallSizeEstimate(arena->TotalUsedBytes());
+  const size_t used = arena->TotalUsedBytes();
+  call_size_estimator_.UpdateCallSizeEstimate(used);
+  const uint32_t tag = arena->factory_tag();
+  if (tag != 0) method_estimators_[tag - 1].UpdateCallSizeEstimate(used);
 }
 
 }  // namespace grpc_core
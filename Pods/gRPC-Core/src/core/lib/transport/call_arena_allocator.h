@@ -21,6 +21,7 @@
 #include <atomic>
 #include <cstddef>
 
+#include "absl/strings/string_view.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/util/ref_counted.h"
@@ -29,9 +30,16 @@ namespace grpc_core {
 
 class CallSizeEstimator final {
  public:
+  // An estimator with no estimate yet; see HasEstimate().
+  CallSizeEstimator() : call_size_estimate_(0) {}
   explicit CallSizeEstimator(size_t initial_estimate)
       : call_size_estimate_(initial_estimate) {}
 
+  // Returns false until the first call size has been reported.
+  bool HasEstimate() const {
+    return call_size_estimate_.load(std::memory_order_relaxed) != 0;
+  }
+
   GPR_ATTRIBUTE_ALWAYS_INLINE_FUNCTION size_t CallSizeEstimate() {
     // We round up our current estimate to the NEXT value of kRoundUpSize.
     // This ensures:
@@ -70,6 +78,13 @@ class CallSizeEstimator final {
 
 class CallArenaAllocator final : public ArenaFactory {
  public:
+  // Calls to different methods on one channel can need arenas of very
+  // different sizes, so besides the channel wide estimate we keep a small
+  // direct-mapped table of per-method estimates. Methods that hash to the same
+  // slot share an estimate. Until a method has finished a call, its calls are
+  // sized from the channel wide estimate.
+  static constexpr size_t kMethodEstimators = 32;
+
   CallArenaAllocator(MemoryAllocator allocator, size_t initial_size)
       : ArenaFactory(std::move(allocator)),
         call_size_estimator_(initial_size) {}
@@ -78,12 +93,17 @@ class CallArenaAllocator final : public ArenaFactory {
     return Arena::Create(call_size_estimator_.CallSizeEstimate(), Ref());
   }
 
+  // Like MakeArena, but sizes the arena from the estimate for calls to
+  // `method` (a request path such as "/pkg.Service/Method").
+  RefCountedPtr<Arena> MakeArenaForMethod(absl::string_view method);
+
   void FinalizeArena(Arena* arena) override;
 
   size_t CallSizeEstimate() { return call_size_estimator_.CallSizeEstimate(); }
 
  private:
   CallSizeEstimator call_size_estimator_;
+  CallSizeEstimator method_estimators_[kMethodEstimators];
 };
 
 }  // namespace grpc_core
@@ -31,5 +31,13 @@ void DestroySliceValue(const Buffer& value) { CSliceUnref(value.slice); }
 
 void DestroyTrivialMemento(const Buffer&) {}
 
+void CopyTrivialMemento(const Buffer& value, Buffer* result) {
+  *result = value;
+}
+
+void CopySliceValue(const Buffer& value, Buffer* result) {
+  result->slice = CSliceRef(value.slice);
+}
+
 }  // namespace metadata_detail
 }  // namespace grpc_core
@@ -99,6 +99,12 @@ void DestroySliceValue(const Buffer& value);
 // Destroy a trivial memento (empty function).
 void DestroyTrivialMemento(const Buffer& value);
 
+// Copy a trivial memento (bitwise).
+void CopyTrivialMemento(const Buffer& value, Buffer* result);
+
+// Copy a grpc_slice part of a Buffer by taking a new ref to it.
+void CopySliceValue(const Buffer& value, Buffer* result);
+
 // Set a slice value in a container
 template <Slice (*MementoToValue)(Slice)>
 void SetSliceValue(Slice* set, const Buffer& value) {
@@ -202,6 +208,15 @@ class ParsedMetadata {
                             &result);
     return result;
   }
+  // Create a new parsed metadata with the same key and value. Slice values are
+  // shared rather than copied.
+  ParsedMetadata Copy() const {
+    ParsedMetadata result;
+    result.vtable_ = vtable_;
+    result.transport_size_ = transport_size_;
+    vtable_->copy(value_, &result.value_);
+    return result;
+  }
   std::string DebugString() const { return vtable_->debug_string(value_); }
   absl::string_view key() const {
     if (vtable_->key == nullptr) return vtable_->key_value;
@@ -220,6 +235,8 @@ class ParsedMetadata {
   struct VTable {
     const bool is_binary_header;
     void (*const destroy)(const Buffer& value);
+    // result is the Buffer of a new ParsedMetadata with the same vtable.
+    void (*const copy)(const Buffer& value, Buffer* result);
     void (*const set)(const Buffer& value, MetadataContainer* container);
     // result is a bitwise copy of the originating ParsedMetadata.
     void (*const with_new_value)(Slice* new_value,
@@ -274,6 +291,8 @@ ParsedMetadata<MetadataContainer>::EmptyVTable() {
       false,
       // destroy
       metadata_detail::DestroyTrivialMemento,
+      // copy
+      metadata_detail::CopyTrivialMemento,
       // set
       [](const Buffer&, MetadataContainer*) {},
       // with_new_value
@@ -295,6 +314,8 @@ ParsedMetadata<MetadataContainer>::TrivialTraitVTable() {
       absl::EndsWith(Which::key(), "-bin"),
       // destroy
       metadata_detail::DestroyTrivialMemento,
+      // copy
+      metadata_detail::CopyTrivialMemento,
       // set
       [](const Buffer& value, MetadataContainer* map) {
         map->Set(
@@ -329,6 +350,11 @@ ParsedMetadata<MetadataContainer>::NonTrivialTraitVTable() {
       [](const Buffer& value) {
         delete static_cast<typename Which::MementoType*>(value.pointer);
       },
+      // copy
+      [](const Buffer& value, Buffer* result) {
+        result->pointer = new typename Which::MementoType(
+            *static_cast<typename Which::MementoType*>(value.pointer));
+      },
       // set
       [](const Buffer& value, MetadataContainer* map) {
         auto* p = static_cast<typename Which::MementoType*>(value.pointer);
@@ -363,6 +389,8 @@ ParsedMetadata<MetadataContainer>::SliceTraitVTable() {
       absl::EndsWith(Which::key(), "-bin"),
       // destroy
       metadata_detail::DestroySliceValue,
+      // copy
+      metadata_detail::CopySliceValue,
       // set
       [](const Buffer& value, MetadataContainer* map) {
         metadata_detail::SetSliceValue<Which::MementoToValue>(
@@ -390,6 +418,10 @@ ParsedMetadata<MetadataContainer>::KeyValueVTable(absl::string_view key) {
   static const auto destroy = [](const Buffer& value) {
     delete static_cast<KV*>(value.pointer);
   };
+  static const auto copy = [](const Buffer& value, Buffer* result) {
+    auto* p = static_cast<KV*>(value.pointer);
+    result->pointer = new KV{p->first.Ref(), p->second.Ref()};
+  };
   static const auto set = [](const Buffer& value, MetadataContainer* map) {
     auto* p = static_cast<KV*>(value.pointer);
     map->unknown_.Append(p->first.as_string_view(), p->second.Ref());
@@ -418,8 +450,9 @@ ParsedMetadata<MetadataContainer>::KeyValueVTable(absl::string_view key) {
     return static_cast<KV*>(value.pointer)->first.as_string_view();
   };
   static const VTable vtable[2] = {
-      {false, destroy, set, with_new_value, debug_string, "", key_fn},
-      {true, destroy, set, with_new_value, binary_debug_string, "", key_fn},
+      {false, destroy, copy, set, with_new_value, debug_string, "", key_fn},
+      {true, destroy, copy, set, with_new_value, binary_debug_string, "",
+       key_fn},
   };
   return &vtable[absl::EndsWith(key, "-bin")];
 }
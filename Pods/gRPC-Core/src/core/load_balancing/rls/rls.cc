@@ -38,6 +38,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <map>
@@ -372,6 +373,12 @@ class RlsLb final : public LoadBalancingPolicy {
       return connectivity_state_;
     }
 
+    // Gets the current picker of the child policy.
+    RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker() const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      return picker_;
+    }
+
    private:
     // ChannelControlHelper object that allows the child policy to update state
     // with the wrapper.
@@ -414,23 +421,7 @@ class RlsLb final : public LoadBalancingPolicy {
         ABSL_GUARDED_BY(&RlsLb::mu_);
   };
 
-  // A picker that uses the cache and the request map in the LB policy
-  // (synchronized via a mutex) to determine how to route requests.
-  class Picker final : public LoadBalancingPolicy::SubchannelPicker {
-   public:
-    explicit Picker(RefCountedPtr<RlsLb> lb_policy);
-
-    PickResult Pick(PickArgs args) override;
-
-   private:
-    PickResult PickFromDefaultTargetOrFail(const char* reason, PickArgs args,
-                                           absl::Status status)
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
-
-    RefCountedPtr<RlsLb> lb_policy_;
-    RefCountedPtr<RlsLbConfig> config_;
-    RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
-  };
+  class Picker;
 
   // An LRU cache with adjustable size.
   class Cache final {
@@ -480,6 +471,15 @@ class RlsLb final : public LoadBalancingPolicy {
         return std::move(backoff_state_);
       }
 
+      const std::vector<RefCountedPtr<ChildPolicyWrapper>>&
+      child_policy_wrappers() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return child_policy_wrappers_;
+      }
+
+      // Whether the entry has been removed from the cache. May be called
+      // without holding the lock.
+      bool evicted() const { return evicted_.load(std::memory_order_acquire); }
+
       // Cache size of entry.
       size_t Size() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
@@ -509,6 +509,21 @@ class RlsLb final : public LoadBalancingPolicy {
       // Moves entry to the end of the LRU list.
       void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+      // Records a use by a pick that didn't take the lock. Instead of moving
+      // the entry in the LRU list, this sets a flag which gives the entry a
+      // second chance when it next reaches the front of the list.
+      void MarkUsedWithoutLock() {
+        if (!used_without_lock_.load(std::memory_order_relaxed)) {
+          used_without_lock_.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      // Returns whether MarkUsedWithoutLock() was called since the entry was
+      // last moved in the LRU list, and clears that state.
+      bool TakeUsedWithoutLock() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return used_without_lock_.exchange(false, std::memory_order_relaxed);
+      }
+
       // Takes entries from child_policy_wrappers_ and appends them to the end
       // of \a child_policy_wrappers.
       void TakeChildPolicyWrappers(
@@ -522,6 +537,9 @@ class RlsLb final : public LoadBalancingPolicy {
       }
 
      private:
+      // Takes refs to entries for the pick snapshot.
+      friend class RlsLb;
+
       class BackoffTimer final : public InternallyRefCounted<BackoffTimer> {
        public:
         BackoffTimer(RefCountedPtr<Entry> entry, Duration delay);
@@ -542,6 +560,9 @@ class RlsLb final : public LoadBalancingPolicy {
       RefCountedPtr<RlsLb> lb_policy_;
 
       bool is_shutdown_ ABSL_GUARDED_BY(&RlsLb::mu_) = false;
+      // Set along with is_shutdown_, for readers that don't hold the lock.
+      std::atomic<bool> evicted_{false};
+      std::atomic<bool> used_without_lock_{false};
 
       // Backoff states
       absl::Status status_ ABSL_GUARDED_BY(&RlsLb::mu_);
@@ -593,6 +614,14 @@ class RlsLb final : public LoadBalancingPolicy {
     // Resets backoff of all the cache entries.
     void ResetAllBackoff() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+    // Returns the entries whose data is neither stale nor expired at `now`
+    // and that have at least one target, so that picks for them can be
+    // served without an RLS request. Only the `max_entries` most recently
+    // used entries are considered.
+    std::vector<std::pair<const RequestKey*, Entry*>> FreshEntries(
+        Timestamp now, size_t max_entries)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
     // Shutdown the cache; clean-up and orphan all the stored cache entries.
     GRPC_MUST_USE_RESULT std::vector<RefCountedPtr<ChildPolicyWrapper>>
     Shutdown() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
@@ -627,6 +656,61 @@ class RlsLb final : public LoadBalancingPolicy {
     absl::optional<EventEngine::TaskHandle> cleanup_timer_handle_;
   };
 
+  // Cache entries that hold fresh data, copied out of the cache so that picks
+  // for them don't take the mutex. A snapshot is immutable once built, and is
+  // shared by every picker created until an RLS response or a child policy
+  // update changes what it would hold. Entries evicted in the meantime are
+  // detected via Cache::Entry::evicted(), and picks for them take the slow
+  // path.
+  class PickSnapshot final : public RefCounted<PickSnapshot> {
+   public:
+    // Bounds the work done under the mutex to build a snapshot: only this many
+    // of the most recently used cache entries are considered, and picks for
+    // the others take the mutex.
+    static constexpr size_t kMaxEntries = 1000;
+
+    struct Target {
+      // Weak, so that the snapshot doesn't keep the child policy alive.
+      WeakRefCountedPtr<ChildPolicyWrapper> child_policy_wrapper;
+      grpc_connectivity_state connectivity_state;
+      RefCountedPtr<SubchannelPicker> picker;
+    };
+
+    struct Entry {
+      RefCountedPtr<Cache::Entry> entry;
+      Timestamp stale_time;
+      Timestamp data_expiration_time;
+      grpc_event_engine::experimental::Slice header_data;
+      std::vector<Target> targets;
+    };
+
+    std::unordered_map<RequestKey, Entry, absl::Hash<RequestKey>> entries;
+  };
+
+  // A picker that uses the cache and the request map in the LB policy
+  // (synchronized via a mutex) to determine how to route requests. Picks for
+  // keys in the policy's PickSnapshot don't take the mutex.
+  class Picker final : public LoadBalancingPolicy::SubchannelPicker {
+   public:
+    explicit Picker(RefCountedPtr<RlsLb> lb_policy);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Same as Cache::Entry::Pick(), but using the snapshot of the entry.
+    PickResult PickFromSnapshot(const PickSnapshot::Entry& snapshot_entry,
+                                PickArgs args);
+
+    PickResult PickFromDefaultTargetOrFail(const char* reason, PickArgs args,
+                                           absl::Status status)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
+    RefCountedPtr<RlsLb> lb_policy_;
+    RefCountedPtr<RlsLbConfig> config_;
+    RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+    RefCountedPtr<PickSnapshot> snapshot_;
+  };
+
   // Channel for communicating with the RLS server.
   // Contains throttling logic for RLS requests.
   class RlsChannel final : public InternallyRefCounted<RlsChannel> {
@@ -776,6 +860,10 @@ class RlsLb final : public LoadBalancingPolicy {
   // Updates the picker in the work serializer.
   void UpdatePickerLocked() ABSL_LOCKS_EXCLUDED(&mu_);
 
+  // Returns the current pick snapshot, building it if it was invalidated.
+  RefCountedPtr<PickSnapshot> PickSnapshotLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&mu_);
+
   template <typename HandleType>
   void MaybeExportPickCount(HandleType handle, absl::string_view target,
                             const PickResult& pick_result);
@@ -785,8 +873,12 @@ class RlsLb final : public LoadBalancingPolicy {
   // Mutex to guard LB policy state that is accessed by the picker.
   Mutex mu_;
   bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // Set along with is_shutdown_, for picks that don't take the lock.
+  std::atomic<bool> is_shutdown_for_picks_{false};
   bool update_in_progress_ = false;
   Cache cache_ ABSL_GUARDED_BY(mu_);
+  // Shared by pickers until reset by a change to the data it holds.
+  RefCountedPtr<PickSnapshot> pick_snapshot_ ABSL_GUARDED_BY(mu_);
   // Maps an RLS request key to an RlsRequest object that represents a pending
   // RLS request.
   std::unordered_map<RequestKey, OrphanablePtr<RlsRequest>,
@@ -964,6 +1056,7 @@ void RlsLb::ChildPolicyWrapper::ChildPolicyHelper::UpdateState(
       // We want to unref the picker after we release the lock.
       wrapper_->picker_.swap(picker);
     }
+    wrapper_->lb_policy_->pick_snapshot_.reset();
   }
   wrapper_->lb_policy_->UpdatePickerLocked();
 }
@@ -1042,6 +1135,9 @@ RlsLb::Picker::Picker(RefCountedPtr<RlsLb> lb_policy)
     default_child_policy_ =
         lb_policy_->default_child_policy_->Ref(DEBUG_LOCATION, "Picker");
   }
+  MutexLock lock(&lb_policy_->mu_);
+  if (lb_policy_->is_shutdown_) return;
+  snapshot_ = lb_policy_->PickSnapshotLocked();
 }
 
 LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
@@ -1054,6 +1150,18 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
       << "[rlslb " << lb_policy_.get() << "] picker=" << this
       << ": request keys: " << key.ToString();
   Timestamp now = Timestamp::Now();
+  // If the snapshot has fresh data for the key, use it without taking the
+  // lock. Otherwise we may need to start an RLS request, which is done below.
+  if (snapshot_ != nullptr &&
+      !lb_policy_->is_shutdown_for_picks_.load(std::memory_order_acquire)) {
+    auto it = snapshot_->entries.find(key);
+    if (it != snapshot_->entries.end() && it->second.stale_time >= now &&
+        it->second.data_expiration_time >= now &&
+        !it->second.entry->evicted()) {
+      it->second.entry->MarkUsedWithoutLock();
+      return PickFromSnapshot(it->second, args);
+    }
+  }
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
@@ -1108,6 +1216,42 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   return PickResult::Queue();
 }
 
+LoadBalancingPolicy::PickResult RlsLb::Picker::PickFromSnapshot(
+    const PickSnapshot::Entry& snapshot_entry, PickArgs args) {
+  const auto& targets = snapshot_entry.targets;
+  size_t i = 0;
+  // Skip targets before the last one that are in state TRANSIENT_FAILURE.
+  for (; i < targets.size() - 1; ++i) {
+    if (targets[i].connectivity_state != GRPC_CHANNEL_TRANSIENT_FAILURE) break;
+    GRPC_TRACE_LOG(rls_lb, INFO)
+        << "[rlslb " << lb_policy_.get() << "] picker=" << this
+        << ": cache entry=" << snapshot_entry.entry.get() << ": target "
+        << targets[i].child_policy_wrapper->target() << " (" << i << " of "
+        << targets.size() << ") in state TRANSIENT_FAILURE; skipping";
+  }
+  const PickSnapshot::Target& target = targets[i];
+  GRPC_TRACE_LOG(rls_lb, INFO)
+      << "[rlslb " << lb_policy_.get() << "] picker=" << this
+      << ": cache entry=" << snapshot_entry.entry.get() << ": target "
+      << target.child_policy_wrapper->target() << " (" << i << " of "
+      << targets.size() << ") in state "
+      << ConnectivityStateName(target.connectivity_state) << "; delegating";
+  auto pick_result = target.picker->Pick(args);
+  lb_policy_->MaybeExportPickCount(kMetricTargetPicks,
+                                   target.child_policy_wrapper->target(),
+                                   pick_result);
+  // Add header data.
+  if (!snapshot_entry.header_data.empty()) {
+    auto* complete_pick =
+        absl::get_if<PickResult::Complete>(&pick_result.result);
+    if (complete_pick != nullptr) {
+      complete_pick->metadata_mutations.Set(kRlsHeaderKey,
+                                            snapshot_entry.header_data.Ref());
+    }
+  }
+  return pick_result;
+}
+
 LoadBalancingPolicy::PickResult RlsLb::Picker::PickFromDefaultTargetOrFail(
     const char* reason, PickArgs args, absl::Status status) {
   if (default_child_policy_ != nullptr) {
@@ -1212,6 +1356,7 @@ void RlsLb::Cache::Entry::Orphan() {
       << "[rlslb " << lb_policy_.get() << "] cache entry=" << this << " "
       << lru_iterator_->ToString() << ": cache entry evicted";
   is_shutdown_ = true;
+  evicted_.store(true, std::memory_order_release);
   lb_policy_->cache_.lru_list_.erase(lru_iterator_);
   lru_iterator_ = lb_policy_->cache_.lru_list_.end();  // Just in case.
   CHECK(child_policy_wrappers_.empty());
@@ -1291,6 +1436,7 @@ void RlsLb::Cache::Entry::MarkUsed() {
   auto new_it = lru_list.insert(lru_list.end(), *lru_iterator_);
   lru_list.erase(lru_iterator_);
   lru_iterator_ = new_it;
+  used_without_lock_.store(false, std::memory_order_relaxed);
 }
 
 std::vector<RlsLb::ChildPolicyWrapper*>
@@ -1318,6 +1464,7 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     return {};
   }
   // Request succeeded, so store the result.
+  lb_policy_->pick_snapshot_.reset();
   header_data_ = std::move(response.header_data);
   Timestamp now = Timestamp::Now();
   data_expiration_time_ = now + lb_policy_->config_->max_age();
@@ -1437,6 +1584,23 @@ void RlsLb::Cache::ResetAllBackoff() {
   lb_policy_->UpdatePickerAsync();
 }
 
+std::vector<std::pair<const RlsLb::RequestKey*, RlsLb::Cache::Entry*>>
+RlsLb::Cache::FreshEntries(Timestamp now, size_t max_entries) {
+  std::vector<std::pair<const RequestKey*, Entry*>> entries;
+  size_t scanned = 0;
+  for (auto lru_it = lru_list_.rbegin();
+       lru_it != lru_list_.rend() && scanned < max_entries;
+       ++lru_it, ++scanned) {
+    auto it = map_.find(*lru_it);
+    Entry* entry = it->second.get();
+    if (entry->stale_time() >= now && entry->data_expiration_time() >= now &&
+        !entry->child_policy_wrappers().empty()) {
+      entries.emplace_back(&it->first, entry);
+    }
+  }
+  return entries;
+}
+
 std::vector<RefCountedPtr<RlsLb::ChildPolicyWrapper>> RlsLb::Cache::Shutdown() {
   std::vector<RefCountedPtr<ChildPolicyWrapper>>
       child_policy_wrappers_to_delete;
@@ -1513,11 +1677,19 @@ size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
 void RlsLb::Cache::MaybeShrinkSize(
     size_t bytes, std::vector<RefCountedPtr<ChildPolicyWrapper>>*
                       child_policy_wrappers_to_delete) {
+  // Bounds the number of entries moved for having been used by lock-free
+  // picks, in case picks keep marking entries as used while we're looping.
+  size_t second_chances = lru_list_.size();
   while (size_ > bytes) {
     auto lru_it = lru_list_.begin();
     if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
     auto map_it = map_.find(*lru_it);
     CHECK(map_it != map_.end());
+    if (second_chances > 0 && map_it->second->TakeUsedWithoutLock()) {
+      --second_chances;
+      map_it->second->MarkUsed();
+      continue;
+    }
     if (!map_it->second->CanEvict()) break;
     GRPC_TRACE_LOG(rls_lb, INFO)
         << "[rlslb " << lb_policy_ << "] LRU eviction: removing entry "
@@ -2039,6 +2211,7 @@ absl::Status RlsLb::UpdateLocked(UpdateArgs args) {
   OrphanablePtr<ChildPolicyHandler> child_policy_to_delete;
   {
     MutexLock lock(&mu_);
+    pick_snapshot_.reset();
     // Swap out RLS channel if needed.
     if (old_config == nullptr ||
         config_->lookup_service() != old_config->lookup_service()) {
@@ -2143,6 +2316,8 @@ void RlsLb::ShutdownLocked() {
   {
     MutexLock lock(&mu_);
     is_shutdown_ = true;
+    is_shutdown_for_picks_.store(true, std::memory_order_release);
+    pick_snapshot_.reset();
     config_.reset(DEBUG_LOCATION, "ShutdownLocked");
     child_policy_wrappers_to_delete = cache_.Shutdown();
     request_map_.clear();
@@ -2225,6 +2400,30 @@ void RlsLb::UpdatePickerLocked() {
       MakeRefCounted<Picker>(RefAsSubclass<RlsLb>(DEBUG_LOCATION, "Picker")));
 }
 
+RefCountedPtr<RlsLb::PickSnapshot> RlsLb::PickSnapshotLocked() {
+  if (pick_snapshot_ != nullptr) return pick_snapshot_;
+  auto snapshot = MakeRefCounted<PickSnapshot>();
+  for (const auto& p :
+       cache_.FreshEntries(Timestamp::Now(), PickSnapshot::kMaxEntries)) {
+    Cache::Entry* entry = p.second;
+    PickSnapshot::Entry snapshot_entry;
+    snapshot_entry.entry = entry->Ref(DEBUG_LOCATION, "PickSnapshot");
+    snapshot_entry.stale_time = entry->stale_time();
+    snapshot_entry.data_expiration_time = entry->data_expiration_time();
+    snapshot_entry.header_data = entry->header_data().Ref();
+    snapshot_entry.targets.reserve(entry->child_policy_wrappers().size());
+    for (const auto& child_policy_wrapper : entry->child_policy_wrappers()) {
+      snapshot_entry.targets.push_back(
+          {child_policy_wrapper->WeakRef(DEBUG_LOCATION, "PickSnapshot"),
+           child_policy_wrapper->connectivity_state(),
+           child_policy_wrapper->picker()});
+    }
+    snapshot->entries.emplace(*p.first, std::move(snapshot_entry));
+  }
+  pick_snapshot_ = snapshot;
+  return snapshot;
+}
+
 template <typename HandleType>
 void RlsLb::MaybeExportPickCount(HandleType handle, absl::string_view target,
                                  const PickResult& pick_result) {
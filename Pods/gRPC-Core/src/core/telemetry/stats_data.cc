@@ -158,6 +158,8 @@ const absl::string_view
         "enobufs_count",
         "uncommon_io_error_count",
         "msg_errqueue_error_count",
+        "arena_zone_spills",
+        "arena_pool_reuses",
 };
 const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     Counter::COUNT)] = {
@@ -204,6 +206,10 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     "Number of ENOBUFS errors",
     "Number of uncommon io errors",
     "Number of uncommon errors returned by MSG_ERRQUEUE",
+    "Number of arena allocations that did not fit in the initial zone and "
+    "allocated a new zone",
+    "Number of arenas created from a recycled thread local block instead of a "
+    "fresh allocation",
 };
 const absl::string_view
     GlobalStats::histogram_name[static_cast<int>(Histogram::COUNT)] = {
@@ -246,6 +252,8 @@ const absl::string_view
         "chaotic_good_tcp_read_offer_control",
         "chaotic_good_tcp_write_size_data",
         "chaotic_good_tcp_write_size_control",
+        "poller_events_per_wakeup",
+        "poller_busy_poll_micros",
 };
 const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     Histogram::COUNT)] = {
@@ -290,6 +298,8 @@ const absl::string_view GlobalStats::histogram_doc[static_cast<int>(
     "Number of bytes offered to each syscall_read in the control channel",
     "Number of bytes offered to each syscall_write in the data channel",
     "Number of bytes offered to each syscall_write in the control channel",
+    "Number of fd events handled by the poller per wakeup",
+    "Time spent busy polling for events by the poller (in microseconds)",
 };
 namespace {
 const int kStatsTable0[21] = {0,    1,    2,    4,     8,     15,    27,
@@ -520,7 +530,9 @@ GlobalStats::GlobalStats()
       enotconn_count{0},
       enobufs_count{0},
       uncommon_io_error_count{0},
-      msg_errqueue_error_count{0} {}
+      msg_errqueue_error_count{0},
+      arena_zone_spills{0},
+      arena_pool_reuses{0} {}
 HistogramView GlobalStats::histogram(Histogram which) const {
   switch (which) {
     default:
@@ -644,6 +656,12 @@ HistogramView GlobalStats::histogram(Histogram which) const {
     case Histogram::kChaoticGoodTcpWriteSizeControl:
       return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable6, 20,
                            chaotic_good_tcp_write_size_control.buckets()};
+    case Histogram::kPollerEventsPerWakeup:
+      return HistogramView{&Histogram_100_20::BucketFor, kStatsTable4, 20,
+                           poller_events_per_wakeup.buckets()};
+    case Histogram::kPollerBusyPollMicros:
+      return HistogramView{&Histogram_100000_20::BucketFor, kStatsTable0, 20,
+                           poller_busy_poll_micros.buckets()};
   }
 }
 std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
@@ -717,6 +735,10 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.uncommon_io_error_count.load(std::memory_order_relaxed);
     result->msg_errqueue_error_count +=
         data.msg_errqueue_error_count.load(std::memory_order_relaxed);
+    result->arena_zone_spills +=
+        data.arena_zone_spills.load(std::memory_order_relaxed);
+    result->arena_pool_reuses +=
+        data.arena_pool_reuses.load(std::memory_order_relaxed);
     data.call_initial_size.Collect(&result->call_initial_size);
     data.tcp_write_size.Collect(&result->tcp_write_size);
     data.tcp_write_iov_size.Collect(&result->tcp_write_iov_size);
@@ -782,6 +804,8 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         &result->chaotic_good_tcp_write_size_data);
     data.chaotic_good_tcp_write_size_control.Collect(
         &result->chaotic_good_tcp_write_size_control);
+    data.poller_events_per_wakeup.Collect(&result->poller_events_per_wakeup);
+    data.poller_busy_poll_micros.Collect(&result->poller_busy_poll_micros);
   }
   return result;
 }
@@ -837,6 +861,8 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
       uncommon_io_error_count - other.uncommon_io_error_count;
   result->msg_errqueue_error_count =
       msg_errqueue_error_count - other.msg_errqueue_error_count;
+  result->arena_zone_spills = arena_zone_spills - other.arena_zone_spills;
+  result->arena_pool_reuses = arena_pool_reuses - other.arena_pool_reuses;
   result->call_initial_size = call_initial_size - other.call_initial_size;
   result->tcp_write_size = tcp_write_size - other.tcp_write_size;
   result->tcp_write_iov_size = tcp_write_iov_size - other.tcp_write_iov_size;
@@ -926,6 +952,10 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->chaotic_good_tcp_write_size_control =
       chaotic_good_tcp_write_size_control -
       other.chaotic_good_tcp_write_size_control;
+  result->poller_events_per_wakeup =
+      poller_events_per_wakeup - other.poller_events_per_wakeup;
+  result->poller_busy_poll_micros =
+      poller_busy_poll_micros - other.poller_busy_poll_micros;
   return result;
 }
 }  // namespace grpc_core
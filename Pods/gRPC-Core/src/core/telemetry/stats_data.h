@@ -235,6 +235,8 @@ struct GlobalStats {
     kEnobufsCount,
     kUncommonIoErrorCount,
     kMsgErrqueueErrorCount,
+    kArenaZoneSpills,
+    kArenaPoolReuses,
     COUNT
   };
   enum class Histogram {
@@ -277,6 +279,8 @@ struct GlobalStats {
     kChaoticGoodTcpReadOfferControl,
     kChaoticGoodTcpWriteSizeData,
     kChaoticGoodTcpWriteSizeControl,
+    kPollerEventsPerWakeup,
+    kPollerBusyPollMicros,
     COUNT
   };
   GlobalStats();
@@ -325,6 +329,8 @@ struct GlobalStats {
       uint64_t enobufs_count;
       uint64_t uncommon_io_error_count;
       uint64_t msg_errqueue_error_count;
+      uint64_t arena_zone_spills;
+      uint64_t arena_pool_reuses;
     };
     uint64_t counters[static_cast<int>(Counter::COUNT)];
   };
@@ -367,6 +373,8 @@ struct GlobalStats {
   Histogram_16777216_20 chaotic_good_tcp_read_offer_control;
   Histogram_16777216_20 chaotic_good_tcp_write_size_data;
   Histogram_16777216_20 chaotic_good_tcp_write_size_control;
+  Histogram_100_20 poller_events_per_wakeup;
+  Histogram_100000_20 poller_busy_poll_micros;
   HistogramView histogram(Histogram which) const;
   std::unique_ptr<GlobalStats> Diff(const GlobalStats& other) const;
 };
@@ -499,6 +507,12 @@ class GlobalStatsCollector {
     data_.this_cpu().msg_errqueue_error_count.fetch_add(
         1, std::memory_order_relaxed);
   }
+  void IncrementArenaZoneSpills() {
+    data_.this_cpu().arena_zone_spills.fetch_add(1, std::memory_order_relaxed);
+  }
+  void IncrementArenaPoolReuses() {
+    data_.this_cpu().arena_pool_reuses.fetch_add(1, std::memory_order_relaxed);
+  }
   void IncrementCallInitialSize(int value) {
     data_.this_cpu().call_initial_size.Increment(value);
   }
@@ -618,6 +632,12 @@ class GlobalStatsCollector {
   void IncrementChaoticGoodTcpWriteSizeControl(int value) {
     data_.this_cpu().chaotic_good_tcp_write_size_control.Increment(value);
   }
+  void IncrementPollerEventsPerWakeup(int value) {
+    data_.this_cpu().poller_events_per_wakeup.Increment(value);
+  }
+  void IncrementPollerBusyPollMicros(int value) {
+    data_.this_cpu().poller_busy_poll_micros.Increment(value);
+  }
 
  private:
   struct Data {
@@ -658,6 +678,8 @@ class GlobalStatsCollector {
     std::atomic<uint64_t> enobufs_count{0};
     std::atomic<uint64_t> uncommon_io_error_count{0};
     std::atomic<uint64_t> msg_errqueue_error_count{0};
+    std::atomic<uint64_t> arena_zone_spills{0};
+    std::atomic<uint64_t> arena_pool_reuses{0};
     HistogramCollector_65536_26 call_initial_size;
     HistogramCollector_16777216_20 tcp_write_size;
     HistogramCollector_80_10 tcp_write_iov_size;
@@ -697,6 +719,8 @@ class GlobalStatsCollector {
     HistogramCollector_16777216_20 chaotic_good_tcp_read_offer_control;
     HistogramCollector_16777216_20 chaotic_good_tcp_write_size_data;
     HistogramCollector_16777216_20 chaotic_good_tcp_write_size_control;
+    HistogramCollector_100_20 poller_events_per_wakeup;
+    HistogramCollector_100000_20 poller_busy_poll_micros;
   };
   PerCpu<Data> data_{PerCpuOptions().SetCpusPerShard(4).SetMaxShards(32)};
 };
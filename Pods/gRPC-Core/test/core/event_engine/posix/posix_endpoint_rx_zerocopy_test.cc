@@ -0,0 +1,329 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Reads from a loopback TCP connection through a PosixEndpoint with rx
+// zerocopy enabled, checking that received pages are mapped rather than
+// copied and that the bytes arrive intact and in order.
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/slice.h>
+#include <grpc/event_engine/slice_buffer.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
+#include "src/core/lib/event_engine/posix_engine/tcp_socket_utils.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+
+#ifdef GRPC_LINUX_ERRQUEUE
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace grpc_event_engine {
+namespace experimental {
+namespace {
+
+class FakePoller : public PosixEventPoller {
+ public:
+  EventHandle* CreateHandle(int, absl::string_view, bool) override {
+    return nullptr;
+  }
+  bool CanTrackErrors() const override { return false; }
+  std::string Name() override { return "fake"; }
+  void Shutdown() override {}
+  WorkResult Work(EventEngine::Duration, absl::FunctionRef<void()>) override {
+    return WorkResult::kDeadlineExceeded;
+  }
+  void Kick() override {}
+  void PrepareFork() override {}
+  void PostforkParent() override {}
+  void PostforkChild() override {}
+};
+
+// Holds on to the endpoint's read closure until the test finds the socket
+// readable and runs it.
+class FakeEventHandle : public EventHandle {
+ public:
+  FakeEventHandle(int fd, FakePoller* poller) : fd_(fd), poller_(poller) {}
+
+  int WrappedFd() override { return fd_; }
+  void OrphanHandle(PosixEngineClosure* on_done, int* release_fd,
+                    absl::string_view) override {
+    if (release_fd != nullptr) {
+      *release_fd = fd_;
+    } else {
+      close(fd_);
+    }
+    if (on_done != nullptr) on_done->Run();
+    delete this;
+  }
+  void ShutdownHandle(absl::Status why) override {
+    shutdown_ = true;
+    if (on_read_ != nullptr) {
+      PosixEngineClosure* on_read = std::exchange(on_read_, nullptr);
+      on_read->SetStatus(why);
+      on_read->Run();
+    }
+  }
+  void NotifyOnRead(PosixEngineClosure* on_read) override {
+    on_read_ = on_read;
+  }
+  void NotifyOnWrite(PosixEngineClosure*) override {}
+  void NotifyOnError(PosixEngineClosure*) override {}
+  void SetReadable() override {}
+  void SetWritable() override {}
+  void SetHasError() override {}
+  bool IsHandleShutdown() override { return shutdown_; }
+  PosixEventPoller* Poller() override { return poller_; }
+
+  // Waits for the socket to become readable and runs the pending read
+  // closure, if any.
+  void PollRead() {
+    if (on_read_ == nullptr) return;
+    struct pollfd pfd = {fd_, POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 10000), 1);
+    PosixEngineClosure* on_read = std::exchange(on_read_, nullptr);
+    on_read->SetStatus(absl::OkStatus());
+    on_read->Run();
+  }
+
+ private:
+  const int fd_;
+  FakePoller* const poller_;
+  PosixEngineClosure* on_read_ = nullptr;
+  bool shutdown_ = false;
+};
+
+// Runs everything inline, which is all the endpoint needs for reads.
+class InlineEventEngine : public EventEngine {
+ public:
+  absl::StatusOr<std::unique_ptr<Listener>> CreateListener(
+      Listener::AcceptCallback, absl::AnyInvocable<void(absl::Status)>,
+      const EndpointConfig&, std::unique_ptr<MemoryAllocatorFactory>) override {
+    return absl::UnimplementedError("");
+  }
+  ConnectionHandle Connect(OnConnectCallback, const ResolvedAddress&,
+                           const EndpointConfig&, MemoryAllocator,
+                           Duration) override {
+    return ConnectionHandle::kInvalid;
+  }
+  bool CancelConnect(ConnectionHandle) override { return false; }
+  bool IsWorkerThread() override { return false; }
+  absl::StatusOr<std::unique_ptr<DNSResolver>> GetDNSResolver(
+      const DNSResolver::ResolverOptions&) override {
+    return absl::UnimplementedError("");
+  }
+  void Run(Closure* closure) override { closure->Run(); }
+  void Run(absl::AnyInvocable<void()> closure) override { closure(); }
+  TaskHandle RunAfter(Duration, Closure*) override {
+    return TaskHandle::kInvalid;
+  }
+  TaskHandle RunAfter(Duration, absl::AnyInvocable<void()>) override {
+    return TaskHandle::kInvalid;
+  }
+  bool Cancel(TaskHandle) override { return false; }
+};
+
+const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+class PosixEndpointRxZerocopyTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(listener, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    // Large enough buffers for the whole payload to be queued at once. The
+    // accepted socket inherits the listener's.
+    int buffer_size = 4 * 1024 * 1024;
+    setsockopt(listener, SOL_SOCKET, SO_RCVBUF, &buffer_size,
+               sizeof(buffer_size));
+    ASSERT_EQ(bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len), 0);
+    ASSERT_EQ(listen(listener, 1), 0);
+    ASSERT_EQ(
+        getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len),
+        0);
+    sender_ = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(sender_, SOL_SOCKET, SO_SNDBUF, &buffer_size,
+               sizeof(buffer_size));
+    ASSERT_EQ(connect(sender_, reinterpret_cast<sockaddr*>(&addr), addr_len),
+              0);
+    receiver_ = accept(listener, nullptr, nullptr);
+    ASSERT_GE(receiver_, 0);
+    close(listener);
+    fcntl(receiver_, F_SETFL, fcntl(receiver_, F_GETFL) | O_NONBLOCK);
+  }
+
+  void TearDown() override {
+    endpoint_.reset();
+    if (sender_ >= 0) close(sender_);
+  }
+
+  void CreateEndpoint() {
+    PosixTcpOptions options;
+    options.resource_quota = grpc_core::ResourceQuota::Default();
+    options.tcp_rx_zero_copy_enabled = true;
+    options.tcp_rx_zerocopy_receive_bytes_threshold = kPageSize;
+    options.tcp_read_chunk_size = kReadChunkSize;
+    options.tcp_min_read_chunk_size = kReadChunkSize;
+    options.tcp_max_read_chunk_size = kReadChunkSize;
+    handle_ = new FakeEventHandle(receiver_, &poller_);
+    endpoint_ = CreatePosixEndpoint(
+        handle_, nullptr, std::make_shared<InlineEventEngine>(),
+        options.resource_quota->memory_quota()->CreateMemoryAllocator("test"),
+        options);
+  }
+
+  // Sends payload, with everything after the first unaligned_prefix bytes
+  // sent with MSG_ZEROCOPY so that it reaches the receiver as whole pages.
+  void Send(const std::string& payload, size_t unaligned_prefix) {
+    int one = 1;
+    ASSERT_EQ(setsockopt(sender_, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)),
+              0);
+    ASSERT_EQ(send(sender_, payload.data(), unaligned_prefix, 0),
+              static_cast<ssize_t>(unaligned_prefix));
+    size_t rest = payload.size() - unaligned_prefix;
+    void* pages = mmap(nullptr, rest, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(pages, MAP_FAILED);
+    memcpy(pages, payload.data() + unaligned_prefix, rest);
+    size_t sent = 0;
+    while (sent < rest) {
+      ssize_t n = send(sender_, static_cast<char*>(pages) + sent, rest - sent,
+                       MSG_ZEROCOPY);
+      ASSERT_GT(n, 0);
+      sent += n;
+    }
+    // Wait for everything to be queued on the receiving side, so each read
+    // sees the whole remaining payload. The pages can't be unmapped before
+    // the kernel is done with them.
+    int queued = 0;
+    for (int i = 0; i < 1000 && queued < static_cast<int>(payload.size());
+         ++i) {
+      ASSERT_EQ(ioctl(receiver_, FIONREAD, &queued), 0);
+      if (queued < static_cast<int>(payload.size())) usleep(1000);
+    }
+    ASSERT_EQ(queued, static_cast<int>(payload.size()));
+    munmap(pages, rest);
+  }
+
+  // Reads length bytes from the endpoint, counting how many of them were
+  // mapped.
+  std::string Receive(size_t length) {
+    std::string received;
+    while (received.size() < length) {
+      SliceBuffer buffer;
+      EventEngine::Endpoint::ReadArgs args{
+          static_cast<int64_t>(length - received.size())};
+      bool done = false;
+      absl::Status status;
+      if (endpoint_->Read(
+              [&](absl::Status s) {
+                status = s;
+                done = true;
+              },
+              &buffer, &args)) {
+        done = true;
+      }
+      while (!done) handle_->PollRead();
+      EXPECT_TRUE(status.ok()) << status;
+      if (!status.ok()) break;
+      for (size_t i = 0; i < buffer.Count(); ++i) {
+        const Slice& slice = buffer[i];
+        if (IsMapped(slice)) mapped_bytes_ += slice.length();
+        received.append(slice.as_string_view());
+      }
+    }
+    return received;
+  }
+
+  // Mapped slices are whole pages at page aligned addresses, which the
+  // buffers reads are copied into are not.
+  bool IsMapped(const Slice& slice) {
+    auto address = reinterpret_cast<uintptr_t>(slice.begin());
+    return slice.length() > 0 && address % kPageSize == 0 &&
+           slice.length() % kPageSize == 0;
+  }
+
+  static constexpr int kReadChunkSize = 2 * 1024 * 1024;
+
+  int sender_ = -1;
+  int receiver_ = -1;
+  FakePoller poller_;
+  FakeEventHandle* handle_ = nullptr;
+  std::unique_ptr<PosixEndpoint> endpoint_;
+  size_t mapped_bytes_ = 0;
+};
+
+std::string Payload(size_t length) {
+  std::string payload(length, '\0');
+  for (size_t i = 0; i < length; ++i) {
+    payload[i] = static_cast<char>(i * 7 + i / 4096);
+  }
+  return payload;
+}
+
+TEST_F(PosixEndpointRxZerocopyTest, MapsPagesBehindUnalignedBytes) {
+  CreateEndpoint();
+  // The unaligned prefix comes back as a skip hint ahead of the pages, which
+  // used to end the zero-copy read before anything was mapped.
+  std::string payload = Payload(1024 * 1024 + 100);
+  Send(payload, 100);
+  EXPECT_EQ(Receive(payload.size()), payload);
+  // Loopback packets carry a little under 64KiB each, and the partial page at
+  // the end of each has to be copied.
+  EXPECT_GE(mapped_bytes_, payload.size() * 3 / 4);
+}
+
+TEST_F(PosixEndpointRxZerocopyTest, CopiesWhatCantBeMapped) {
+  CreateEndpoint();
+  // Without MSG_ZEROCOPY the loopback data isn't page aligned, so everything
+  // is read through the skip hints.
+  std::string payload = Payload(300 * 1000);
+  ASSERT_EQ(send(sender_, payload.data(), payload.size(), 0),
+            static_cast<ssize_t>(payload.size()));
+  EXPECT_EQ(Receive(payload.size()), payload);
+}
+
+}  // namespace
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_ERRQUEUE
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/grpc.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/log/log_sink.h"
+#include "absl/log/log_sink_registry.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+#include "src/core/util/sync.h"
+#include "test/core/load_balancing/rls_test_lib.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Collects the rls_lb trace logged while it is alive.
+class RlsTraceSink final : public absl::LogSink {
+ public:
+  RlsTraceSink() {
+    grpc_tracer_set_enabled("rls_lb", 1);
+    absl::AddLogSink(this);
+  }
+
+  ~RlsTraceSink() override {
+    absl::RemoveLogSink(this);
+    grpc_tracer_set_enabled("rls_lb", 0);
+  }
+
+  void Send(const absl::LogEntry& entry) override {
+    MutexLock lock(&mu_);
+    messages_.emplace_back(entry.text_message());
+  }
+
+  std::vector<std::string> messages() {
+    MutexLock lock(&mu_);
+    return messages_;
+  }
+
+ private:
+  Mutex mu_;
+  std::vector<std::string> messages_ ABSL_GUARDED_BY(mu_);
+};
+
+// Whether a pick with the key is served from the picker's snapshot, i.e.
+// delegated to a child without the policy's lock. Picks that take the lock
+// log "using cache entry", and the cache entry logs the delegation.
+bool PickedWithoutLock(LoadBalancingPolicy::SubchannelPicker* picker,
+                       absl::string_view key) {
+  RlsTraceSink sink;
+  RlsLbHarness::Pick(picker, key);
+  const std::string prefix = absl::StrFormat("picker=%p: cache entry=", picker);
+  for (const std::string& message : sink.messages()) {
+    if (absl::StrContains(message, prefix) &&
+        absl::StrContains(message, "delegating")) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Waits for the policy to report a picker that serves the key without the
+// lock.
+bool WaitForPickWithoutLock(RlsLbHarness* harness, absl::string_view key) {
+  const absl::Time deadline = absl::Now() + absl::Seconds(10);
+  while (absl::Now() < deadline) {
+    if (PickedWithoutLock(harness->picker().get(), key)) return true;
+    absl::SleepFor(absl::Milliseconds(10));
+  }
+  return false;
+}
+
+// Picks with the key from the latest picker until the result is the expected
+// one, and returns the last result.
+std::string WaitForPick(RlsLbHarness* harness, absl::string_view key,
+                        absl::string_view expected) {
+  const absl::Time deadline = absl::Now() + absl::Seconds(10);
+  std::string result;
+  do {
+    result = RlsLbHarness::Pick(harness->picker().get(), key);
+    if (result == expected) break;
+    absl::SleepFor(absl::Milliseconds(10));
+  } while (absl::Now() < deadline);
+  return result;
+}
+
+TEST(RlsTest, ResolvedKeysArePickedWithoutLock) {
+  RlsLbHarness harness;
+  EXPECT_EQ(harness.WaitForTarget("a"), "target-a");
+  EXPECT_TRUE(WaitForPickWithoutLock(&harness, "a"));
+  // A key the snapshot doesn't hold falls back to the cache under the lock.
+  EXPECT_FALSE(PickedWithoutLock(harness.picker().get(), "b"));
+}
+
+TEST(RlsTest, RlsResponseInvalidatesSnapshot) {
+  RlsLbHarness harness;
+  EXPECT_EQ(harness.WaitForTarget("a"), "target-a");
+  // The response for b names a child that already exists, so no child
+  // reports a new state. Only the response itself can get b into the
+  // snapshot.
+  harness.server().SetTargets("b", {"target-a"});
+  EXPECT_EQ(harness.WaitForTarget("b"), "target-a");
+  EXPECT_TRUE(WaitForPickWithoutLock(&harness, "b"));
+}
+
+TEST(RlsTest, ChildStateUpdateInvalidatesSnapshot) {
+  RlsLbHarness harness;
+  EXPECT_EQ(harness.WaitForTarget("a"), "target-a");
+  ASSERT_TRUE(WaitForPickWithoutLock(&harness, "a"));
+  harness.SetChildState("target-a", GRPC_CHANNEL_TRANSIENT_FAILURE,
+                        absl::UnavailableError("child down"));
+  // The child's new picker must replace the one in the snapshot.
+  EXPECT_EQ(WaitForPick(&harness, "a", "fail: child down"), "fail: child down");
+}
+
+TEST(RlsTest, ShutdownInvalidatesSnapshot) {
+  RlsLbHarness harness;
+  EXPECT_EQ(harness.WaitForTarget("a"), "target-a");
+  ASSERT_TRUE(WaitForPickWithoutLock(&harness, "a"));
+  auto picker = harness.picker();
+  harness.Shutdown();
+  // The channel may still hold the picker after the policy shuts down, but
+  // it must not keep delegating to the children.
+  EXPECT_EQ(RlsLbHarness::Pick(picker.get(), "a"),
+            "fail: LB policy already shut down");
+}
+
+TEST(RlsTest, CacheGivesRecentlyPickedEntriesSecondChance) {
+  // Room for two entries of 100KB keys.
+  const std::string key_suffix(100 * 1024, 'x');
+  const std::string a = "a" + key_suffix;
+  const std::string b = "b" + key_suffix;
+  const std::string c = "c" + key_suffix;
+  RlsLbHarness harness(500 * 1024);
+  // Keep the targets short, so that the trace of each pick isn't truncated.
+  harness.server().SetTargets(a, {"target-a"});
+  harness.server().SetTargets(b, {"target-b"});
+  harness.server().SetTargets(c, {"target-c"});
+  // The first picker's snapshot is empty, so it always picks under the lock,
+  // which clears an entry's used bit and moves it to the back of the LRU
+  // list.
+  auto locked_picker = harness.picker();
+  EXPECT_EQ(harness.WaitForTarget(a), "target-a");
+  EXPECT_EQ(harness.WaitForTarget(b), "target-b");
+  EXPECT_EQ(RlsLbHarness::Pick(locked_picker.get(), a), "target-a");
+  EXPECT_EQ(RlsLbHarness::Pick(locked_picker.get(), b), "target-b");
+  // Entries can't be evicted before their minimum expiration time.
+  absl::SleepFor(absl::Milliseconds(5500));
+  // Picking a from the snapshot only marks it as used. Without a second
+  // chance, a is the least recently used entry and c's response evicts it.
+  ASSERT_TRUE(WaitForPickWithoutLock(&harness, a));
+  EXPECT_EQ(harness.WaitForTarget(c), "target-c");
+  EXPECT_EQ(RlsLbHarness::Pick(locked_picker.get(), a), "target-a");
+  EXPECT_EQ(harness.server().RequestCount(a), 1);
+  EXPECT_EQ(RlsLbHarness::Pick(locked_picker.get(), b), "queue");
+  EXPECT_EQ(harness.WaitForTarget(b), "target-b");
+  EXPECT_EQ(harness.server().RequestCount(b), 2);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::testing::RegisterTestChildPolicy();
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -0,0 +1,582 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_TEST_CORE_LOAD_BALANCING_RLS_TEST_LIB_H
+#define GRPC_TEST_CORE_LOAD_BALANCING_RLS_TEST_LIB_H
+
+#include <grpc/byte_buffer.h>
+#include <grpc/byte_buffer_reader.h>
+#include <grpc/credentials.h>
+#include <grpc/grpc.h>
+#include <grpc/slice.h>
+#include <grpc/support/json.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "src/core/config/core_configuration.h"
+#include "src/core/ext/upb-gen/src/proto/grpc/lookup/v1/rls.upb.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/security/credentials/credentials.h"
+#include "src/core/load_balancing/lb_policy.h"
+#include "src/core/load_balancing/lb_policy_factory.h"
+#include "src/core/load_balancing/lb_policy_registry.h"
+#include "src/core/load_balancing/subchannel_interface.h"
+#include "src/core/resolver/endpoint_addresses.h"
+#include "src/core/telemetry/metrics.h"
+#include "src/core/util/json/json.h"
+#include "src/core/util/json/json_reader.h"
+#include "src/core/util/match.h"
+#include "src/core/util/notification.h"
+#include "src/core/util/orphanable.h"
+#include "src/core/util/ref_counted_ptr.h"
+#include "src/core/util/sync.h"
+#include "src/core/util/work_serializer.h"
+#include "upb/mem/arena.hpp"
+
+namespace grpc_core {
+namespace testing {
+
+// An RLS server on a local port. It answers each lookup for key "k" with
+// the targets set for its value, or with "target-<value>" by default, and
+// counts the lookups made for each value.
+class FakeRlsServer {
+ public:
+  FakeRlsServer() {
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_credentials* creds = grpc_insecure_server_credentials_create();
+    port_ = grpc_server_add_http2_port(server_, "127.0.0.1:0", creds);
+    grpc_server_credentials_release(creds);
+    CHECK_GT(port_, 0);
+    grpc_server_start(server_);
+    thread_ = std::thread([this] { Serve(); });
+  }
+
+  ~FakeRlsServer() {
+    grpc_server_shutdown_and_notify(server_, cq_, Tag(kShutdown));
+    grpc_server_cancel_all_calls(server_);
+    thread_.join();
+    grpc_server_destroy(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  // The target for the RLS policy's lookupService.
+  std::string target() const { return absl::StrCat("ipv4:127.0.0.1:", port_); }
+
+  void SetTargets(absl::string_view key, std::vector<std::string> targets) {
+    MutexLock lock(&mu_);
+    targets_[std::string(key)] = std::move(targets);
+  }
+
+  int RequestCount(absl::string_view key) {
+    MutexLock lock(&mu_);
+    auto it = request_counts_.find(std::string(key));
+    return it == request_counts_.end() ? 0 : it->second;
+  }
+
+ private:
+  enum Event { kRequestCall, kBatch, kShutdown };
+
+  static void* Tag(Event event) {
+    return reinterpret_cast<void*>(static_cast<intptr_t>(event) + 1);
+  }
+
+  // Waits for the given event, noting the server's shutdown if it comes
+  // first. Returns whether the event succeeded.
+  bool Await(Event event) {
+    while (true) {
+      grpc_event ev = grpc_completion_queue_next(
+          cq_, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      CHECK_EQ(ev.type, GRPC_OP_COMPLETE);
+      if (ev.tag == Tag(event)) return ev.success != 0;
+      CHECK_EQ(ev.tag, Tag(kShutdown));
+      shutdown_seen_ = true;
+    }
+  }
+
+  void Serve() {
+    while (true) {
+      grpc_call* call = nullptr;
+      grpc_call_details details;
+      grpc_metadata_array request_metadata;
+      grpc_call_details_init(&details);
+      grpc_metadata_array_init(&request_metadata);
+      CHECK_EQ(grpc_server_request_call(server_, &call, &details,
+                                        &request_metadata, cq_, cq_,
+                                        Tag(kRequestCall)),
+               GRPC_CALL_OK);
+      const bool ok = Await(kRequestCall);
+      if (ok) HandleCall(call);
+      grpc_call_details_destroy(&details);
+      grpc_metadata_array_destroy(&request_metadata);
+      if (!ok) break;
+    }
+    if (!shutdown_seen_) Await(kShutdown);
+  }
+
+  void HandleCall(grpc_call* call) {
+    grpc_byte_buffer* request = nullptr;
+    grpc_op ops[2] = {};
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_MESSAGE;
+    ops[1].data.recv_message.recv_message = &request;
+    CHECK_EQ(grpc_call_start_batch(call, ops, 2, Tag(kBatch), nullptr),
+             GRPC_CALL_OK);
+    Await(kBatch);
+    grpc_byte_buffer* response = nullptr;
+    if (request != nullptr) {
+      response = Respond(request);
+      grpc_byte_buffer_destroy(request);
+    }
+    int cancelled;
+    grpc_slice details = grpc_slice_from_static_string("");
+    grpc_op reply_ops[3] = {};
+    size_t num_ops = 0;
+    if (response != nullptr) {
+      reply_ops[num_ops].op = GRPC_OP_SEND_MESSAGE;
+      reply_ops[num_ops++].data.send_message.send_message = response;
+    }
+    reply_ops[num_ops].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    reply_ops[num_ops].data.send_status_from_server.status =
+        response != nullptr ? GRPC_STATUS_OK : GRPC_STATUS_INVALID_ARGUMENT;
+    reply_ops[num_ops++].data.send_status_from_server.status_details =
+        &details;
+    reply_ops[num_ops].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    reply_ops[num_ops++].data.recv_close_on_server.cancelled = &cancelled;
+    CHECK_EQ(grpc_call_start_batch(call, reply_ops, num_ops, Tag(kBatch),
+                                   nullptr),
+             GRPC_CALL_OK);
+    Await(kBatch);
+    if (response != nullptr) grpc_byte_buffer_destroy(response);
+    grpc_call_unref(call);
+  }
+
+  grpc_byte_buffer* Respond(grpc_byte_buffer* request) {
+    grpc_byte_buffer_reader reader;
+    CHECK(grpc_byte_buffer_reader_init(&reader, request));
+    grpc_slice request_slice = grpc_byte_buffer_reader_readall(&reader);
+    grpc_byte_buffer_reader_destroy(&reader);
+    upb::Arena arena;
+    auto* lookup_request = grpc_lookup_v1_RouteLookupRequest_parse(
+        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(request_slice)),
+        GRPC_SLICE_LENGTH(request_slice), arena.ptr());
+    grpc_slice_unref(request_slice);
+    upb_StringView value;
+    if (lookup_request == nullptr ||
+        !grpc_lookup_v1_RouteLookupRequest_key_map_get(
+            lookup_request, upb_StringView_FromString("k"), &value)) {
+      return nullptr;
+    }
+    std::string key(value.data, value.size);
+    std::vector<std::string> targets = {absl::StrCat("target-", key)};
+    {
+      MutexLock lock(&mu_);
+      ++request_counts_[key];
+      auto it = targets_.find(key);
+      if (it != targets_.end()) targets = it->second;
+    }
+    auto* lookup_response = grpc_lookup_v1_RouteLookupResponse_new(arena.ptr());
+    for (const std::string& target : targets) {
+      grpc_lookup_v1_RouteLookupResponse_add_targets(
+          lookup_response,
+          upb_StringView_FromDataAndSize(target.data(), target.size()),
+          arena.ptr());
+    }
+    size_t length;
+    char* serialized = grpc_lookup_v1_RouteLookupResponse_serialize(
+        lookup_response, arena.ptr(), &length);
+    grpc_slice response_slice =
+        grpc_slice_from_copied_buffer(serialized, length);
+    grpc_byte_buffer* response = grpc_raw_byte_buffer_create(&response_slice, 1);
+    grpc_slice_unref(response_slice);
+    return response;
+  }
+
+  grpc_completion_queue* cq_;
+  grpc_server* server_;
+  int port_;
+  std::thread thread_;
+  bool shutdown_seen_ = false;
+  Mutex mu_;
+  std::map<std::string, std::vector<std::string>> targets_
+      ABSL_GUARDED_BY(mu_);
+  std::map<std::string, int> request_counts_ ABSL_GUARDED_BY(mu_);
+};
+
+constexpr absl::string_view kTestChildPolicyName = "rls_test_child";
+
+// Stands in for a connected subchannel. Its address is the RLS target that
+// picked it.
+class FakeSubchannel final : public SubchannelInterface {
+ public:
+  explicit FakeSubchannel(std::string target) : target_(std::move(target)) {}
+
+  void WatchConnectivityState(
+      std::unique_ptr<ConnectivityStateWatcherInterface>) override {}
+  void CancelConnectivityStateWatch(
+      ConnectivityStateWatcherInterface*) override {}
+  void RequestConnection() override {}
+  void ResetBackoff() override {}
+  void AddDataWatcher(std::unique_ptr<DataWatcherInterface>) override {}
+  void CancelDataWatcher(DataWatcherInterface*) override {}
+  std::string address() const override { return target_; }
+
+ private:
+  const std::string target_;
+};
+
+// The child policy for each RLS target. It reports READY as soon as it
+// learns its target, with a picker that completes every pick on a
+// FakeSubchannel for the target. Tests may report other states through
+// SetState().
+class TestChildPolicy final : public LoadBalancingPolicy {
+ public:
+  class Config final : public LoadBalancingPolicy::Config {
+   public:
+    explicit Config(std::string target) : target_(std::move(target)) {}
+    absl::string_view name() const override { return kTestChildPolicyName; }
+    const std::string& target() const { return target_; }
+
+   private:
+    std::string target_;
+  };
+
+  explicit TestChildPolicy(Args args) : LoadBalancingPolicy(std::move(args)) {}
+
+  // Returns the child for the target, or null. Must be called in the work
+  // serializer.
+  static TestChildPolicy* Find(const std::string& target) {
+    auto it = children().find(target);
+    return it == children().end() ? nullptr : it->second;
+  }
+
+  absl::string_view name() const override { return kTestChildPolicyName; }
+
+  absl::Status UpdateLocked(UpdateArgs args) override {
+    if (target_.empty()) {
+      target_ = args.config.TakeAsSubclass<Config>()->target();
+      children()[target_] = this;
+      SetState(GRPC_CHANNEL_READY, absl::OkStatus());
+    }
+    return absl::OkStatus();
+  }
+
+  void ResetBackoffLocked() override {}
+
+  void SetState(grpc_connectivity_state state, const absl::Status& status) {
+    RefCountedPtr<SubchannelPicker> picker;
+    if (state == GRPC_CHANNEL_READY) {
+      picker =
+          MakeRefCounted<Picker>(MakeRefCounted<FakeSubchannel>(target_));
+    } else {
+      picker = MakeRefCounted<TransientFailurePicker>(status);
+    }
+    channel_control_helper()->UpdateState(state, status, std::move(picker));
+  }
+
+ private:
+  class Picker final : public SubchannelPicker {
+   public:
+    explicit Picker(RefCountedPtr<SubchannelInterface> subchannel)
+        : subchannel_(std::move(subchannel)) {}
+    PickResult Pick(PickArgs /*args*/) override {
+      return PickResult::Complete(subchannel_);
+    }
+
+   private:
+    RefCountedPtr<SubchannelInterface> subchannel_;
+  };
+
+  // Only touched in the work serializer.
+  static std::map<std::string, TestChildPolicy*>& children() {
+    static auto* children = new std::map<std::string, TestChildPolicy*>();
+    return *children;
+  }
+
+  void ShutdownLocked() override {
+    auto it = children().find(target_);
+    if (it != children().end() && it->second == this) children().erase(it);
+  }
+
+  std::string target_;
+};
+
+class TestChildPolicyFactory final : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<TestChildPolicy>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kTestChildPolicyName; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    auto it = json.object().find("target");
+    if (it == json.object().end() ||
+        it->second.type() != Json::Type::kString) {
+      return absl::InvalidArgumentError("field:target error:must be a string");
+    }
+    return MakeRefCounted<TestChildPolicy::Config>(it->second.string());
+  }
+};
+
+// Registers the child policy. Must run before the core configuration is
+// built, i.e. before grpc_init().
+inline void RegisterTestChildPolicy() {
+  CoreConfiguration::RegisterBuilder([](CoreConfiguration::Builder* builder) {
+    builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+        std::make_unique<TestChildPolicyFactory>());
+  });
+}
+
+// Runs an RLS policy against a FakeRlsServer, standing in for the channel.
+// Picks carry their RLS key in the "key" header.
+class RlsLbHarness {
+ public:
+  static constexpr absl::string_view kPath = "/test.Service/Method";
+
+  explicit RlsLbHarness(int64_t cache_size_bytes = 1024 * 1024)
+      : event_engine_(grpc_event_engine::experimental::GetDefaultEventEngine()),
+        work_serializer_(std::make_shared<WorkSerializer>(event_engine_)) {
+    auto config = CoreConfiguration::Get()
+                      .lb_policy_registry()
+                      .ParseLoadBalancingConfig(
+                          JsonParse(ConfigJson(cache_size_bytes)).value());
+    CHECK_OK(config);
+    RunInWorkSerializer([&] {
+      LoadBalancingPolicy::Args args;
+      args.work_serializer = work_serializer_;
+      args.channel_control_helper = std::make_unique<Helper>(this);
+      policy_ = CoreConfiguration::Get()
+                    .lb_policy_registry()
+                    .CreateLoadBalancingPolicy("rls_experimental",
+                                               std::move(args));
+      CHECK(policy_ != nullptr);
+      LoadBalancingPolicy::UpdateArgs update_args;
+      update_args.addresses = std::make_shared<EndpointAddressesListIterator>(
+          EndpointAddressesList());
+      update_args.config = *config;
+      CHECK_OK(policy_->UpdateLocked(std::move(update_args)));
+    });
+    CHECK(picker() != nullptr);
+  }
+
+  ~RlsLbHarness() {
+    Shutdown();
+    ExecCtx exec_ctx;
+    MutexLock lock(&mu_);
+    picker_.reset();
+  }
+
+  FakeRlsServer& server() { return server_; }
+
+  // The picker the policy reported last.
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker() {
+    MutexLock lock(&mu_);
+    return picker_;
+  }
+
+  // Picks with the given key. Returns the target picked, "queue", or the
+  // failure.
+  static std::string Pick(LoadBalancingPolicy::SubchannelPicker* picker,
+                          absl::string_view key) {
+    ExecCtx exec_ctx;
+    KeyMetadata metadata(key);
+    FakeCallState call_state;
+    auto result = picker->Pick({kPath, &metadata, &call_state});
+    return Match(
+        result.result,
+        [](const LoadBalancingPolicy::PickResult::Complete& complete) {
+          return complete.subchannel->address();
+        },
+        [](const LoadBalancingPolicy::PickResult::Queue&) {
+          return std::string("queue");
+        },
+        [](const LoadBalancingPolicy::PickResult::Fail& fail) {
+          return absl::StrCat("fail: ", fail.status.message());
+        },
+        [](const LoadBalancingPolicy::PickResult::Drop& drop) {
+          return absl::StrCat("drop: ", drop.status.message());
+        });
+  }
+
+  // Picks with the given key from the latest picker until the pick stops
+  // queuing, and returns its result.
+  std::string WaitForTarget(absl::string_view key) {
+    const absl::Time deadline = absl::Now() + absl::Seconds(10);
+    std::string result;
+    do {
+      result = Pick(picker().get(), key);
+      if (result != "queue") break;
+      absl::SleepFor(absl::Milliseconds(1));
+    } while (absl::Now() < deadline);
+    return result;
+  }
+
+  // Reports a new state from the child policy for the target.
+  void SetChildState(const std::string& target, grpc_connectivity_state state,
+                     const absl::Status& status) {
+    RunInWorkSerializer([&] {
+      TestChildPolicy* child = TestChildPolicy::Find(target);
+      CHECK_NE(child, nullptr);
+      child->SetState(state, status);
+    });
+  }
+
+  // Shuts the policy down, as the channel would when it goes away.
+  void Shutdown() {
+    RunInWorkSerializer([&] { policy_.reset(); });
+  }
+
+ private:
+  class Helper final : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(RlsLbHarness* harness) : harness_(harness) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        const grpc_resolved_address& /*address*/,
+        const ChannelArgs& /*per_address_args*/,
+        const ChannelArgs& /*args*/) override {
+      return nullptr;
+    }
+
+    void UpdateState(
+        grpc_connectivity_state /*state*/, const absl::Status& /*status*/,
+        RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker) override {
+      MutexLock lock(&harness_->mu_);
+      harness_->picker_.swap(picker);
+    }
+
+    void RequestReresolution() override {}
+    absl::string_view GetTarget() override { return "test-target"; }
+    absl::string_view GetAuthority() override { return "test-authority"; }
+
+    RefCountedPtr<grpc_channel_credentials> GetChannelCredentials() override {
+      return RefCountedPtr<grpc_channel_credentials>(
+          grpc_insecure_credentials_create());
+    }
+
+    RefCountedPtr<grpc_channel_credentials> GetUnsafeChannelCredentials()
+        override {
+      return GetChannelCredentials();
+    }
+
+    grpc_event_engine::experimental::EventEngine* GetEventEngine() override {
+      return harness_->event_engine_.get();
+    }
+
+    GlobalStatsPluginRegistry::StatsPluginGroup& GetStatsPluginGroup()
+        override {
+      return stats_plugin_group_;
+    }
+
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    RlsLbHarness* harness_;
+    GlobalStatsPluginRegistry::StatsPluginGroup stats_plugin_group_;
+  };
+
+  class KeyMetadata final : public LoadBalancingPolicy::MetadataInterface {
+   public:
+    explicit KeyMetadata(absl::string_view key) : key_(key) {}
+
+    absl::optional<absl::string_view> Lookup(
+        absl::string_view key, std::string* /*buffer*/) const override {
+      if (key != "key") return absl::nullopt;
+      return key_;
+    }
+
+   private:
+    absl::string_view key_;
+  };
+
+  class FakeCallState final : public LoadBalancingPolicy::CallState {
+   public:
+    void* Alloc(size_t size) override {
+      allocations_.push_back(std::make_unique<char[]>(size));
+      return allocations_.back().get();
+    }
+
+   private:
+    std::vector<std::unique_ptr<char[]>> allocations_;
+  };
+
+  std::string ConfigJson(int64_t cache_size_bytes) {
+    return absl::StrFormat(
+        R"json([{"rls_experimental": {
+          "routeLookupConfig": {
+            "grpcKeybuilders": [{
+              "names": [{"service": "test.Service", "method": "Method"}],
+              "headers": [{"key": "k", "names": ["key"]}]
+            }],
+            "lookupService": "%s",
+            "cacheSizeBytes": %d
+          },
+          "childPolicy": [{"%s": {}}],
+          "childPolicyConfigTargetFieldName": "target"
+        }}])json",
+        server_.target(), cache_size_bytes, kTestChildPolicyName);
+  }
+
+  void RunInWorkSerializer(absl::AnyInvocable<void()> fn) {
+    Notification done;
+    {
+      ExecCtx exec_ctx;
+      work_serializer_->Run(
+          [&] {
+            fn();
+            done.Notify();
+          },
+          DEBUG_LOCATION);
+    }
+    done.WaitForNotification();
+  }
+
+  FakeRlsServer server_;
+  std::shared_ptr<grpc_event_engine::experimental::EventEngine> event_engine_;
+  std::shared_ptr<WorkSerializer> work_serializer_;
+  OrphanablePtr<LoadBalancingPolicy> policy_;
+  Mutex mu_;
+  RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace testing
+}  // namespace grpc_core
+
+#endif  // GRPC_TEST_CORE_LOAD_BALANCING_RLS_TEST_LIB_H
@@ -0,0 +1,99 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/resource_quota/memory_quota.h"
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+namespace {
+
+// Large enough that each cpu cache holds its maximum of 64KB, however many
+// shards the caches have.
+constexpr size_t kQuotaSize = 64 * 1024 * 1024;
+constexpr size_t kCpuCacheLimit = 64 * 1024;
+
+// The bytes free in the quota, excluding those still parked in cpu caches.
+size_t FreeBytes(BasicMemoryQuota* quota) {
+  return std::llround(
+      kQuotaSize * (1 - quota->GetPressureInfo().instantaneous_pressure));
+}
+
+TEST(MemoryQuotaTest, ReturnedBytesAreCachedPerCpu) {
+  ExecCtx exec_ctx;
+  auto quota = std::make_shared<BasicMemoryQuota>("test");
+  quota->SetSize(kQuotaSize);
+  EXPECT_EQ(FreeBytes(quota.get()), kQuotaSize);
+  quota->Take(nullptr, kQuotaSize);
+  EXPECT_EQ(FreeBytes(quota.get()), 0u);
+
+  // Small returns stay in this cpu's cache, and takes are served from it.
+  quota->Return(1000);
+  EXPECT_EQ(FreeBytes(quota.get()), 0u);
+  quota->Take(nullptr, 1000);
+  quota->Return(2000);
+  EXPECT_EQ(FreeBytes(quota.get()), 0u);
+
+  // Filling the cache doesn't flush it, but overflowing it flushes all of it
+  // to the quota.
+  quota->Return(kCpuCacheLimit - 2000);
+  EXPECT_EQ(FreeBytes(quota.get()), 0u);
+  quota->Return(1000);
+  EXPECT_EQ(FreeBytes(quota.get()), kCpuCacheLimit + 1000);
+
+  // Returns that the cache can't hold go straight to the quota.
+  quota->Return(kCpuCacheLimit + 1);
+  EXPECT_EQ(FreeBytes(quota.get()), 2 * kCpuCacheLimit + 1001);
+}
+
+TEST(MemoryQuotaTest, TakingPastFreeBytesDrainsCpuCaches) {
+  ExecCtx exec_ctx;
+  auto quota = std::make_shared<BasicMemoryQuota>("test");
+  quota->SetSize(kQuotaSize);
+  quota->Take(nullptr, kQuotaSize - 1000);
+  quota->Return(500);
+  EXPECT_EQ(FreeBytes(quota.get()), 1000u);
+
+  // The take can't be served from the cache, and the quota alone can't cover
+  // it, so the cached bytes are drained into the quota to make up the
+  // difference rather than entering overcommit.
+  quota->Take(nullptr, 1200);
+  EXPECT_EQ(FreeBytes(quota.get()), 300u);
+  quota->Return(kCpuCacheLimit + 1);
+  EXPECT_EQ(FreeBytes(quota.get()), kCpuCacheLimit + 301);
+}
+
+TEST(MemoryQuotaTest, ResizingFlushesCpuCaches) {
+  ExecCtx exec_ctx;
+  auto quota = std::make_shared<BasicMemoryQuota>("test");
+  quota->SetSize(kQuotaSize);
+  quota->Take(nullptr, kQuotaSize);
+  quota->Return(1000);
+  EXPECT_EQ(FreeBytes(quota.get()), 0u);
+  quota->SetSize(kQuotaSize);
+  EXPECT_EQ(FreeBytes(quota.get()), 1000u);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
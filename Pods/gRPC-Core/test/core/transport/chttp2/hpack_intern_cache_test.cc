@@ -0,0 +1,181 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/chttp2/transport/hpack_intern_cache.h"
+
+#include <grpc/slice.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+namespace {
+
+// A stand-in for a read buffer, which records when its memory is released.
+struct ReadBuffer {
+  std::string contents;
+  bool* destroyed;
+};
+
+Slice MakeReadBuffer(std::string contents, bool* destroyed) {
+  auto* buffer = new ReadBuffer{std::move(contents), destroyed};
+  return Slice(grpc_slice_new_with_user_data(
+      &buffer->contents[0], buffer->contents.size(),
+      [](void* p) {
+        auto* buffer = static_cast<ReadBuffer*>(p);
+        *buffer->destroyed = true;
+        delete buffer;
+      },
+      buffer));
+}
+
+ParsedMetadata<grpc_metadata_batch> ParseMetadata(absl::string_view key,
+                                                  absl::string_view value) {
+  return grpc_metadata_batch::Parse(
+      key, Slice::FromCopiedString(value), true,
+      key.size() + value.size() + 32,
+      [](absl::string_view, const Slice&) { FAIL(); });
+}
+
+// Parses header blocks as a server connection's parser would.
+class Connection {
+ public:
+  explicit Connection(HPackInternCache* cache) {
+    parser_.SetInternCache(cache);
+  }
+
+  absl::Status Parse(const Slice& block, grpc_metadata_batch* batch) {
+    parser_.BeginFrame(batch, 1024, 1024, HPackParser::Boundary::EndOfHeaders,
+                       HPackParser::Priority::None,
+                       HPackParser::LogInfo{1, HPackParser::LogInfo::kHeaders,
+                                            false});
+    absl::BitGen bitgen;
+    absl::Status status =
+        parser_.Parse(block.c_slice(), true, bitgen, nullptr);
+    parser_.FinishFrame();
+    return status;
+  }
+
+ private:
+  HPackParser parser_;
+};
+
+// Long enough that slices refer to it rather than holding it inline.
+const char kTokenValue[] = "0123456789abcdef0123456789abcdef";
+
+// A literal header with incremental indexing and a new name, whose value is
+// kTokenValue.
+const char kTokenBlock[] =
+    "\x40\x07x-token\x20"
+    "0123456789abcdef0123456789abcdef";
+const size_t kTokenBlockLength = sizeof(kTokenBlock) - 1;
+
+TEST(HPackInternCacheTest, LookupReturnsInsertedMetadata) {
+  auto cache = std::make_unique<HPackInternCache>();
+  cache->Insert("user-agent", "wire", false,
+                ParseMetadata("user-agent", "value"));
+  auto md = cache->Lookup("user-agent", "wire", false);
+  ASSERT_TRUE(md.has_value());
+  EXPECT_EQ(md->DebugString(), "user-agent: value");
+  EXPECT_EQ(md->transport_size(), 47u);
+  EXPECT_FALSE(cache->Lookup("user-agent", "wire", true).has_value());
+  EXPECT_FALSE(cache->Lookup("authority", "wire", false).has_value());
+}
+
+TEST(HPackInternCacheTest, LookupsShareValue) {
+  auto cache = std::make_unique<HPackInternCache>();
+  cache->Insert("x-token", "wire", false,
+                ParseMetadata("x-token", kTokenValue));
+  grpc_metadata_batch first;
+  grpc_metadata_batch second;
+  cache->Lookup("x-token", "wire", false)->SetOnContainer(&first);
+  cache->Lookup("x-token", "wire", false)->SetOnContainer(&second);
+  std::string buffer;
+  auto first_value = first.GetStringValue("x-token", &buffer);
+  auto second_value = second.GetStringValue("x-token", &buffer);
+  ASSERT_TRUE(first_value.has_value());
+  ASSERT_TRUE(second_value.has_value());
+  EXPECT_EQ(*first_value, kTokenValue);
+  EXPECT_EQ(first_value->data(), second_value->data());
+}
+
+TEST(HPackInternCacheTest, ConnectionsShareParsedHeaders) {
+  auto cache = std::make_unique<HPackInternCache>();
+  Connection first(cache.get());
+  Connection second(cache.get());
+  grpc_metadata_batch first_batch;
+  grpc_metadata_batch second_batch;
+  ASSERT_TRUE(
+      first
+          .Parse(Slice::FromCopiedBuffer(kTokenBlock, kTokenBlockLength),
+                 &first_batch)
+          .ok());
+  ASSERT_TRUE(cache->Lookup("x-token", kTokenValue, false).has_value());
+  ASSERT_TRUE(
+      second
+          .Parse(Slice::FromCopiedBuffer(kTokenBlock, kTokenBlockLength),
+                 &second_batch)
+          .ok());
+  std::string buffer;
+  auto first_value = first_batch.GetStringValue("x-token", &buffer);
+  auto second_value = second_batch.GetStringValue("x-token", &buffer);
+  ASSERT_TRUE(first_value.has_value());
+  ASSERT_TRUE(second_value.has_value());
+  EXPECT_EQ(*second_value, kTokenValue);
+  EXPECT_EQ(first_value->data(), second_value->data());
+}
+
+TEST(HPackInternCacheTest, EntriesDoNotKeepInputAlive) {
+  auto cache = std::make_unique<HPackInternCache>();
+  Connection connection(cache.get());
+  grpc_metadata_batch batch;
+  bool destroyed = false;
+  ASSERT_TRUE(connection
+                  .Parse(MakeReadBuffer(
+                             std::string(kTokenBlock, kTokenBlockLength),
+                             &destroyed),
+                         &batch)
+                  .ok());
+  EXPECT_TRUE(destroyed);
+  EXPECT_TRUE(cache->Lookup("x-token", kTokenValue, false).has_value());
+}
+
+TEST(HPackInternCacheTest, HeadersThatFailToParseAreNotShared) {
+  auto cache = std::make_unique<HPackInternCache>();
+  Connection connection(cache.get());
+  grpc_metadata_batch batch;
+  EXPECT_FALSE(
+      connection
+          .Parse(Slice::FromStaticString("\x40\x0cgrpc-timeout\x05value"),
+                 &batch)
+          .ok());
+  EXPECT_FALSE(cache->Lookup("grpc-timeout", "value", false).has_value());
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+// Copyright 2026 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the HPACK huffman coders: the encoder for plain header values,
+// the combined base64 and huffman encoder for -bin values, and the decoder the
+// HPACK parser uses for both.
+
+#include <benchmark/benchmark.h>
+#include <grpc/slice.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
+#include "src/core/ext/transport/chttp2/transport/decode_huff.h"
+
+namespace grpc_core {
+namespace {
+
+// Printable ASCII, the alphabet of most non-binary header values.
+std::string RandomText(size_t length) {
+  std::mt19937 rng(length);
+  std::uniform_int_distribution<int> dist(0x20, 0x7e);
+  std::string text(length, ' ');
+  for (char& c : text) c = static_cast<char>(dist(rng));
+  return text;
+}
+
+std::string RandomBinary(size_t length) {
+  std::mt19937 rng(length);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::string binary(length, '\0');
+  for (char& c : binary) c = static_cast<char>(dist(rng));
+  return binary;
+}
+
+void BM_HuffmanCompress(benchmark::State& state) {
+  std::string text = RandomText(state.range(0));
+  grpc_slice input = grpc_slice_from_copied_buffer(text.data(), text.size());
+  for (auto _ : state) {
+    grpc_slice output = grpc_chttp2_huffman_compress(input);
+    benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(output));
+    grpc_slice_unref(output);
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HuffmanCompress)->Arg(16)->Arg(256)->Arg(4096);
+
+void BM_Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  std::string binary = RandomBinary(state.range(0));
+  grpc_slice input =
+      grpc_slice_from_copied_buffer(binary.data(), binary.size());
+  for (auto _ : state) {
+    uint32_t wire_size;
+    grpc_slice output =
+        grpc_chttp2_base64_encode_and_huffman_compress(input, &wire_size);
+    benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(output));
+    grpc_slice_unref(output);
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Base64EncodeAndHuffmanCompress)->Arg(16)->Arg(256)->Arg(4096);
+
+// Decodes into a vector reserved the way the HPACK parser reserves it.
+void BM_HuffmanDecode(benchmark::State& state) {
+  std::string text = RandomText(state.range(0));
+  grpc_slice input = grpc_slice_from_copied_buffer(text.data(), text.size());
+  grpc_slice encoded = grpc_chttp2_huffman_compress(input);
+  const uint8_t* begin = GRPC_SLICE_START_PTR(encoded);
+  const uint8_t* end = GRPC_SLICE_END_PTR(encoded);
+  for (auto _ : state) {
+    std::vector<uint8_t> output;
+    output.reserve(GRPC_SLICE_LENGTH(encoded) * 8 / 5);
+    auto sink = [&output](uint8_t c) { output.push_back(c); };
+    CHECK(HuffDecoder<decltype(sink)>(sink, begin, end).Run());
+    benchmark::DoNotOptimize(output.data());
+  }
+  grpc_slice_unref(encoded);
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HuffmanDecode)->Arg(16)->Arg(256)->Arg(4096);
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
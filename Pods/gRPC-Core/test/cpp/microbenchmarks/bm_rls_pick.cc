@@ -0,0 +1,87 @@
+// Copyright 2026 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks RLS picks from several threads at once, over keys that are all
+// resolved. Up to the snapshot's limit of 1000 entries, picks are served
+// from the picker's snapshot without the policy's lock. Past it, picks for
+// the keys left out of the snapshot contend on the lock.
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "test/core/load_balancing/rls_test_lib.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Shared by the benchmark's threads, and set up once per run before they
+// start.
+std::unique_ptr<RlsLbHarness> g_harness;
+std::vector<std::string> g_keys;
+
+void SetUpHarness(const benchmark::State& state) {
+  g_harness = std::make_unique<RlsLbHarness>(5 * 1024 * 1024);
+  g_keys.clear();
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    g_keys.push_back(absl::StrCat("key-", i));
+    CHECK_EQ(g_harness->WaitForTarget(g_keys.back()),
+             absl::StrCat("target-", g_keys.back()));
+  }
+}
+
+void TearDownHarness(const benchmark::State& /*state*/) {
+  g_harness.reset();
+  g_keys.clear();
+}
+
+void BM_RlsPick(benchmark::State& state) {
+  // Each key's child reports READY as it's resolved, so the latest picker
+  // was built after every key was resolved.
+  auto picker = g_harness->picker();
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        RlsLbHarness::Pick(picker.get(), g_keys[i++ % g_keys.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RlsPick)
+    ->Setup(SetUpHarness)
+    ->Teardown(TearDownHarness)
+    ->Arg(100)
+    ->Arg(2000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  grpc_core::testing::RegisterTestChildPolicy();
+  grpc_init();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the thread pool work queues, BasicWorkQueue against
+// ChaseLevWorkQueue, for the owner working alone, with a thief stealing
+// concurrently, and with enough closures to spill out of the ring buffer.
+
+#include <benchmark/benchmark.h>
+#include <grpc/event_engine/event_engine.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <thread>
+
+#include "absl/log/check.h"
+#include "src/core/lib/event_engine/work_queue/basic_work_queue.h"
+#include "src/core/lib/event_engine/work_queue/chase_lev_work_queue.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+namespace {
+
+class IndexedClosure : public EventEngine::Closure {
+ public:
+  explicit IndexedClosure(int64_t index) : index_(index) {}
+  void Run() override {}
+  int64_t index() const { return index_; }
+
+ private:
+  int64_t index_;
+};
+
+// Closures can't be moved, so keep them in a deque.
+std::deque<IndexedClosure> MakeClosures(int64_t count) {
+  std::deque<IndexedClosure> closures;
+  for (int64_t i = 0; i < count; ++i) closures.emplace_back(i);
+  return closures;
+}
+
+// The owner adds a batch of closures and takes them back, newest first, the
+// way a thread pool worker drains its own queue.
+template <typename Queue>
+void BM_AddPopMostRecent(benchmark::State& state) {
+  Queue queue;
+  std::deque<IndexedClosure> closures = MakeClosures(state.range(0));
+  for (auto _ : state) {
+    for (IndexedClosure& closure : closures) queue.Add(&closure);
+    while (queue.PopMostRecent() != nullptr) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_AddPopMostRecent, BasicWorkQueue)
+    ->Arg(1)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_TEMPLATE(BM_AddPopMostRecent, ChaseLevWorkQueue)
+    ->Arg(1)
+    ->Arg(64)
+    ->Arg(1024);
+
+// As above, while another thread keeps stealing the oldest closures.
+template <typename Queue>
+void BM_AddPopMostRecentWithThief(benchmark::State& state) {
+  Queue queue;
+  std::deque<IndexedClosure> closures = MakeClosures(state.range(0));
+  std::atomic<bool> done{false};
+  std::atomic<int64_t> stolen{0};
+  std::thread thief([&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      if (queue.PopOldest() != nullptr) {
+        stolen.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+  for (auto _ : state) {
+    for (IndexedClosure& closure : closures) queue.Add(&closure);
+    while (!queue.Empty()) queue.PopMostRecent();
+  }
+  done.store(true, std::memory_order_relaxed);
+  thief.join();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["stolen"] = benchmark::Counter(
+      static_cast<double>(stolen.load()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_AddPopMostRecentWithThief, BasicWorkQueue)
+    ->Arg(64)
+    ->Arg(1024)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AddPopMostRecentWithThief, ChaseLevWorkQueue)
+    ->Arg(64)
+    ->Arg(1024)
+    ->UseRealTime();
+
+// Fills the queue past the ring buffer's capacity, steals some closures to
+// free up room in it, adds more and drains newest first. Closures must come
+// back in exactly the reverse order they were added.
+template <typename Queue>
+void BM_Overflow(benchmark::State& state) {
+  Queue queue;
+  const int64_t first_batch = 2 * ChaseLevWorkQueue::kCapacity;
+  const int64_t stolen = ChaseLevWorkQueue::kCapacity / 2;
+  const int64_t second_batch = ChaseLevWorkQueue::kCapacity / 4;
+  std::deque<IndexedClosure> closures =
+      MakeClosures(first_batch + second_batch);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < first_batch; ++i) queue.Add(&closures[i]);
+    for (int64_t i = 0; i < stolen; ++i) {
+      auto* closure = static_cast<IndexedClosure*>(queue.PopOldest());
+      CHECK_NE(closure, nullptr);
+      CHECK_EQ(closure->index(), i);
+    }
+    for (int64_t i = first_batch; i < first_batch + second_batch; ++i) {
+      queue.Add(&closures[i]);
+    }
+    int64_t expected = first_batch + second_batch;
+    while (auto* closure =
+               static_cast<IndexedClosure*>(queue.PopMostRecent())) {
+      CHECK_EQ(closure->index(), --expected);
+    }
+    CHECK_EQ(expected, stolen);
+  }
+  state.SetItemsProcessed(state.iterations() * (first_batch + second_batch));
+}
+BENCHMARK_TEMPLATE(BM_Overflow, BasicWorkQueue);
+BENCHMARK_TEMPLATE(BM_Overflow, ChaseLevWorkQueue);
+
+}  // namespace
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}